@@ -601,6 +601,25 @@ public:
 /// A convenience typedef for a shared pointer to @ref corpus_diff.
 typedef shared_ptr<corpus_diff> corpus_diff_sptr;
 
+/// A convenience typedef for a vector of @ref corpus_diff_sptr.
+typedef vector<corpus_diff_sptr> corpus_diff_sptrs_type;
+
+/// The kinds of engines that can be used to match the functions,
+/// variables and ELF symbols of two corpora, when computing a @ref
+/// corpus_diff.
+enum corpus_matching_engine_kind
+{
+  /// Match the functions, variables and ELF symbols of two corpora
+  /// by their IDs, using hash tables.  Only the artifacts that have
+  /// the same ID are compared.  This is the default.
+  HASH_JOIN_MATCHING_ENGINE,
+
+  /// Match the functions, variables and ELF symbols of two corpora by
+  /// computing the edit script between their sorted sequences, using
+  /// the Myers algorithm.
+  EDIT_SCRIPT_MATCHING_ENGINE
+}; // end enum corpus_matching_engine_kind
+
 /// The context of the diff.  This type holds various bits of
 /// information that is going to be used throughout the diffing of two
 /// entities and the reporting that follows.
@@ -886,6 +905,12 @@ public:
   void
   do_dump_diff_tree(const corpus_diff_sptr) const;
 
+  corpus_matching_engine_kind
+  corpus_matching_engine() const;
+
+  void
+  corpus_matching_engine(corpus_matching_engine_kind k);
+
   friend class_diff_sptr
   compute_diff(const class_decl_sptr	first,
 	       const class_decl_sptr	second,
@@ -2474,6 +2499,12 @@ compute_diff(const corpus_group_sptr&,
 	     const corpus_group_sptr&,
 	     diff_context_sptr	ctxt);
 
+void
+compute_diffs(const vector<corpus_sptr>&	baselines,
+	      const corpus_sptr&		c,
+	      const vector<diff_context_sptr>&	ctxts,
+	      corpus_diff_sptrs_type&		diffs);
+
 /// This is a document class that aims to capture statistics about the
 /// changes carried by a @ref corpus_diff type.
 ///
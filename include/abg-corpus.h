@@ -428,6 +428,9 @@ public:
   operator==(const corpus_group&) const;
 }; // end class corpus_group
 
+void
+get_memory_stats(const corpus& c, memory_stats_type& stats);
+
 }// end namespace ir
 }//end namespace abigail
 #endif //__ABG_CORPUS_H__
@@ -118,13 +118,38 @@ reset_read_context(read_context_sptr &ctxt,
 		   bool		read_all_types = false,
 		   bool		linux_kernel_mode = false);
 
+void
+set_read_context_options_from(read_context& ctxt, const read_context& other);
+
 void
 add_read_context_suppressions(read_context& ctxt,
 			      const suppr::suppressions_type& supprs);
 
+/// Convenience typedef for a set of names of ELF symbols.
+typedef unordered_set<string> symbol_names_set_type;
+
+/// Convenience typedef for a shared pointer to @ref
+/// symbol_names_set_type.
+typedef shared_ptr<symbol_names_set_type> symbol_names_set_sptr;
+
+void
+set_kernel_abi_whitelist(read_context& ctxt,
+			 const symbol_names_set_sptr& whitelisted_names);
+
+void
+set_function_symbols_of_interest(read_context& ctxt,
+				 const symbol_names_set_sptr& names);
+
+void
+set_variable_symbols_of_interest(read_context& ctxt,
+				 const symbol_names_set_sptr& names);
+
 void
 set_read_context_corpus_group(read_context& ctxt, corpus_group_sptr& group);
 
+bool
+preload_debug_info(read_context& ctxt);
+
 corpus_sptr
 read_corpus_from_elf(read_context& ctxt, status& stat);
 
@@ -145,6 +170,13 @@ lookup_symbol_from_elf(const environment*		env,
 		       bool				demangle,
 		       vector<elf_symbol_sptr>&	symbols);
 
+size_t
+lookup_symbols_from_elf(const environment*		env,
+			const string&			elf_path,
+			const vector<string>&		symbol_names,
+			bool				demangle,
+			string_elf_symbols_map_type&	symbols);
+
 bool
 lookup_public_function_symbol_from_elf(const environment*		env,
 				       const string&			path,
@@ -166,6 +198,11 @@ has_alt_debug_info(const string&	elf_path,
 		   bool&		has_alt_di,
 		   string&		alt_debug_info_path);
 
+status
+get_debug_info_size(const string&	elf_path,
+		    char**		debug_info_root_path,
+		    uint64_t&		size);
+
 bool
 get_soname_of_elf_file(const string& path, string& soname);
 
@@ -195,6 +232,44 @@ set_drop_undefined_syms(read_context& ctxt,
 void
 set_do_log(read_context& ctxt, bool f);
 
+void
+set_num_threads(read_context& ctxt, size_t n);
+
+size_t
+get_num_threads(const read_context& ctxt);
+
+void
+set_corpus_cache_dir(read_context& ctxt, const string& dir);
+
+const string&
+get_corpus_cache_dir(const read_context& ctxt);
+
+void
+set_compute_translation_unit_hashes(read_context& ctxt, bool f);
+
+void
+set_baseline_translation_unit_hashes
+(read_context& ctxt, const translation_unit_hashes_type& hashes);
+
+const translation_unit_paths_type&
+get_skipped_translation_units(const read_context& ctxt);
+
+void
+get_corpus_cache_stats(const read_context& ctxt,
+		       size_t& hits,
+		       size_t& misses);
+
+/// The times spent in the phases of the construction of corpora.
+/// Each element is the name of a phase, along with the number of
+/// milliseconds spent in it.
+typedef vector<std::pair<string, size_t> > phase_timings_type;
+
+const phase_timings_type&
+get_phase_timings(const read_context& ctxt);
+
+void
+get_memory_stats(const read_context& ctxt, memory_stats_type& stats);
+
 void
 set_ignore_symbol_table(read_context &ctxt, bool f);
 
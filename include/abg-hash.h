@@ -39,6 +39,31 @@ namespace hashing
 
   uint32_t
   fnv_hash(const std::string& str);
+
+  /// A stable 64-bit hash of a sequence of bytes that is fed
+  /// piecewise.  This is the 64-bit FNV-1a algorithm.
+  class fnv_hasher64
+  {
+    uint64_t hash_;
+
+  public:
+    fnv_hasher64();
+
+    void
+    update(const void* data, std::size_t size);
+
+    void
+    update(const std::string& str);
+
+    void
+    update(uint64_t value);
+
+    uint64_t
+    value() const;
+
+    std::string
+    value_as_string() const;
+  }; // end class fnv_hasher64
 }//end namespace hashing
 }//end namespace abigail
 
@@ -237,6 +237,8 @@ struct hash_interned_string
 /// This is where all the distinct strings represented by the interned
 /// strings leave.  The pool is the actor responsible for creating
 /// interned strings.
+///
+/// Interned strings can be created concurrently by several threads.
 class interned_string_pool
 {
   struct priv;
@@ -257,6 +259,9 @@ public:
   const char*
   get_string(const char* s) const;
 
+  void
+  get_stats(size_t& num_strings, size_t& num_bytes) const;
+
   ~interned_string_pool();
 }; // end class interned_string_pool
 
@@ -130,6 +130,43 @@ typedef vector<type_base*> type_base_ptrs_type;
 /// Helper typedef for a vector of shared pointer to a type_base.
 typedef vector<type_base_sptr> type_base_sptrs_type;
 
+/// The approximate memory footprint of the instances of a given kind
+/// of artifact.
+///
+/// This is what the get_memory_stats() functions report.
+struct memory_stats_entry
+{
+  /// The name of the kind of artifact.
+  string	kind;
+  /// The number of instances of that kind of artifact.
+  size_t	count;
+  /// The approximate number of bytes used by those instances.
+  size_t	bytes;
+  /// If true, @ref bytes is only the size of the objects themselves.
+  /// The memory they own (e.g, their private data, the elements of
+  /// their containers or the characters of their strings) is then
+  /// not accounted for, so @ref bytes is a lower bound of their
+  /// actual footprint.
+  bool		shallow;
+
+  memory_stats_entry(const string& k, size_t c, size_t b, bool s)
+    : kind(k), count(c), bytes(b), shallow(s)
+  {}
+}; // end struct memory_stats_entry
+
+/// Convenience typedef for a vector of @ref memory_stats_entry.
+typedef vector<memory_stats_entry> memory_stats_type;
+
+void
+add_memory_stats(memory_stats_type& stats,
+		 const string& kind,
+		 size_t count,
+		 size_t bytes,
+		 bool shallow = false);
+
+void
+get_memory_stats(const translation_unit& tu, memory_stats_type& stats);
+
 /// This is an abstraction of the set of resources necessary to manage
 /// several aspects of the internal representations of the Abigail
 /// library.
@@ -171,6 +208,13 @@ public:
   const canonical_types_map_type&
   get_canonical_types_map() const;
 
+  void
+  get_canonical_types_stats(size_t& num_buckets,
+			    size_t& num_canonical_types,
+			    size_t& longest_bucket_length,
+			    size_t& num_deep_comparisons,
+			    size_t& num_avoided_comparisons) const;
+
   const type_base_sptr&
   get_void_type() const;
 
@@ -210,6 +254,10 @@ public:
   interned_string
   intern(const string&) const;
 
+  void
+  get_memory_stats(memory_stats_type& stats) const;
+
+  friend class type_base;
   friend class class_or_union;
   friend class class_decl;
   friend class function_type;
@@ -638,6 +686,12 @@ public:
   const std::string&
   get_absolute_path() const;
 
+  const std::string&
+  get_content_hash() const;
+
+  void
+  set_content_hash(const std::string&);
+
   void
   set_corpus(corpus*);
 
@@ -730,6 +784,15 @@ struct shared_translation_unit_comp
 typedef std::set<translation_unit_sptr,
 		 shared_translation_unit_comp> translation_units;
 
+/// Convenience typedef for a map which key is the absolute path of a
+/// translation unit and which value is the hash of its content.  See
+/// translation_unit::get_content_hash.
+typedef unordered_map<string, string> translation_unit_hashes_type;
+
+/// Convenience typedef for a set of absolute paths of translation
+/// units.
+typedef unordered_set<string> translation_unit_paths_type;
+
 string
 translation_unit_language_to_string(translation_unit::language);
 
@@ -106,6 +106,20 @@ add_read_context_suppressions(read_context& ctxt,
 void
 consider_types_not_reachable_from_public_interfaces(read_context& ctxt,
 						    bool flag);
+
+void
+set_num_threads(read_context& ctxt, size_t n);
+
+size_t
+get_num_threads(const read_context& ctxt);
+
+void
+set_translation_units_to_skip(read_context& ctxt,
+			      const translation_unit_paths_type& paths);
+
+bool
+read_translation_unit_hashes(read_context& ctxt,
+			     translation_unit_hashes_type& hashes);
 }//end xml_reader
 }//end namespace abigail
 
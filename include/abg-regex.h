@@ -71,6 +71,12 @@ operator<<(std::ostream& os, const escape& esc);
 std::string
 generate_from_strings(const std::vector<std::string>& strs);
 
+bool
+get_literals(const std::string& str, std::vector<std::string>& literals);
+
+std::string
+get_literal_prefix(const std::string& str);
+
 regex_t_sptr
 compile(const std::string& str);
 
@@ -91,10 +91,18 @@ suppr::type_suppression_sptr
 gen_suppr_spec_from_headers(const string& hdrs_root_dir,
 			    const vector<string>& hdr_files);
 
+void
+load_kernel_abi_whitelists(const vector<string>& abi_whitelist_paths,
+			   vector<string>& whitelisted_names);
+
 suppr::suppressions_type
 gen_suppr_spec_from_kernel_abi_whitelists
    (const vector<string>& abi_whitelist_paths);
 
+suppr::suppressions_type
+gen_suppr_spec_from_kernel_abi_whitelisted_names
+   (const vector<string>& whitelisted_names);
+
 bool
 get_vmlinux_path_from_kernel_dist(const string&	from,
 				  string&		vmlinux_path);
@@ -173,6 +181,11 @@ get_random_number();
 string
 get_random_number_as_string();
 
+void
+emit_memory_stats(const ir::memory_stats_type& stats,
+		  const string& title,
+		  ostream& out);
+
 /// The different types of files understood the bi* suite of tools.
 enum file_type
 {
@@ -280,6 +293,7 @@ public:
   bool start();
   bool stop();
   time_t value_in_seconds() const;
+  size_t value_in_milliseconds() const;
   bool value(time_t& hours,
 	     time_t& minutes,
 	     time_t& seconds,
@@ -328,7 +342,8 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
 					  vector<string>&	kabi_wl_paths,
 					  suppr::suppressions_type&	supprs,
 					  bool				verbose,
-					  environment_sptr&		env);
+					  environment_sptr&		env,
+					  size_t			num_threads = 1);
 }// end namespace tools_utils
 
 /// A macro that expands to aborting the program when executed.
@@ -220,6 +220,7 @@ struct diff_context::priv
   bool					show_unreachable_types_;
   bool					show_impacted_interfaces_;
   bool					dump_diff_tree_;
+  corpus_matching_engine_kind		corpus_matching_engine_;
 
   priv()
     : allowed_category_(EVERYTHING_CATEGORY),
@@ -248,7 +249,8 @@ struct diff_context::priv
       show_added_syms_unreferenced_by_di_(true),
       show_unreachable_types_(false),
       show_impacted_interfaces_(true),
-      dump_diff_tree_()
+      dump_diff_tree_(),
+      corpus_matching_engine_(HASH_JOIN_MATCHING_ENGINE)
    {}
 };// end struct diff_context::priv
 
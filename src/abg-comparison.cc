@@ -1873,6 +1873,31 @@ void
 diff_context::dump_diff_tree(bool f)
 {priv_->dump_diff_tree_ = f;}
 
+/// Getter of the kind of engine used to match the functions,
+/// variables and ELF symbols of two corpora.
+///
+/// @return the kind of engine used to match the functions, variables
+/// and ELF symbols of two corpora.
+corpus_matching_engine_kind
+diff_context::corpus_matching_engine() const
+{return priv_->corpus_matching_engine_;}
+
+/// Setter of the kind of engine used to match the functions,
+/// variables and ELF symbols of two corpora.
+///
+/// Both engines yield the same @ref corpus_diff.  The edit script
+/// engine compares each artifact of the first corpus with the
+/// artifacts of the second corpus that are around the same position
+/// in their sorted sequences, which can take a lot of deep
+/// comparisons when many artifacts changed.  The hash join engine
+/// only compares the artifacts that have the same ID.
+///
+/// @param k the kind of engine to use to match the functions,
+/// variables and ELF symbols of two corpora.
+void
+diff_context::corpus_matching_engine(corpus_matching_engine_kind k)
+{priv_->corpus_matching_engine_ = k;}
+
 /// Emit a textual representation of a diff tree to the error output
 /// stream of the current context, for debugging purposes.
 ///
@@ -11091,6 +11116,124 @@ corpus_diff::traverse(diff_node_visitor& v)
   return true;
 }
 
+/// Get the key used to match a function with the functions of
+/// another corpus.
+///
+/// @param fn the function to consider.
+///
+/// @return the key of @p fn.
+static string
+get_matching_key(const function_decl* fn)
+{return fn->get_id();}
+
+/// Get the key used to match a variable with the variables of
+/// another corpus.
+///
+/// @param var the variable to consider.
+///
+/// @return the key of @p var.
+static string
+get_matching_key(const var_decl* var)
+{return var->get_id();}
+
+/// Get the key used to match an ELF symbol with the ELF symbols of
+/// another corpus.
+///
+/// @param sym the ELF symbol to consider.
+///
+/// @return the key of @p sym.
+static string
+get_matching_key(const elf_symbol_sptr& sym)
+{return sym->get_id_string();}
+
+/// Compute the edit script between two sequences of artifacts of
+/// corpora, by matching the artifacts by key.
+///
+/// Each artifact of the first sequence is deeply compared with the
+/// artifacts of the second sequence which have the same key (see the
+/// get_matching_key overloads) and that were not matched yet.  If one
+/// of them is equal to it, the two artifacts are matched.  Otherwise,
+/// the artifact is deleted.  The artifacts of the second sequence that
+/// are not matched are inserted.
+///
+/// Unlike the edit script computed by the Myers algorithm, the
+/// resulting edit script is not minimal with respect to the order of
+/// the artifacts.  But as corpus_diff pairs the deleted and inserted
+/// artifacts by ID, it yields the same @ref corpus_diff.
+///
+/// @param first the first sequence of artifacts to consider.
+///
+/// @param second the second sequence of artifacts to consider.
+///
+/// @param result the resulting edit script.
+template<typename T>
+static void
+compute_diff_by_matching_keys(const vector<T>&		first,
+			      const vector<T>&		second,
+			      diff_utils::edit_script&	result)
+{
+  typedef unordered_map<string, vector<unsigned> > key_indexes_map_type;
+
+  key_indexes_map_type indexes_of_second;
+  for (unsigned i = 0; i < second.size(); ++i)
+    indexes_of_second[get_matching_key(second[i])].push_back(i);
+
+  diff_utils::deep_ptr_eq_functor eq;
+  vector<bool> matched(second.size(), false);
+  for (unsigned i = 0; i < first.size(); ++i)
+    {
+      bool found = false;
+      key_indexes_map_type::const_iterator k =
+	indexes_of_second.find(get_matching_key(first[i]));
+      if (k != indexes_of_second.end())
+	for (vector<unsigned>::const_iterator j = k->second.begin();
+	     j != k->second.end();
+	     ++j)
+	  if (!matched[*j] && eq(first[i], second[*j]))
+	    {
+	      matched[*j] = true;
+	      found = true;
+	      break;
+	    }
+      if (!found)
+	result.deletions().push_back(diff_utils::deletion(i));
+    }
+
+  diff_utils::insertion ins(/*insertion_point=*/-1);
+  for (unsigned i = 0; i < second.size(); ++i)
+    if (!matched[i])
+      ins.inserted_indexes().push_back(i);
+  if (!ins.inserted_indexes().empty())
+    result.insertions().push_back(ins);
+}
+
+/// Compute the edit script between two sequences of artifacts of
+/// corpora, using a given matching engine.
+///
+/// @param first the first sequence of artifacts to consider.
+///
+/// @param second the second sequence of artifacts to consider.
+///
+/// @param engine the kind of matching engine to use.
+///
+/// @param result the resulting edit script.
+template<typename T>
+static void
+compute_corpus_artifacts_diff(const vector<T>&			first,
+			      const vector<T>&			second,
+			      corpus_matching_engine_kind	engine,
+			      diff_utils::edit_script&		result)
+{
+  if (engine == HASH_JOIN_MATCHING_ENGINE)
+    compute_diff_by_matching_keys(first, second, result);
+  else
+    diff_utils::compute_diff<typename vector<T>::const_iterator,
+			     diff_utils::deep_ptr_eq_functor>
+      (first.begin(), first.end(),
+       second.begin(), second.end(),
+       result);
+}
+
 /// Compute the diff between two instances of @ref corpus.
 ///
 /// Note that the two corpora must have been created in the same @ref
@@ -11108,9 +11251,6 @@ compute_diff(const corpus_sptr	f,
 	     const corpus_sptr	s,
 	     diff_context_sptr	ctxt)
 {
-  typedef corpus::functions::const_iterator fns_it_type;
-  typedef corpus::variables::const_iterator vars_it_type;
-  typedef elf_symbols::const_iterator symbols_it_type;
   typedef diff_utils::deep_ptr_eq_functor eq_type;
   typedef vector<type_base_wptr>::const_iterator type_base_wptr_it_type;
 
@@ -11133,35 +11273,30 @@ compute_diff(const corpus_sptr	f,
     f->get_architecture_name() == s->get_architecture_name();
 
   // Compute the diff of publicly defined and exported functions
-  diff_utils::compute_diff<fns_it_type, eq_type>(f->get_functions().begin(),
-						 f->get_functions().end(),
-						 s->get_functions().begin(),
-						 s->get_functions().end(),
-						 r->priv_->fns_edit_script_);
+  compute_corpus_artifacts_diff(f->get_functions(),
+				s->get_functions(),
+				ctxt->corpus_matching_engine(),
+				r->priv_->fns_edit_script_);
 
   // Compute the diff of publicly defined and exported variables.
-  diff_utils::compute_diff<vars_it_type, eq_type>
-    (f->get_variables().begin(), f->get_variables().end(),
-     s->get_variables().begin(), s->get_variables().end(),
-     r->priv_->vars_edit_script_);
+  compute_corpus_artifacts_diff(f->get_variables(),
+				s->get_variables(),
+				ctxt->corpus_matching_engine(),
+				r->priv_->vars_edit_script_);
 
   // Compute the diff of function elf symbols not referenced by debug
   // info.
-  diff_utils::compute_diff<symbols_it_type, eq_type>
-    (f->get_unreferenced_function_symbols().begin(),
-     f->get_unreferenced_function_symbols().end(),
-     s->get_unreferenced_function_symbols().begin(),
-     s->get_unreferenced_function_symbols().end(),
-     r->priv_->unrefed_fn_syms_edit_script_);
+  compute_corpus_artifacts_diff(f->get_unreferenced_function_symbols(),
+				s->get_unreferenced_function_symbols(),
+				ctxt->corpus_matching_engine(),
+				r->priv_->unrefed_fn_syms_edit_script_);
 
   // Compute the diff of variable elf symbols not referenced by debug
   // info.
-    diff_utils::compute_diff<symbols_it_type, eq_type>
-    (f->get_unreferenced_variable_symbols().begin(),
-     f->get_unreferenced_variable_symbols().end(),
-     s->get_unreferenced_variable_symbols().begin(),
-     s->get_unreferenced_variable_symbols().end(),
-     r->priv_->unrefed_var_syms_edit_script_);
+  compute_corpus_artifacts_diff(f->get_unreferenced_variable_symbols(),
+				s->get_unreferenced_variable_symbols(),
+				ctxt->corpus_matching_engine(),
+				r->priv_->unrefed_var_syms_edit_script_);
 
     if (ctxt->show_unreachable_types())
       // Compute the diff of types not reachable from public functions
@@ -11204,6 +11339,56 @@ compute_diff(const corpus_group_sptr&	f,
   return compute_diff(c1, c2, ctxt);
 }
 
+/// Compute the diffs between several baseline instances of @ref
+/// corpus and a new @ref corpus.
+///
+/// This is useful to check a new version of a binary against several
+/// of its previous versions.  The new corpus is read only once, in
+/// the same @ref environment as all the baselines.  Its types being
+/// canonicalized in that environment, the types of the baselines
+/// that are equal to them get the same canonical types, and are thus
+/// compared by pointer in each of the comparisons.
+///
+/// Note that the comparisons are performed one after the other, in
+/// the calling thread.  Comparing types updates state that is shared
+/// by all the comparisons: the types being compared are marked in
+/// the environment, and the types of the new corpus are compared
+/// against the types of every baseline.
+///
+/// @param baselines the baseline corpora to compare @p c against.
+/// They must have been created in the same environment as @p c,
+/// otherwise, this function aborts.
+///
+/// @param c the new corpus to consider.
+///
+/// @param ctxts the diff contexts to use for the comparisons.  The
+/// diff context at index i is used for the comparison of the
+/// baseline at index i.  A diff context can't be shared by several
+/// comparisons.  If this vector is shorter than @p baselines, or if
+/// one of its elements is nil, a new diff context is created for the
+/// matching comparisons.
+///
+/// @param diffs output parameter.  The diffs between each baseline
+/// and @p c, in the order of @p baselines.
+void
+compute_diffs(const vector<corpus_sptr>&	baselines,
+	      const corpus_sptr&		c,
+	      const vector<diff_context_sptr>&	ctxts,
+	      corpus_diff_sptrs_type&		diffs)
+{
+  ABG_ASSERT(c);
+
+  diffs.clear();
+  diffs.reserve(baselines.size());
+  for (size_t i = 0; i < baselines.size(); ++i)
+    {
+      diff_context_sptr ctxt;
+      if (i < ctxts.size())
+	ctxt = ctxts[i];
+      diffs.push_back(compute_diff(baselines[i], c, ctxt));
+    }
+}
+
 // <corpus_group stuff>
 
 // </corpus_group stuff>
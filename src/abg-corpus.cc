@@ -2050,5 +2050,65 @@ corpus_group::recording_types_reachable_from_public_interface_supported()
 
 // </corpus_group stuff>
 
+/// Add the memory footprint of the ELF symbols of a symbol map to a
+/// set of memory statistics.
+///
+/// @param m the symbol map to consider.
+///
+/// @param stats the statistics to add the ELF symbols to.
+static void
+add_elf_symbols_memory_stats(const string_elf_symbols_map_type& m,
+			     memory_stats_type& stats)
+{
+  size_t num_symbols = 0;
+  for (string_elf_symbols_map_type::const_iterator i = m.begin();
+       i != m.end();
+       ++i)
+    num_symbols += i->second.size();
+  add_memory_stats(stats, "elf_symbol", num_symbols,
+		   num_symbols * sizeof(elf_symbol), /*shallow=*/true);
+}
+
+/// Get statistics about the memory used by the internal
+/// representation of an ABI corpus.
+///
+/// This reports the IR nodes of the translation units of the corpus,
+/// per kind of node, as well as its ELF symbols.  If the corpus is a
+/// @ref corpus_group, this reports the memory used by all the corpora
+/// of the group.
+///
+/// Note that the memory used by the environment of the corpus is
+/// reported by environment::get_memory_stats().
+///
+/// @param c the corpus to consider.
+///
+/// @param stats the statistics to add the ones of @p c to.
+void
+get_memory_stats(const corpus& c, memory_stats_type& stats)
+{
+  if (const corpus_group* g = dynamic_cast<const corpus_group*>(&c))
+    {
+      for (corpus_group::corpora_type::const_iterator i =
+	     g->get_corpora().begin();
+	   i != g->get_corpora().end();
+	   ++i)
+	get_memory_stats(**i, stats);
+      return;
+    }
+
+  for (translation_units::const_iterator i =
+	 c.get_translation_units().begin();
+       i != c.get_translation_units().end();
+       ++i)
+    get_memory_stats(**i, stats);
+
+  add_elf_symbols_memory_stats(c.get_fun_symbol_map(), stats);
+  add_elf_symbols_memory_stats(c.get_var_symbol_map(), stats);
+  if (string_elf_symbols_map_sptr m = c.get_undefined_fun_symbol_map_sptr())
+    add_elf_symbols_memory_stats(*m, stats);
+  if (string_elf_symbols_map_sptr m = c.get_undefined_var_symbol_map_sptr())
+    add_elf_symbols_memory_stats(*m, stats);
+}
+
 }// end namespace ir
 }// end namespace abigail
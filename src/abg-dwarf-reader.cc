@@ -44,6 +44,8 @@
 #include <list>
 #include <ostream>
 #include <sstream>
+#include <fstream>
+#include <iomanip>
 
 #include "abg-cxx-compat.h"
 #include "abg-ir-priv.h"
@@ -51,11 +53,16 @@
 #include "abg-corpus-priv.h"
 #include "abg-elf-helpers.h"
 #include "abg-internal.h"
+#include "abg-workers.h"
 
 // <headers defining libabigail's API go under here>
 ABG_BEGIN_EXPORT_DECLARATIONS
 
+#include "abg-config.h"
 #include "abg-dwarf-reader.h"
+#include "abg-hash.h"
+#include "abg-reader.h"
+#include "abg-writer.h"
 #include "abg-sptr-utils.h"
 #include "abg-tools-utils.h"
 
@@ -194,6 +201,10 @@ typedef stack<scope_decl*> scope_stack_type;
 /// value is also a dwarf offset.
 typedef unordered_map<Dwarf_Off, Dwarf_Off> offset_offset_map_type;
 
+/// Convenience typedef for a map which key is a dwarf offset and
+/// which value is a hash value.
+typedef unordered_map<Dwarf_Off, uint64_t> offset_hash_map_type;
+
 /// Convenience typedef for a map which key is a string and which
 /// value is a vector of smart pointer to a class.
 typedef unordered_map<string, classes_type> string_classes_map;
@@ -293,6 +304,74 @@ static bool
 operator<(const imported_unit_point& l, const imported_unit_point& r)
 {return l.offset_of_import < r.offset_of_import;}
 
+/// The key of the caches that memoize the names computed by
+/// die_qualified_type_name(), die_qualified_decl_name() and
+/// die_pretty_print_type().
+///
+/// Besides the DIE itself, those names depend on the language of the
+/// current translation unit and, when the current translation unit
+/// imports partial units, on where we logically are in the DIE
+/// stream.  All the "where offsets" that are preceded by the same
+/// import points of the current translation unit yield the same
+/// names, so they are folded into the same @ref where_class.
+struct die_name_memo_key
+{
+  Dwarf_Off			die_offset;
+  // The offset of the current translation unit, or zero if it
+  // doesn't import any unit.
+  Dwarf_Off			tu_offset;
+  // Zero if the current translation unit doesn't import any unit.
+  // Otherwise, one plus the number of its import points that are
+  // located before the "where offset".
+  size_t			where_class;
+  translation_unit::language	language;
+
+  die_name_memo_key(Dwarf_Off			o,
+		    Dwarf_Off			tu,
+		    size_t			w,
+		    translation_unit::language	l)
+    : die_offset(o), tu_offset(tu), where_class(w), language(l)
+  {}
+
+  bool
+  operator==(const die_name_memo_key& o) const
+  {
+    return (die_offset == o.die_offset
+	    && tu_offset == o.tu_offset
+	    && where_class == o.where_class
+	    && language == o.language);
+  }
+}; // end struct die_name_memo_key
+
+/// Hasher for @ref die_name_memo_key.
+struct die_name_memo_key_hash
+{
+  size_t
+  operator()(const die_name_memo_key& k) const
+  {
+    abg_compat::hash<size_t> h;
+    size_t result = h(k.die_offset);
+    result = hashing::combine_hashes(result, h(k.tu_offset));
+    result = hashing::combine_hashes(result, h(k.where_class));
+    result = hashing::combine_hashes(result, h(k.language));
+    return result;
+  }
+}; // end struct die_name_memo_key_hash
+
+/// Convenience typedef for a map that memoizes the names of DIEs.
+typedef unordered_map<die_name_memo_key,
+		      interned_string,
+		      die_name_memo_key_hash> die_name_memo_map_type;
+
+/// The kinds of DIE names that are memoized by the read_context.
+enum die_name_kind
+{
+  DIE_QUALIFIED_TYPE_NAME,
+  DIE_QUALIFIED_DECL_NAME,
+  DIE_PRETTY_TYPE_REPRESENTATION,
+  NUMBER_OF_DIE_NAME_KINDS
+};
+
 static void
 add_symbol_to_map(const elf_symbol_sptr& sym,
 		  string_elf_symbols_map_type& map);
@@ -547,6 +626,9 @@ compare_dies(const read_context& ctxt,
 	     const Dwarf_Die *l, const Dwarf_Die *r,
 	     bool update_canonical_dies_on_the_fly);
 
+static uint64_t
+compute_die_structural_hash(const read_context& ctxt, const Dwarf_Die* die);
+
 
 /// Find the file name of the alternate debug info file.
 ///
@@ -1253,6 +1335,10 @@ lookup_symbol_from_elf_hash_tab(const environment*		env,
 
 /// Lookup a symbol from the symbol table directly.
 ///
+/// This walks the symbol table once.  Indexing the names of the
+/// symbols of the table (see @ref elf_symbol_index::lookup_symbols)
+/// only pays off when several names are looked up; see
+/// lookup_symbols_from_elf.
 ///
 /// @param env the environment we are operating from.
 ///
@@ -1283,65 +1369,33 @@ lookup_symbol_from_symtab(const environment*		env,
 			  bool				demangle,
 			  vector<elf_symbol_sptr>&	syms_found)
 {
-  // TODO: read all of the symbol table, store it in memory in a data
-  // structure that associates each symbol with its versions and in
-  // which lookups of a given symbol is fast.
   Elf_Scn* sym_tab_section = elf_getscn(elf_handle, sym_tab_index);
   ABG_ASSERT(sym_tab_section);
 
   GElf_Shdr header_mem;
-  GElf_Shdr * sym_tab_header = gelf_getshdr(sym_tab_section,
-					    &header_mem);
+  GElf_Shdr* sym_tab_header = gelf_getshdr(sym_tab_section, &header_mem);
+  ABG_ASSERT(sym_tab_header);
 
-  size_t symcount = sym_tab_header->sh_size / sym_tab_header->sh_entsize;
-  Elf_Data* symtab = elf_getdata(sym_tab_section, NULL);
-  GElf_Sym* sym;
-  char* name_str = 0;
-  elf_symbol::version ver;
+  // The index is only used to build the symbols found, as it looks
+  // up the symbol versionning sections once.
+  elf_symbol_index index(env, elf_handle, sym_tab_section);
   bool found = false;
-  Elf_Scn *strings_section = find_ksymtab_strings_section(elf_handle);
-  size_t strings_ndx = strings_section
-    ? elf_ndxscn(strings_section)
-    : 0;
-
-  for (size_t i = 0; i < symcount; ++i)
+  for (size_t i = 0; i < index.get_number_of_symbols(); ++i)
     {
-      GElf_Sym sym_mem;
-      sym = gelf_getsym(symtab, i, &sym_mem);
-      name_str = elf_strptr(elf_handle,
-			    sym_tab_header->sh_link,
-			    sym->st_name);
-
+      GElf_Sym sym;
+      if (!index.get_native_symbol(i, sym))
+	continue;
+      const char* name_str = elf_strptr(elf_handle,
+					sym_tab_header->sh_link,
+					sym.st_name);
       if (name_str && compare_symbol_name(name_str, sym_name, demangle))
 	{
-	  elf_symbol::type sym_type =
-	    stt_to_elf_symbol_type(GELF_ST_TYPE(sym->st_info));
-	  elf_symbol::binding sym_binding =
-	    stb_to_elf_symbol_binding(GELF_ST_BIND(sym->st_info));
-	  elf_symbol::visibility sym_visibility =
-	    stv_to_elf_symbol_visibility(GELF_ST_VISIBILITY(sym->st_other));
-	  bool sym_is_defined = sym->st_shndx != SHN_UNDEF;
-	  bool sym_is_common = sym->st_shndx == SHN_COMMON;
-
-	  if (get_version_for_symbol(elf_handle, i,
-				     /*get_def_version=*/sym_is_defined,
-				     ver))
-	    ABG_ASSERT(!ver.str().empty());
-	  elf_symbol_sptr symbol_found =
-	    elf_symbol::create(env, i, sym->st_size,
-			       name_str, sym_type,
-			       sym_binding, sym_is_defined,
-			       sym_is_common, ver, sym_visibility,
-			       sym->st_shndx == strings_ndx);
-	  syms_found.push_back(symbol_found);
+	  syms_found.push_back(index.create_symbol(i, sym));
 	  found = true;
 	}
     }
 
-  if (found)
-    return true;
-
-  return false;
+  return found;
 }
 
 /// Look into the symbol tables of the underlying elf file and see
@@ -2013,6 +2067,272 @@ enum ksymtab_format
   V4_19_KSYMTAB_FORMAT
 }; // end enum ksymtab_format
 
+/// Get the source of a DIE.
+///
+/// The function returns an enumerator value saying if the DIE comes
+/// from the .debug_info section of the primary debug info file, the
+/// .debug_info section of the alternate debug info file, or the
+/// .debug_types section.
+///
+/// @param die the DIE to get the source of.
+///
+/// @param primary_dwarf the handle of the primary debug info that @p
+/// die might come from.
+///
+/// @param alt_dwarf the handle of the alternate debug info that @p
+/// die might come from.
+///
+/// @param source out parameter.  The function sets this parameter
+/// to the source of the DIE @p iff it returns true.
+///
+/// @return true iff the source of the DIE could be determined and
+/// returned.
+static bool
+get_die_source(const Dwarf_Die &die,
+	       const Dwarf *primary_dwarf,
+	       const Dwarf *alt_dwarf,
+	       die_source &source)
+{
+  Dwarf_Die cu_die;
+  Dwarf_Die cu_kind;
+  uint8_t address_size = 0, offset_size = 0;
+  if (!dwarf_diecu(const_cast<Dwarf_Die*>(&die),
+		   &cu_die, &address_size,
+		   &offset_size))
+    return false;
+
+  Dwarf_Half version = 0;
+  Dwarf_Off abbrev_offset = 0;
+  uint64_t type_signature = 0;
+  Dwarf_Off type_offset = 0;
+  if (!dwarf_cu_die(cu_die.cu, &cu_kind,
+		    &version, &abbrev_offset,
+		    &address_size, &offset_size,
+		    &type_signature, &type_offset))
+    return false;
+
+  int tag = dwarf_tag(&cu_kind);
+
+  if (tag == DW_TAG_compile_unit
+      || tag == DW_TAG_partial_unit)
+    {
+      Dwarf *die_dwarf = dwarf_cu_getdwarf(cu_die.cu);
+      if (primary_dwarf == die_dwarf)
+	source = PRIMARY_DEBUG_INFO_DIE_SOURCE;
+      else if (alt_dwarf == die_dwarf)
+	source = ALT_DEBUG_INFO_DIE_SOURCE;
+      else
+	ABG_ASSERT_NOT_REACHED;
+    }
+  else if (tag == DW_TAG_type_unit)
+    source = TYPE_UNIT_DIE_SOURCE;
+  else
+    return false;
+
+  return true;
+}
+
+/// The abstraction of a unit (a DW_TAG_compile_unit, a
+/// DW_TAG_partial_unit or a DW_TAG_type_unit) of the debug info, as
+/// seen by the concurrent DIE -> parent maps builder.
+struct unit_die_offset
+{
+  die_source	source;
+  Dwarf_Off	offset;
+
+  unit_die_offset(die_source s, Dwarf_Off o)
+    : source(s),
+      offset(o)
+  {}
+}; // end struct unit_die_offset
+
+/// Convenience typedef for a vector of @ref unit_die_offset.
+typedef vector<unit_die_offset> unit_die_offsets_type;
+
+/// A task that walks the DIEs of a sub-set of the units of a debug
+/// info file and records the DIE -> parent relationships and the
+/// unit import points it finds there.
+///
+/// libdw handles cannot be used by several threads at the same time
+/// so each instance of this task opens its own handles on the debug
+/// info (and on the alternate debug info) of the ELF file.  Those
+/// handles are only used to walk the DIEs; what the task produces is
+/// expressed in terms of DIE offsets so it can then be merged into
+/// the @ref read_context by read_context::build_die_parent_maps().
+class die_parent_maps_task : public abigail::workers::task
+{
+  string			elf_path_;
+  vector<char**>		debug_info_root_paths_;
+  unit_die_offsets_type	units_;
+  Dwarf*			dwarf_;
+  Dwarf*			alt_dwarf_;
+
+public:
+
+  /// The DIE -> parent maps built by this task, one per @ref
+  /// die_source.
+  offset_offset_map_type	parent_maps[NUMBER_OF_DIE_SOURCES];
+
+  /// The units that were walked by this task, in the order they were
+  /// walked.
+  unit_die_offsets_type		walked_units;
+
+  /// The import points found under each unit of @ref walked_units.
+  vector<imported_unit_points_type> imported_units;
+
+  /// This is true iff the task could open the debug info.
+  bool				is_ok;
+
+  /// Constructor of @ref die_parent_maps_task.
+  ///
+  /// @param elf_path the path to the ELF file to consider.
+  ///
+  /// @param debug_info_root_paths the root directories under which
+  /// to look for split debug info.
+  ///
+  /// @param units the units this task has to walk.
+  die_parent_maps_task(const string& elf_path,
+		       const vector<char**>& debug_info_root_paths,
+		       const unit_die_offsets_type& units)
+    : elf_path_(elf_path),
+      debug_info_root_paths_(debug_info_root_paths),
+      units_(units),
+      dwarf_(),
+      alt_dwarf_(),
+      is_ok()
+  {}
+
+  /// Walk the DIEs under a given DIE and record the child -> parent
+  /// relationship of each of them, recursively.
+  ///
+  /// This is the counterpart of
+  /// read_context::build_die_parent_relations_under() for the handles
+  /// owned by this task.
+  ///
+  /// @param die the DIE whose children to walk recursively.
+  ///
+  /// @param source where the DIE @p die comes from.
+  ///
+  /// @param imported_units the vector of the points where units are
+  /// imported, under @p die.
+  void
+  build_die_parent_relations_under(Dwarf_Die*			die,
+				   die_source			source,
+				   imported_unit_points_type&	imported_units)
+  {
+    if (!die)
+      return;
+
+    offset_offset_map_type& parent_of = parent_maps[source];
+
+    Dwarf_Die child;
+    if (dwarf_child(die, &child) != 0)
+      return;
+
+    do
+      {
+	parent_of[dwarf_dieoffset(&child)] = dwarf_dieoffset(die);
+	if (dwarf_tag(&child) == DW_TAG_imported_unit)
+	  {
+	    Dwarf_Die imported_unit;
+	    if (die_die_attribute(&child, DW_AT_import, imported_unit))
+	      {
+		die_source imported_unit_die_source = NO_DEBUG_INFO_DIE_SOURCE;
+		ABG_ASSERT(get_die_source(imported_unit, dwarf_, alt_dwarf_,
+					  imported_unit_die_source));
+		imported_units.push_back
+		  (imported_unit_point(dwarf_dieoffset(&child),
+				       imported_unit,
+				       imported_unit_die_source));
+	      }
+	  }
+	build_die_parent_relations_under(&child, source, imported_units);
+      }
+    while (dwarf_siblingof(&child, &child) == 0);
+  }
+
+  /// Open the debug info of the ELF file the same way
+  /// read_context::load_debug_info() does, walk the units assigned to
+  /// this task and release the debug info handles.
+  virtual void
+  perform()
+  {
+    Dwfl_Callbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    callbacks.find_debuginfo = dwfl_standard_find_debuginfo;
+    callbacks.section_address = dwfl_offline_section_address;
+    callbacks.debuginfo_path =
+      debug_info_root_paths_.empty() ? 0 : debug_info_root_paths_.front();
+
+    dwfl_sptr handle(dwfl_begin(&callbacks), dwfl_deleter());
+    if (!handle)
+      return;
+
+    string elf_base_name;
+    tools_utils::base_name(elf_path_, elf_base_name);
+    Dwfl_Module* elf_module = dwfl_report_offline(handle.get(),
+						  elf_base_name.c_str(),
+						  elf_path_.c_str(),
+						  -1);
+    dwfl_report_end(handle.get(), 0, 0);
+    if (!elf_module)
+      return;
+
+    Dwarf_Addr bias = 0;
+    dwarf_ = dwfl_module_getdwarf(elf_module, &bias);
+    for (vector<char**>::const_iterator i = debug_info_root_paths_.begin();
+	 dwarf_ == 0 && i != debug_info_root_paths_.end();
+	 ++i)
+      {
+	callbacks.debuginfo_path = *i;
+	dwarf_ = dwfl_module_getdwarf(elf_module, &bias);
+      }
+    if (!dwarf_)
+      return;
+
+    string alt_debug_info_path;
+    int alt_fd = 0;
+    alt_dwarf_ = find_alt_debug_info(elf_module, debug_info_root_paths_,
+				     alt_debug_info_path, alt_fd);
+
+    is_ok = true;
+    for (unit_die_offsets_type::const_iterator u = units_.begin();
+	 u != units_.end();
+	 ++u)
+      {
+	Dwarf_Die cu;
+	if (u->source == TYPE_UNIT_DIE_SOURCE)
+	  {
+	    if (!dwarf_offdie_types(dwarf_, u->offset, &cu))
+	      continue;
+	  }
+	else if (!dwarf_offdie(u->source == ALT_DEBUG_INFO_DIE_SOURCE
+			       ? alt_dwarf_
+			       : dwarf_,
+			       u->offset, &cu))
+	  continue;
+
+	walked_units.push_back(*u);
+	imported_units.push_back(imported_unit_points_type());
+	build_die_parent_relations_under(&cu, u->source,
+					 imported_units.back());
+      }
+
+    if (alt_fd)
+      {
+	close(alt_fd);
+	if (alt_dwarf_)
+	  dwarf_end(alt_dwarf_);
+      }
+    alt_dwarf_ = 0;
+    dwarf_ = 0;
+  }
+}; // end class die_parent_maps_task
+
+/// Convenience typedef for a shared pointer to @ref
+/// die_parent_maps_task.
+typedef shared_ptr<die_parent_maps_task> die_parent_maps_task_sptr;
+
 /// The context used to build ABI corpus from debug info in DWARF
 /// format.
 ///
@@ -2026,6 +2346,11 @@ enum ksymtab_format
 class read_context
 {
 public:
+  /// The options of the context.
+  ///
+  /// When an option that has an impact on the corpus built from the
+  /// debug info is added here, it must be taken into account by
+  /// read_context::get_corpus_cache_key().  So please do not forget.
   struct options_type
   {
     environment*	env;
@@ -2034,6 +2359,10 @@ public:
     bool		ignore_symbol_table;
     bool		show_stats;
     bool		do_log;
+    size_t		num_threads;
+    string		corpus_cache_dir;
+    bool		compute_tu_hashes;
+    translation_unit_hashes_type baseline_tu_hashes;
 
     options_type()
       : env(),
@@ -2041,7 +2370,9 @@ public:
 	load_all_types(),
 	ignore_symbol_table(),
 	show_stats(),
-	do_log()
+	do_log(),
+	num_threads(1),
+	compute_tu_hashes()
     {}
   };// read_context::options_type
 
@@ -2145,12 +2476,20 @@ public:
   }; // end die_dependant_container_set
 
   suppr::suppressions_type	supprs_;
+  mutable suppr::suppressions_index supprs_index_;
+  symbol_names_set_sptr		kabi_whitelist_;
+  symbol_names_set_sptr		fn_symbols_of_interest_;
+  symbol_names_set_sptr		var_symbols_of_interest_;
   unsigned short		dwarf_version_;
   Dwfl_Callbacks		offline_callbacks_;
   // The set of directories under which to look for debug info.
   vector<char**>		debug_info_root_paths_;
   dwfl_sptr			handle_;
   Dwarf*			dwarf_;
+  // Whether load_debug_info() has already been invoked.  The ELF file
+  // is reported to the dwfl handle only once, even when its debug
+  // info couldn't be found.
+  bool				debug_info_load_attempted_;
   // The alternate debug info.  Alternate debug info sections are a
   // DWARF extension as of DWARF4 and are described at
   // http://www.dwarfstd.org/ShowIssue.php?issue=120604.1.  Below are
@@ -2166,6 +2505,8 @@ public:
   mutable Elf*			elf_handle_;
   string			elf_path_;
   mutable Elf_Scn*		symtab_section_;
+  // The index of the symbols of symtab_section_.
+  mutable elf_symbol_index_sptr	symbol_index_;
   // The "Official procedure descriptor section, aka .opd", used in
   // ppc64 elf v1 binaries.  This section contains the procedure
   // descriptors on that platform.
@@ -2208,6 +2549,13 @@ public:
   die_pretty_repr_maps_;
   mutable die_source_dependant_container_set<die_istring_map_type>
   die_pretty_type_repr_maps_;
+  // Sets of maps (one per kind of die source) that memoize the names
+  // computed by die_qualified_type_name(), die_qualified_decl_name()
+  // and die_pretty_print_type().  They are indexed by die_name_kind.
+  mutable die_source_dependant_container_set<die_name_memo_map_type>
+  die_name_memo_maps_[NUMBER_OF_DIE_NAME_KINDS];
+  mutable size_t num_die_name_memo_hits_[NUMBER_OF_DIE_NAME_KINDS];
+  mutable size_t num_die_name_memo_misses_[NUMBER_OF_DIE_NAME_KINDS];
   // A set of maps (one per kind of die source) that associates the
   // offset of a decl die to its corresponding decl artifact.
   mutable die_source_dependant_container_set<die_artefact_map_type>
@@ -2224,6 +2572,15 @@ public:
   /// the offset of a decl DIE to the offset of its canonical DIE.
   mutable die_source_dependant_container_set<offset_offset_map_type>
   canonical_decl_die_offsets_;
+  /// A set of maps (one per kind of die source) that associates the
+  /// offset of a DIE to its structural hash.  See
+  /// compute_die_structural_hash.
+  mutable die_source_dependant_container_set<offset_hash_map_type>
+  die_structural_hashes_;
+  mutable size_t num_die_structural_hash_hits_;
+  mutable size_t num_die_structural_hash_misses_;
+  mutable size_t num_die_comparisons_avoided_;
+  mutable size_t num_die_comparisons_performed_;
   /// A map that associates a function type representations to
   /// function types, inside a translation unit.
   mutable istring_fn_type_map_type per_tu_repr_to_fn_type_maps_;
@@ -2283,6 +2640,11 @@ public:
   corpus::exported_decls_builder* exported_decls_builder_;
   options_type			options_;
   bool				drop_undefined_syms_;
+  size_t			num_corpus_cache_hits_;
+  size_t			num_corpus_cache_misses_;
+  phase_timings_type		phase_timings_;
+  translation_unit_hashes_type	tu_hashes_;
+  translation_unit_paths_type	skipped_tus_;
   read_context();
 
 public:
@@ -2364,6 +2726,7 @@ public:
   {
     dwarf_version_ = 0;
     dwarf_ = 0;
+    debug_info_load_attempted_ = false;
     handle_.reset();
     alt_fd_ = 0;
     alt_dwarf_ = 0;
@@ -2371,6 +2734,7 @@ public:
     elf_handle_ = 0;
     elf_path_ = elf_path;
     symtab_section_ = 0;
+    symbol_index_.reset();
     opd_section_ = 0;
     ksymtab_format_ = UNDEFINED_KSYMTAB_FORMAT;
     ksymtab_entry_size_ = 0;
@@ -2387,15 +2751,30 @@ public:
     clear_alt_debug_info_data();
 
     supprs_.clear();
+    supprs_index_.clear();
+    kabi_whitelist_.reset();
+    fn_symbols_of_interest_.reset();
+    var_symbols_of_interest_.reset();
     decl_die_repr_die_offsets_maps_.clear();
     type_die_repr_die_offsets_maps_.clear();
     die_qualified_name_maps_.clear();
     die_pretty_repr_maps_.clear();
     die_pretty_type_repr_maps_.clear();
+    for (int k = 0; k < NUMBER_OF_DIE_NAME_KINDS; ++k)
+      {
+	die_name_memo_maps_[k].clear();
+	num_die_name_memo_hits_[k] = 0;
+	num_die_name_memo_misses_[k] = 0;
+      }
     decl_die_artefact_maps_.clear();
     type_die_artefact_maps_.clear();
     canonical_type_die_offsets_.clear();
     canonical_decl_die_offsets_.clear();
+    die_structural_hashes_.clear();
+    num_die_structural_hash_hits_ = 0;
+    num_die_structural_hash_misses_ = 0;
+    num_die_comparisons_avoided_ = 0;
+    num_die_comparisons_performed_ = 0;
     die_wip_classes_map_.clear();
     alternate_die_wip_classes_map_.clear();
     type_unit_die_wip_classes_map_.clear();
@@ -2442,6 +2821,11 @@ public:
     options_.load_in_linux_kernel_mode = linux_kernel_mode;
     options_.load_all_types = load_all_types;
     drop_undefined_syms_ = false;
+    num_corpus_cache_hits_ = 0;
+    num_corpus_cache_misses_ = 0;
+    phase_timings_.clear();
+    tu_hashes_.clear();
+    skipped_tus_.clear();
     load_in_linux_kernel_mode(linux_kernel_mode);
   }
 
@@ -2488,7 +2872,12 @@ public:
     die_qualified_name_maps_.clear();
     die_pretty_repr_maps_.clear();
     die_pretty_type_repr_maps_.clear();
+    for (int k = 0; k < NUMBER_OF_DIE_NAME_KINDS; ++k)
+      die_name_memo_maps_[k].clear();
+    die_structural_hashes_.clear();
     clear_types_to_canonicalize();
+    tu_hashes_.clear();
+    skipped_tus_.clear();
   }
 
   /// Getter for the current environment.
@@ -2543,7 +2932,94 @@ public:
   /// @return the suppression specifications.
   suppr::suppressions_type&
   get_suppressions()
-  {return supprs_;}
+  {
+    // The suppression specifications might be modified by the
+    // caller, so the index of suppression specifications has to be
+    // built again.
+    supprs_index_.clear();
+    return supprs_;
+  }
+
+  /// Getter of the KMI white list to be used during ELF/DWARF
+  /// parsing.
+  ///
+  /// @return the names of the symbols of the KMI white list, or nil
+  /// if no white list was provided.
+  const symbol_names_set_sptr&
+  kabi_whitelist() const
+  {return kabi_whitelist_;}
+
+  /// Setter of the KMI white list to be used during ELF/DWARF
+  /// parsing.
+  ///
+  /// @param names the names of the symbols of the KMI white list.
+  void
+  kabi_whitelist(const symbol_names_set_sptr& names)
+  {kabi_whitelist_ = names;}
+
+  /// Test if a symbol name is filtered out by the KMI white list.
+  ///
+  /// @param sym_name the symbol name to consider.
+  ///
+  /// @return true iff a KMI white list was provided and @p sym_name
+  /// is not in it.
+  bool
+  symbol_is_not_kabi_whitelisted(const string& sym_name) const
+  {
+    return (kabi_whitelist_
+	    && kabi_whitelist_->find(sym_name) == kabi_whitelist_->end());
+  }
+
+  /// Getter of the names of the ELF symbols of the functions to
+  /// build the internal representation for.
+  ///
+  /// @return the names of the symbols of interest, or nil if all
+  /// the functions are of interest.
+  const symbol_names_set_sptr&
+  function_symbols_of_interest() const
+  {return fn_symbols_of_interest_;}
+
+  /// Setter of the names of the ELF symbols of the functions to
+  /// build the internal representation for.
+  ///
+  /// @param names the names of the symbols of interest.  If this is
+  /// nil, all the functions are of interest.
+  void
+  function_symbols_of_interest(const symbol_names_set_sptr& names)
+  {fn_symbols_of_interest_ = names;}
+
+  /// Getter of the names of the ELF symbols of the variables to
+  /// build the internal representation for.
+  ///
+  /// @return the names of the symbols of interest, or nil if all
+  /// the variables are of interest.
+  const symbol_names_set_sptr&
+  variable_symbols_of_interest() const
+  {return var_symbols_of_interest_;}
+
+  /// Setter of the names of the ELF symbols of the variables to
+  /// build the internal representation for.
+  ///
+  /// @param names the names of the symbols of interest.  If this is
+  /// nil, all the variables are of interest.
+  void
+  variable_symbols_of_interest(const symbol_names_set_sptr& names)
+  {var_symbols_of_interest_ = names;}
+
+  /// Getter of the index of the suppression specifications to be
+  /// used during ELF/DWARF parsing.
+  ///
+  /// The index is built the first time this is invoked after the
+  /// suppression specifications might have been modified.
+  ///
+  /// @return the index of the suppression specifications.
+  const suppr::suppressions_index&
+  get_suppressions_index() const
+  {
+    if (!supprs_index_.is_built())
+      supprs_index_.build(supprs_);
+    return supprs_index_;
+  }
 
   /// Getter for the callbacks of the Dwarf Front End library of
   /// elfutils that is used by this reader to read dwarf.
@@ -2700,6 +3176,9 @@ public:
   /// Load the debug info associated with an elf file that is at a
   /// given path.
   ///
+  /// Note that the debug info is looked for only once.  Subsequent
+  /// invocations return the result of the first one.
+  ///
   /// @return a pointer to the DWARF debug info pointer upon
   /// successful debug info loading, NULL otherwise.
   Dwarf*
@@ -2708,8 +3187,9 @@ public:
     if (!dwfl_handle())
       return 0;
 
-    if (dwarf_)
+    if (debug_info_load_attempted_)
       return dwarf_;
+    debug_info_load_attempted_ = true;
 
     elf_module_ =
       dwfl_report_offline(dwfl_handle().get(),
@@ -2988,8 +3468,10 @@ public:
       {
 	cur_die_offset = *o;
 	get_die_from_offset(source, cur_die_offset, &potential_canonical_die);
-	if (compare_dies(*this, &die, &potential_canonical_die,
-			 /*update_canonical_dies_on_the_fly=*/false))
+	if (die_might_equal_canonical_candidate(&die,
+						&potential_canonical_die)
+	    && compare_dies(*this, &die, &potential_canonical_die,
+			    /*update_canonical_dies_on_the_fly=*/false))
 	  {
 	    canonical_die_offset = cur_die_offset;
 	    set_canonical_die_offset(canonical_dies, die_offset,
@@ -3092,8 +3574,9 @@ public:
 	cur_die_offset = *o;
 	get_die_from_offset(source, cur_die_offset, &canonical_die);
 	// compare die and canonical_die.
-	if (compare_dies(*this, die, &canonical_die,
-			 /*update_canonical_dies_on_the_fly=*/true))
+	if (die_might_equal_canonical_candidate(die, &canonical_die)
+	    && compare_dies(*this, die, &canonical_die,
+			    /*update_canonical_dies_on_the_fly=*/true))
 	  {
 	    set_canonical_die_offset(canonical_dies,
 				     die_offset,
@@ -3212,8 +3695,9 @@ public:
 	Dwarf_Off die_offset = i->second[n];
 	get_die_from_offset(source, die_offset, &canonical_die);
 	// compare die and canonical_die.
-	if (compare_dies(*this, die, &canonical_die,
-			 /*update_canonical_dies_on_the_fly=*/true))
+	if (die_might_equal_canonical_candidate(die, &canonical_die)
+	    && compare_dies(*this, die, &canonical_die,
+			    /*update_canonical_dies_on_the_fly=*/true))
 	  {
 	    set_canonical_die_offset(canonical_dies,
 				     initial_die_offset,
@@ -3270,45 +3754,7 @@ public:
   /// returned.
   bool
   get_die_source(const Dwarf_Die &die, die_source &source) const
-  {
-    Dwarf_Die cu_die;
-    Dwarf_Die cu_kind;
-    uint8_t address_size = 0, offset_size = 0;
-    if (!dwarf_diecu(const_cast<Dwarf_Die*>(&die),
-		     &cu_die, &address_size,
-		     &offset_size))
-      return false;
-
-    Dwarf_Half version = 0;
-    Dwarf_Off abbrev_offset = 0;
-    uint64_t type_signature = 0;
-    Dwarf_Off type_offset = 0;
-    if (!dwarf_cu_die(cu_die.cu, &cu_kind,
-		      &version, &abbrev_offset,
-		      &address_size, &offset_size,
-		      &type_signature, &type_offset))
-      return false;
-
-    int tag = dwarf_tag(&cu_kind);
-
-    if (tag == DW_TAG_compile_unit
-	|| tag == DW_TAG_partial_unit)
-      {
-	Dwarf *die_dwarf = dwarf_cu_getdwarf(cu_die.cu);
-	if (dwarf() == die_dwarf)
-	  source = PRIMARY_DEBUG_INFO_DIE_SOURCE;
-	else if (alt_dwarf() == die_dwarf)
-	  source = ALT_DEBUG_INFO_DIE_SOURCE;
-	else
-	  ABG_ASSERT_NOT_REACHED;
-      }
-    else if (tag == DW_TAG_type_unit)
-      source = TYPE_UNIT_DIE_SOURCE;
-    else
-      return false;
-
-    return true;
-  }
+  {return dwarf_reader::get_die_source(die, dwarf(), alt_dwarf(), source);}
 
   /// Getter for the DIE designated by an offset.
   ///
@@ -3593,69 +4039,346 @@ public:
     return i->second;
   }
 
-  /// Lookup the artifact that was built to represent a type that has
-  /// the same pretty representation as the type denoted by a given
-  /// DIE.
-  ///
-  /// Note that the DIE must have previously been associated with the
-  /// artifact using the functions associate_die_to_decl or
-  /// associate_die_to_type.
-  ///
-  /// Also, note that the scope of the lookup is the current ABI
-  /// corpus.
+  /// Compute the key under which the name of a given DIE is memoized
+  /// by lookup_die_name_memo() and memoize_die_name().
   ///
   /// @param die the DIE to consider.
   ///
   /// @param where_offset where in the DIE stream we logically are.
   ///
-  /// @return the type artifact found.
-  type_or_decl_base_sptr
-  lookup_type_artifact_from_die(Dwarf_Die *die) const
+  /// @return the key of the name of @p die.
+  die_name_memo_key
+  get_die_name_memo_key(const Dwarf_Die *die, size_t where_offset) const
   {
-    type_or_decl_base_sptr artifact =
-      lookup_artifact_from_die(die, /*type_as_die=*/true);
-    if (function_decl_sptr fn = is_function_decl(artifact))
-      return fn->get_type();
-    return artifact;
+    translation_unit::language lang = translation_unit::LANG_UNKNOWN;
+    if (cur_transl_unit())
+      lang = cur_transl_unit()->get_language();
+
+    Dwarf_Off tu_offset = 0;
+    size_t where_class = 0;
+    if (cur_tu_die())
+      {
+	const tu_die_imported_unit_points_map_type& m =
+	  tu_die_imported_unit_points_map(PRIMARY_DEBUG_INFO_DIE_SOURCE);
+	Dwarf_Off o = dwarf_dieoffset(const_cast<Dwarf_Die*>(cur_tu_die()));
+	tu_die_imported_unit_points_map_type::const_iterator i = m.find(o);
+	if (i != m.end() && !i->second.empty())
+	  {
+	    // This is the lower bound that
+	    // find_import_unit_point_between_dies() computes from
+	    // where_offset.
+	    tu_offset = o;
+	    if (where_offset)
+	      where_class =
+		1 + (std::lower_bound(i->second.begin(), i->second.end(),
+				      imported_unit_point(where_offset))
+		     - i->second.begin());
+	  }
+      }
+
+    return die_name_memo_key(dwarf_dieoffset(const_cast<Dwarf_Die*>(die)),
+			     tu_offset, where_class, lang);
   }
 
-  /// Lookup the artifact that was built to represent a type or a
-  /// declaration that has the same pretty representation as the type
-  /// denoted by a given DIE.
-  ///
-  /// Note that the DIE must have previously been associated with the
-  /// artifact using the functions associate_die_to_decl or
-  /// associate_die_to_type.
+  /// Lookup the memoized name of a given DIE.
   ///
-  /// Also, note that the scope of the lookup is the current ABI
-  /// corpus.
+  /// @param kind the kind of name to look for.
   ///
   /// @param die the DIE to consider.
   ///
-  /// @param where_offset where in the DIE stream we logically are.
+  /// @param key the key of the name of @p die, as returned by
+  /// get_die_name_memo_key().
   ///
-  /// @param die_as_type if true, it means the DIE is to be considered
-  /// as a type.
+  /// @param name output parameter.  This is set to the name found, iff
+  /// the function returns true.
   ///
-  /// @return the artifact found.
-  type_or_decl_base_sptr
-  lookup_artifact_from_die(const Dwarf_Die *die, bool die_as_type = false) const
+  /// @return true iff the name of @p die was memoized.
+  bool
+  lookup_die_name_memo(die_name_kind		kind,
+		       const Dwarf_Die		*die,
+		       const die_name_memo_key&	key,
+		       string&			name) const
   {
-    Dwarf_Die equiv_die;
-    if (!get_or_compute_canonical_die(die, equiv_die, /*where=*/0, die_as_type))
-      return type_or_decl_base_sptr();
-
-    const die_artefact_map_type& m =
-      die_as_type
-      ? type_die_artefact_maps().get_container(*this, &equiv_die)
-      : decl_die_artefact_maps().get_container(*this, &equiv_die);
-
-    size_t die_offset = dwarf_dieoffset(&equiv_die);
-    die_artefact_map_type::const_iterator i = m.find(die_offset);
-
+    const die_name_memo_map_type& m =
+      die_name_memo_maps_[kind].get_container(*this, die);
+    die_name_memo_map_type::const_iterator i = m.find(key);
     if (i == m.end())
-      return type_or_decl_base_sptr();
-    return i->second;
+      {
+	++num_die_name_memo_misses_[kind];
+	return false;
+      }
+    ++num_die_name_memo_hits_[kind];
+    name = i->second;
+    return true;
+  }
+
+  /// Memoize the name of a given DIE.
+  ///
+  /// @param kind the kind of name to memoize.
+  ///
+  /// @param die the DIE to consider.
+  ///
+  /// @param key the key of the name of @p die, as returned by
+  /// get_die_name_memo_key().
+  ///
+  /// @param name the name to memoize.
+  void
+  memoize_die_name(die_name_kind		kind,
+		   const Dwarf_Die		*die,
+		   const die_name_memo_key&	key,
+		   const string&		name) const
+  {
+    die_name_memo_maps_[kind].get_container(*this, die)[key] =
+      env()->intern(name);
+  }
+
+  /// Getter of the statistics about the memoization of a given kind
+  /// of DIE names.
+  ///
+  /// @param kind the kind of names to consider.
+  ///
+  /// @param hits output parameter.  This is set to the number of
+  /// names that were found memoized.
+  ///
+  /// @param misses output parameter.  This is set to the number of
+  /// names that had to be computed.
+  void
+  get_die_name_memo_stats(die_name_kind kind,
+			  size_t& hits,
+			  size_t& misses) const
+  {
+    hits = num_die_name_memo_hits_[kind];
+    misses = num_die_name_memo_misses_[kind];
+  }
+
+  /// Get the structural hash of a given DIE.
+  ///
+  /// The hash is computed by compute_die_structural_hash the first
+  /// time it's requested for a DIE, and is cached afterwards.
+  ///
+  /// @param die the DIE to consider.
+  ///
+  /// @return the structural hash of @p die.
+  uint64_t
+  get_die_structural_hash(const Dwarf_Die* die) const
+  {
+    offset_hash_map_type& m =
+      die_structural_hashes_.get_container(*this, die);
+    Dwarf_Off offset = dwarf_dieoffset(const_cast<Dwarf_Die*>(die));
+    offset_hash_map_type::const_iterator i = m.find(offset);
+    if (i != m.end())
+      {
+	++num_die_structural_hash_hits_;
+	return i->second;
+      }
+    ++num_die_structural_hash_misses_;
+    uint64_t h = compute_die_structural_hash(*this, die);
+    m[offset] = h;
+    return h;
+  }
+
+  /// Test if a DIE might be equal to a candidate canonical DIE.
+  ///
+  /// This compares the structural hashes of the two DIEs.  If they
+  /// are different, then the DIEs are different and there is no need
+  /// to compare them with compare_dies.
+  ///
+  /// Note that if the two DIEs already have canonical DIEs (that
+  /// might have been propagated to them while comparing other DIEs)
+  /// then compare_dies just compares their canonical DIEs.  In that
+  /// case, the structural hashes are not used.
+  ///
+  /// @param die the DIE to consider.
+  ///
+  /// @param candidate the candidate canonical DIE to consider.
+  ///
+  /// @return false iff @p die and @p candidate are different.
+  bool
+  die_might_equal_canonical_candidate(const Dwarf_Die* die,
+				      const Dwarf_Die* candidate) const
+  {
+    if (get_die_structural_hash(die) != get_die_structural_hash(candidate)
+	&& !(get_canonical_die_offset(dwarf_dieoffset
+				      (const_cast<Dwarf_Die*>(die)),
+				      get_die_source(die),
+				      /*die_as_type=*/true)
+	     && get_canonical_die_offset(dwarf_dieoffset
+					 (const_cast<Dwarf_Die*>(candidate)),
+					 get_die_source(candidate),
+					 /*die_as_type=*/true)))
+      {
+	++num_die_comparisons_avoided_;
+	return false;
+      }
+    ++num_die_comparisons_performed_;
+    return true;
+  }
+
+  /// Add the memory footprint of a map to a set of memory
+  /// statistics.
+  ///
+  /// The entries of the map are counted with their shallow size: the
+  /// memory owned by their values, like the characters of strings, is
+  /// not accounted for.
+  ///
+  /// @param m the map to consider.  Its entries are counted.
+  ///
+  /// @param kind the name under which the map is reported.
+  ///
+  /// @param stats the statistics to add the map to.
+  template<typename MapType>
+  static void
+  add_map_memory_stats(const MapType& m,
+		       const char* kind,
+		       memory_stats_type& stats)
+  {
+    add_memory_stats(stats, kind, m.size(),
+		     m.bucket_count() * sizeof(void*)
+		     + m.size() * (sizeof(typename MapType::value_type)
+				   + sizeof(void*)),
+		     /*shallow=*/true);
+  }
+
+  /// Add the memory footprint of a set of maps (one per kind of die
+  /// source) to a set of memory statistics.
+  ///
+  /// @param maps the set of maps to consider.
+  ///
+  /// @param kind the name under which the maps are reported.
+  ///
+  /// @param stats the statistics to add the maps to.
+  template<typename MapType>
+  static void
+  add_map_memory_stats
+  (const die_source_dependant_container_set<MapType>& maps,
+   const char* kind,
+   memory_stats_type& stats)
+  {
+    for (die_source source = PRIMARY_DEBUG_INFO_DIE_SOURCE;
+	 source < NUMBER_OF_DIE_SOURCES;
+	 ++source)
+      add_map_memory_stats(maps.get_container(source), kind, stats);
+  }
+
+  /// Get statistics about the memory used by the maps of the current
+  /// context.
+  ///
+  /// @param stats the statistics to add the ones of the maps of the
+  /// current context to.
+  void
+  get_memory_stats(memory_stats_type& stats) const
+  {
+    add_map_memory_stats(primary_die_parent_map_,
+			 "DWARF DIE parent maps", stats);
+    add_map_memory_stats(alternate_die_parent_map_,
+			 "DWARF DIE parent maps", stats);
+    add_map_memory_stats(type_section_die_parent_map_,
+			 "DWARF DIE parent maps", stats);
+
+    add_map_memory_stats(decl_die_repr_die_offsets_maps_,
+			 "DWARF DIE representation maps", stats);
+    add_map_memory_stats(type_die_repr_die_offsets_maps_,
+			 "DWARF DIE representation maps", stats);
+
+    add_map_memory_stats(die_qualified_name_maps_,
+			 "DWARF DIE name caches", stats);
+    add_map_memory_stats(die_pretty_repr_maps_,
+			 "DWARF DIE name caches", stats);
+    add_map_memory_stats(die_pretty_type_repr_maps_,
+			 "DWARF DIE name caches", stats);
+    for (int k = 0; k < NUMBER_OF_DIE_NAME_KINDS; ++k)
+      add_map_memory_stats(die_name_memo_maps_[k],
+			   "DWARF DIE name caches", stats);
+
+    add_map_memory_stats(decl_die_artefact_maps_,
+			 "DWARF DIE artifact maps", stats);
+    add_map_memory_stats(type_die_artefact_maps_,
+			 "DWARF DIE artifact maps", stats);
+
+    add_map_memory_stats(canonical_type_die_offsets_,
+			 "DWARF canonical DIE maps", stats);
+    add_map_memory_stats(canonical_decl_die_offsets_,
+			 "DWARF canonical DIE maps", stats);
+    add_map_memory_stats(die_structural_hashes_,
+			 "DWARF canonical DIE maps", stats);
+
+    add_map_memory_stats(die_tu_map_,
+			 "DWARF DIE translation unit map", stats);
+
+    if (fun_addr_sym_map_)
+      add_map_memory_stats(*fun_addr_sym_map_,
+			   "DWARF ELF symbol maps", stats);
+    if (fun_entry_addr_sym_map_)
+      add_map_memory_stats(*fun_entry_addr_sym_map_,
+			   "DWARF ELF symbol maps", stats);
+    if (var_addr_sym_map_)
+      add_map_memory_stats(*var_addr_sym_map_,
+			   "DWARF ELF symbol maps", stats);
+  }
+
+  /// Lookup the artifact that was built to represent a type that has
+  /// the same pretty representation as the type denoted by a given
+  /// DIE.
+  ///
+  /// Note that the DIE must have previously been associated with the
+  /// artifact using the functions associate_die_to_decl or
+  /// associate_die_to_type.
+  ///
+  /// Also, note that the scope of the lookup is the current ABI
+  /// corpus.
+  ///
+  /// @param die the DIE to consider.
+  ///
+  /// @param where_offset where in the DIE stream we logically are.
+  ///
+  /// @return the type artifact found.
+  type_or_decl_base_sptr
+  lookup_type_artifact_from_die(Dwarf_Die *die) const
+  {
+    type_or_decl_base_sptr artifact =
+      lookup_artifact_from_die(die, /*type_as_die=*/true);
+    if (function_decl_sptr fn = is_function_decl(artifact))
+      return fn->get_type();
+    return artifact;
+  }
+
+  /// Lookup the artifact that was built to represent a type or a
+  /// declaration that has the same pretty representation as the type
+  /// denoted by a given DIE.
+  ///
+  /// Note that the DIE must have previously been associated with the
+  /// artifact using the functions associate_die_to_decl or
+  /// associate_die_to_type.
+  ///
+  /// Also, note that the scope of the lookup is the current ABI
+  /// corpus.
+  ///
+  /// @param die the DIE to consider.
+  ///
+  /// @param where_offset where in the DIE stream we logically are.
+  ///
+  /// @param die_as_type if true, it means the DIE is to be considered
+  /// as a type.
+  ///
+  /// @return the artifact found.
+  type_or_decl_base_sptr
+  lookup_artifact_from_die(const Dwarf_Die *die, bool die_as_type = false) const
+  {
+    Dwarf_Die equiv_die;
+    if (!get_or_compute_canonical_die(die, equiv_die, /*where=*/0, die_as_type))
+      return type_or_decl_base_sptr();
+
+    const die_artefact_map_type& m =
+      die_as_type
+      ? type_die_artefact_maps().get_container(*this, &equiv_die)
+      : decl_die_artefact_maps().get_container(*this, &equiv_die);
+
+    size_t die_offset = dwarf_dieoffset(&equiv_die);
+    die_artefact_map_type::const_iterator i = m.find(die_offset);
+
+    if (i == m.end())
+      return type_or_decl_base_sptr();
+    return i->second;
   }
 
   /// Lookup the artifact that was built to represent a type or a
@@ -4814,6 +5537,16 @@ public:
 	size_t total = types_to_canonicalize(source).size();
 	if (do_log())
 	  cerr << total << " types to canonicalize\n";
+	// Note that the types are canonicalized sequentially, in the
+	// order in which they were scheduled, even when several
+	// threads are used to read the debug info.  Canonicalizing a
+	// type compares it structurally against the canonical types
+	// of the environment.  That comparison canonicalizes
+	// sub-types on the fly and marks the classes and function
+	// types being compared in the environment; none of that is
+	// thread safe.  Also, the order in which the types are
+	// canonicalized determines which type, among a set of equal
+	// types, becomes their canonical type.
 	for (size_t i = 0; i < total; ++i)
 	  {
 	    Dwarf_Off element = types_to_canonicalize(source)[i];
@@ -4967,6 +5700,47 @@ public:
         if (total)
           cerr << " (" << num_missed * 100 / total << "%)";
         cerr << "\n";
+
+	size_t num_buckets = 0, num_canonical_types = 0, longest_bucket = 0,
+	  num_deep_comparisons = 0, num_avoided_comparisons = 0;
+	env()->get_canonical_types_stats(num_buckets, num_canonical_types,
+					 longest_bucket, num_deep_comparisons,
+					 num_avoided_comparisons);
+	cerr << "    # canonical types: " << num_canonical_types
+	     << " in " << num_buckets << " buckets"
+	     << " (longest bucket: " << longest_bucket << ")\n"
+	     << "    # structural type comparisons: "
+	     << num_deep_comparisons
+	     << " (" << num_avoided_comparisons
+	     << " avoided thanks to type hashes)\n";
+
+	static const char* die_name_kind_names[NUMBER_OF_DIE_NAME_KINDS] =
+	  {"DIE qualified type names",
+	   "DIE qualified decl names",
+	   "DIE pretty type representations"};
+	for (int k = 0; k < NUMBER_OF_DIE_NAME_KINDS; ++k)
+	  {
+	    size_t hits = 0, misses = 0;
+	    get_die_name_memo_stats(static_cast<die_name_kind>(k),
+				    hits, misses);
+	    cerr << "    # " << die_name_kind_names[k] << " computed: "
+		 << misses << ", reused: " << hits;
+	    if (hits + misses)
+	      cerr << " (" << hits * 100 / (hits + misses) << "% hit rate)";
+	    cerr << "\n";
+	  }
+
+	size_t hits = num_die_structural_hash_hits_,
+	  misses = num_die_structural_hash_misses_;
+	cerr << "    # DIE structural hashes computed: "
+	     << misses << ", reused: " << hits;
+	if (hits + misses)
+	  cerr << " (" << hits * 100 / (hits + misses) << "% hit rate)";
+	cerr << "\n"
+	     << "    # canonical DIE candidates compared: "
+	     << num_die_comparisons_performed_
+	     << " (" << num_die_comparisons_avoided_
+	     << " rejected thanks to DIE structural hashes)\n";
       }
 
   }
@@ -5255,6 +6029,25 @@ public:
     return symtab_section_;
   }
 
+  /// Getter of the index of the symbols of the symbol table of the
+  /// current ELF file.
+  ///
+  /// The index is built the first time this function is invoked.  It
+  /// is then shared by all the lookups of symbols from the symbol
+  /// table.
+  ///
+  /// @return the index of the symbol table, or nil if the ELF file
+  /// has no symbol table.
+  const elf_symbol_index_sptr&
+  get_symbol_index() const
+  {
+    if (!symbol_index_)
+      if (Elf_Scn* symtab_section = find_symbol_table_section())
+	symbol_index_.reset(new elf_symbol_index(env(), elf_handle(),
+						 symtab_section));
+    return symbol_index_;
+  }
+
   /// Return the "Official Procedure descriptors section."  This
   /// section is named .opd, and is usually present only on PPC64
   /// ELFv1 binaries.
@@ -5426,48 +6219,7 @@ public:
     if (!lookup_native_elf_symbol_from_index(symbol_index, native_sym))
       return elf_symbol_sptr();
 
-    Elf_Scn* symtab_section = find_symbol_table_section();
-    if (!symtab_section)
-      return elf_symbol_sptr();
-
-    GElf_Shdr header_mem;
-    GElf_Shdr* symtab_sheader = gelf_getshdr(symtab_section,
-					     &header_mem);
-
-    Elf_Data* symtab = elf_getdata(symtab_section, 0);
-    ABG_ASSERT(symtab);
-
-    bool sym_is_defined = native_sym.st_shndx != SHN_UNDEF;
-    bool sym_is_common = native_sym.st_shndx == SHN_COMMON; // this occurs in
-							    // relocatable
-							    // files.
-    const char* name_str = elf_strptr(elf_handle(),
-				      symtab_sheader->sh_link,
-				      native_sym.st_name);
-    if (name_str == 0)
-      name_str = "";
-
-    elf_symbol::version ver;
-    elf_helpers::get_version_for_symbol(elf_handle(), symbol_index,
-					sym_is_defined, ver);
-
-    elf_symbol::visibility vis =
-      stv_to_elf_symbol_visibility(GELF_ST_VISIBILITY(native_sym.st_other));
-
-    Elf_Scn *strings_section = find_ksymtab_strings_section();
-    size_t strings_ndx = strings_section
-      ? elf_ndxscn(strings_section)
-      : 0;
-
-    elf_symbol_sptr sym =
-      elf_symbol::create(env(), symbol_index, native_sym.st_size,
-			 name_str, stt_to_elf_symbol_type
-			 (GELF_ST_TYPE(native_sym.st_info)),
-			 stb_to_elf_symbol_binding
-			 (GELF_ST_BIND(native_sym.st_info)),
-			 sym_is_defined, sym_is_common, ver, vis,
-			 native_sym.st_shndx == strings_ndx);
-    return sym;
+    return get_symbol_index()->create_symbol(symbol_index, native_sym);
   }
 
   /// Read 8 bytes and convert their value into an uint64_t.
@@ -7611,98 +8363,467 @@ public:
   do_log(bool f)
   {options_.do_log = f;}
 
-  /// If a given function decl is suitable for the set of exported
-  /// functions of the current corpus, this function adds it to that
-  /// set.
+  /// Getter of the number of threads used to read the debug info.
   ///
-  /// @param fn the function to consider for inclusion into the set of
-  /// exported functions of the current corpus.
+  /// @return the number of threads used to read the debug info.
+  size_t
+  num_threads() const
+  {return options_.num_threads;}
+
+  /// Setter of the number of threads used to read the debug info.
+  ///
+  /// If this number is greater than one, the parts of the reading
+  /// that can be performed per unit independently from the rest of
+  /// the read are spread over that many worker threads.
+  ///
+  /// @param n the new number of threads.  Zero means one.
   void
-  maybe_add_fn_to_exported_decls(function_decl* fn)
-  {
-    if (fn)
-      if (corpus::exported_decls_builder* b = exported_decls_builder())
-	b->maybe_add_fn_to_exported_fns(fn);
-  }
+  num_threads(size_t n)
+  {options_.num_threads = n ? n : 1;}
 
-  /// If a given variable decl is suitable for the set of exported
-  /// variables of the current corpus, this variable adds it to that
-  /// set.
+  /// Getter of the directory of the corpus cache.
   ///
-  /// @param fn the variable to consider for inclusion into the set of
-  /// exported variables of the current corpus.
+  /// @return the path to the directory of the corpus cache, or an
+  /// empty string if no corpus cache is used.
+  const string&
+  corpus_cache_dir() const
+  {return options_.corpus_cache_dir;}
+
+  /// Setter of the directory of the corpus cache.
+  ///
+  /// @param d the path to the directory of the corpus cache.  An
+  /// empty string means that no corpus cache is used.
   void
-  maybe_add_var_to_exported_decls(var_decl* var)
+  corpus_cache_dir(const string& d)
+  {options_.corpus_cache_dir = d;}
+
+  /// Test if the hashes of the content of the translation units are
+  /// to be computed.
+  ///
+  /// They are computed if they were asked for, or if there are
+  /// baseline hashes to compare them to.
+  ///
+  /// @return true iff the hashes of the content of the translation
+  /// units are to be computed.
+  bool
+  compute_tu_hashes() const
   {
-    if (var)
-      if (corpus::exported_decls_builder* b = exported_decls_builder())
-	b->maybe_add_var_to_exported_vars(var);
+    return (options_.compute_tu_hashes
+	    || !options_.baseline_tu_hashes.empty());
   }
 
-  /// Walk the DIEs under a given die and for each child, populate the
-  /// die -> parent map to record the child -> parent relationship
-  /// that
-  /// exists between the child and the given die.
+  /// Setter of the flag saying if the hashes of the content of the
+  /// translation units are to be computed.
   ///
-  /// The function also builds the vector of places where units are
-  /// imported.
+  /// @param f the new value of the flag.
+  void
+  compute_tu_hashes(bool f)
+  {options_.compute_tu_hashes = f;}
+
+  /// Getter of the hashes of the content of the translation units of
+  /// a baseline corpus.
   ///
-  /// This is done recursively as for each child DIE, this function
-  /// walks its children as well.
+  /// The IR of the translation units which content has the same hash
+  /// as in the baseline is not built.
   ///
-  /// @param die the DIE whose children to walk recursively.
+  /// @return the hashes of the translation units of the baseline.
+  const translation_unit_hashes_type&
+  baseline_tu_hashes() const
+  {return options_.baseline_tu_hashes;}
+
+  /// Setter of the hashes of the content of the translation units of
+  /// a baseline corpus.
   ///
-  /// @param source where the DIE @p die comes from.
+  /// @param h the hashes of the translation units of the baseline.
+  void
+  baseline_tu_hashes(const translation_unit_hashes_type& h)
+  {options_.baseline_tu_hashes = h;}
+
+  /// Getter of the hashes of the content of the translation units of
+  /// the current corpus.
+  ///
+  /// @return the hashes of the content of the translation units of
+  /// the current corpus, indexed by the absolute path of the
+  /// translation units.
+  translation_unit_hashes_type&
+  tu_hashes()
+  {return tu_hashes_;}
+
+  /// Getter of the translation units of the current corpus which IR
+  /// was not built because their content has the same hash as in the
+  /// baseline.
+  ///
+  /// @return the absolute paths of the skipped translation units.
+  const translation_unit_paths_type&
+  skipped_tus() const
+  {return skipped_tus_;}
+
+  /// Getter of the translation units of the current corpus which IR
+  /// was not built because their content has the same hash as in the
+  /// baseline.
+  ///
+  /// @return the absolute paths of the skipped translation units.
+  translation_unit_paths_type&
+  skipped_tus()
+  {return skipped_tus_;}
+
+  /// Record the time spent in a phase of the construction of a
+  /// corpus.
   ///
-  /// @param imported_units a vector containing all the offsets of the
-  /// points where unit have been imported, under @p die.
+  /// If time was already recorded for that phase (e.g, while
+  /// building a previous corpus with the current context), the new
+  /// time is added to it.
+  ///
+  /// @param phase the name of the phase.
+  ///
+  /// @param t the timer that measured the time spent in the phase.
   void
-  build_die_parent_relations_under(Dwarf_Die*			die,
-				   die_source			source,
-				   imported_unit_points_type &	imported_units)
+  record_phase_time(const char* phase, const tools_utils::timer& t)
   {
-    if (!die)
-      return;
+    size_t ms = t.value_in_milliseconds();
+    for (phase_timings_type::iterator i = phase_timings_.begin();
+	 i != phase_timings_.end();
+	 ++i)
+      if (i->first == phase)
+	{
+	  i->second += ms;
+	  return;
+	}
+    phase_timings_.push_back(std::make_pair(string(phase), ms));
+  }
 
-    offset_offset_map_type& parent_of = die_parent_map(source);
+  /// Getter of the times spent in the phases of the construction of
+  /// the corpora built with the current context.
+  ///
+  /// @return the times spent per phase, in the order in which the
+  /// phases were first entered.
+  const phase_timings_type&
+  phase_timings() const
+  {return phase_timings_;}
 
-    Dwarf_Die child;
-    if (dwarf_child(die, &child) != 0)
-      return;
+  /// Getter of the number of corpora that were found in the corpus
+  /// cache.
+  ///
+  /// @return the number of corpus cache hits.
+  size_t
+  num_corpus_cache_hits() const
+  {return num_corpus_cache_hits_;}
 
-    do
+  /// Getter of the number of corpora that were looked up in the
+  /// corpus cache but were not found there.
+  ///
+  /// @return the number of corpus cache misses.
+  size_t
+  num_corpus_cache_misses() const
+  {return num_corpus_cache_misses_;}
+
+  /// Get the corpus of the current binary from the corpus cache.
+  ///
+  /// If the corpus is not in the cache yet, it's built from the debug
+  /// info in a private environment, saved into the cache, and then
+  /// read back from there.  Note that the corpus can't be saved into
+  /// the cache directly from the environment of the current context
+  /// because that environment might already contain types of other
+  /// corpora; the abixml writer would then fail to emit the types of
+  /// the current corpus which canonical types belong to those other
+  /// corpora.  Reading the cached corpus back also ensures that the
+  /// resulting corpus is the same, whether it was in the cache or
+  /// not.
+  ///
+  /// @param path the path to the file of the cache that contains the
+  /// corpus.
+  ///
+  /// @return the corpus read from the cache, or nil if it couldn't be
+  /// read from the cache.
+  corpus_sptr
+  read_corpus_from_cache(const string& path)
+  {
+    corpus_sptr corp = load_corpus_from_cache(path);
+    if (corp)
       {
-	parent_of[dwarf_dieoffset(&child)] = dwarf_dieoffset(die);
-	if (dwarf_tag(&child) == DW_TAG_imported_unit)
-	  {
-	    Dwarf_Die imported_unit;
-	    if (die_die_attribute(&child, DW_AT_import, imported_unit))
-	      {
-		die_source imported_unit_die_source = NO_DEBUG_INFO_DIE_SOURCE;
-		ABG_ASSERT(get_die_source(imported_unit, imported_unit_die_source));
-		imported_units.push_back
-		  (imported_unit_point(dwarf_dieoffset(&child),
-				       imported_unit,
-				       imported_unit_die_source));
-	      }
-	  }
-	build_die_parent_relations_under(&child, source, imported_units);
+	++num_corpus_cache_hits_;
+	if (show_stats())
+	  cerr << "corpus cache hit for " << elf_path()
+	       << " (" << path << ")\n";
+	return corp;
       }
-    while (dwarf_siblingof(&child, &child) == 0);
 
+    ++num_corpus_cache_misses_;
+    if (show_stats())
+      cerr << "corpus cache miss for " << elf_path() << "\n";
+
+    if (save_corpus_to_cache(path))
+      corp = load_corpus_from_cache(path);
+    return corp;
   }
 
-  /// Determine if we do have to build a DIE -> parent map, depending
-  /// on a given language.
+  /// Read a corpus from a file of the corpus cache and make it the
+  /// corpus of the current binary.
   ///
-  /// Some languages like C++, Ada etc, do have the concept of
-  /// namespace and yet, the DIE data structure doesn't provide us
-  /// with a way to get the parent namespace of a given DIE.  So for
-  /// those languages, we need to build a DIE -> parent map so that we
-  /// can get the namespace DIE (or more generally the scope DIE) of a given
-  /// DIE as we need it.
+  /// @param path the path to the file of the cache to read.
   ///
-  /// But then some more basic languages like C or assembly don't have
+  /// @return the resulting corpus or nil if the file couldn't be read.
+  corpus_sptr
+  load_corpus_from_cache(const string& path)
+  {
+    corpus_sptr corp;
+    if (tools_utils::file_exists(path))
+      corp = xml_reader::read_corpus_from_native_xml_file(path, env());
+    if (!corp)
+      return corp;
+
+    corp->set_path(elf_path());
+    if (is_linux_kernel(elf_handle()))
+      corp->set_origin(corpus::LINUX_KERNEL_BINARY_ORIGIN);
+    else
+      corp->set_origin(corpus::DWARF_ORIGIN);
+    current_corpus(corp);
+    return corp;
+  }
+
+  /// Compute the key of the corpus of the current binary in the
+  /// corpus cache.
+  ///
+  /// The key is made of the version of libabigail and of the options
+  /// of the context that have an impact on the corpus built from the
+  /// debug info.  The other inputs of the construction of the corpus
+  /// that have such an impact can't be part of a key: the suppression
+  /// specifications that drop ABI artifacts from the IR, the KMI white
+  /// list, the symbols of interest, the corpus group the corpus is to
+  /// be added to and the computation of the hashes of translation
+  /// units.  So the corpus is cached only if all of them are at their
+  /// default values.
+  ///
+  /// Note that an option of the context that has an impact on the
+  /// corpus must either be added to the key or make the corpus
+  /// uncacheable when it's not at its default value.  Otherwise
+  /// corpora built with different values of the option would share the
+  /// same entry of the cache.
+  ///
+  /// @param key output parameter.  This is set to the key of the
+  /// corpus if the function returns true.
+  ///
+  /// @return true iff the corpus of the current binary can be cached.
+  bool
+  get_corpus_cache_key(string& key) const
+  {
+    for (suppr::suppressions_type::const_iterator i = supprs_.begin();
+	 i != supprs_.end();
+	 ++i)
+      if ((*i)->get_drops_artifact_from_ir())
+	return false;
+
+    if (kabi_whitelist()
+	|| function_symbols_of_interest()
+	|| variable_symbols_of_interest()
+	|| current_corpus_group()
+	|| compute_tu_hashes())
+      return false;
+
+    string major, minor, revision, suffix;
+    abigail_get_library_version(major, minor, revision, suffix);
+    std::ostringstream o;
+    o << major << "." << minor << "." << revision << suffix
+      << ":load-all-types=" << options_.load_all_types
+      << ":linux-kernel-mode=" << options_.load_in_linux_kernel_mode
+      << ":ignore-symbol-table=" << options_.ignore_symbol_table
+      << ":drop-undefined-syms=" << drop_undefined_syms();
+    key = o.str();
+    return true;
+  }
+
+  /// Get the mode the files created by the current process have when
+  /// they are created with all the permission bits set.
+  ///
+  /// This is the complement of the umask of the process.  It's read
+  /// from /proc rather than from umask(2), as the latter can only get
+  /// the umask by changing it, which would race with other threads
+  /// creating files.
+  ///
+  /// @return the mode of the files created by the current process.
+  static mode_t
+  get_file_creation_mode()
+  {
+    mode_t mask = 022;
+    std::ifstream status("/proc/self/status");
+    string line;
+    bool found = false;
+    while (std::getline(status, line))
+      if (line.compare(0, 6, "Umask:") == 0)
+	{
+	  mask = strtoul(line.c_str() + 6, 0, 8);
+	  found = true;
+	  break;
+	}
+    if (!found)
+      {
+	mask = umask(022);
+	umask(mask);
+      }
+    return 0666 & ~mask;
+  }
+
+  /// Build the corpus of the current binary from its debug info and
+  /// save it into the corpus cache.
+  ///
+  /// The corpus is built in a private environment using a private
+  /// read context that has the same options as the current one.  It's
+  /// first written into a temporary file of the directory of the
+  /// cache, which is then renamed.  That way, concurrent readers of
+  /// the cache never see a partially written corpus.  The file is
+  /// given the mode of the files created by the process, so that a
+  /// cache directory can be shared by several users.
+  ///
+  /// @param path the path to the file of the cache that is to contain
+  /// the corpus.
+  ///
+  /// @return true iff the corpus was saved into the cache.
+  bool
+  save_corpus_to_cache(const string& path)
+  {
+    if (!tools_utils::ensure_dir_path_created(corpus_cache_dir()))
+      return false;
+
+    environment cache_env;
+    read_context_sptr c = create_read_context(elf_path(),
+					      debug_info_root_paths_,
+					      &cache_env,
+					      load_all_types(),
+					      load_in_linux_kernel_mode());
+    c->options_ = options_;
+    c->options_.env = &cache_env;
+    // The private context must not look the corpus up in the cache
+    // again.
+    c->options_.corpus_cache_dir.clear();
+    c->drop_undefined_syms(drop_undefined_syms());
+
+    status s = STATUS_UNKNOWN;
+    corpus_sptr corp = dwarf_reader::read_corpus_from_elf(*c, s);
+    if (!corp || !(s & STATUS_OK))
+      return false;
+
+    string tmp_path = path + ".XXXXXX";
+    vector<char> tmp_path_buf(tmp_path.begin(), tmp_path.end());
+    tmp_path_buf.push_back('\0');
+    int fd = mkstemp(&tmp_path_buf[0]);
+    if (fd < 0)
+      return false;
+    tmp_path = &tmp_path_buf[0];
+    // mkstemp creates the file with the 0600 mode, whatever the umask.
+    if (fchmod(fd, get_file_creation_mode()))
+      {
+	close(fd);
+	unlink(tmp_path.c_str());
+	return false;
+      }
+    close(fd);
+
+    std::ofstream of(tmp_path.c_str(), std::ios_base::trunc);
+    xml_writer::write_context_sptr write_ctxt =
+      xml_writer::create_write_context(&cache_env, of);
+    bool is_ok = xml_writer::write_corpus(*write_ctxt, corp, 0);
+    of.close();
+
+    if (!is_ok || of.fail() || rename(tmp_path.c_str(), path.c_str()))
+      {
+	unlink(tmp_path.c_str());
+	return false;
+      }
+    return true;
+  }
+
+  /// If a given function decl is suitable for the set of exported
+  /// functions of the current corpus, this function adds it to that
+  /// set.
+  ///
+  /// @param fn the function to consider for inclusion into the set of
+  /// exported functions of the current corpus.
+  void
+  maybe_add_fn_to_exported_decls(function_decl* fn)
+  {
+    if (fn)
+      if (corpus::exported_decls_builder* b = exported_decls_builder())
+	b->maybe_add_fn_to_exported_fns(fn);
+  }
+
+  /// If a given variable decl is suitable for the set of exported
+  /// variables of the current corpus, this variable adds it to that
+  /// set.
+  ///
+  /// @param fn the variable to consider for inclusion into the set of
+  /// exported variables of the current corpus.
+  void
+  maybe_add_var_to_exported_decls(var_decl* var)
+  {
+    if (var)
+      if (corpus::exported_decls_builder* b = exported_decls_builder())
+	b->maybe_add_var_to_exported_vars(var);
+  }
+
+  /// Walk the DIEs under a given die and for each child, populate the
+  /// die -> parent map to record the child -> parent relationship
+  /// that
+  /// exists between the child and the given die.
+  ///
+  /// The function also builds the vector of places where units are
+  /// imported.
+  ///
+  /// This is done recursively as for each child DIE, this function
+  /// walks its children as well.
+  ///
+  /// @param die the DIE whose children to walk recursively.
+  ///
+  /// @param source where the DIE @p die comes from.
+  ///
+  /// @param imported_units a vector containing all the offsets of the
+  /// points where unit have been imported, under @p die.
+  void
+  build_die_parent_relations_under(Dwarf_Die*			die,
+				   die_source			source,
+				   imported_unit_points_type &	imported_units)
+  {
+    if (!die)
+      return;
+
+    offset_offset_map_type& parent_of = die_parent_map(source);
+
+    Dwarf_Die child;
+    if (dwarf_child(die, &child) != 0)
+      return;
+
+    do
+      {
+	parent_of[dwarf_dieoffset(&child)] = dwarf_dieoffset(die);
+	if (dwarf_tag(&child) == DW_TAG_imported_unit)
+	  {
+	    Dwarf_Die imported_unit;
+	    if (die_die_attribute(&child, DW_AT_import, imported_unit))
+	      {
+		die_source imported_unit_die_source = NO_DEBUG_INFO_DIE_SOURCE;
+		ABG_ASSERT(get_die_source(imported_unit, imported_unit_die_source));
+		imported_units.push_back
+		  (imported_unit_point(dwarf_dieoffset(&child),
+				       imported_unit,
+				       imported_unit_die_source));
+	      }
+	  }
+	build_die_parent_relations_under(&child, source, imported_units);
+      }
+    while (dwarf_siblingof(&child, &child) == 0);
+
+  }
+
+  /// Determine if we do have to build a DIE -> parent map, depending
+  /// on a given language.
+  ///
+  /// Some languages like C++, Ada etc, do have the concept of
+  /// namespace and yet, the DIE data structure doesn't provide us
+  /// with a way to get the parent namespace of a given DIE.  So for
+  /// those languages, we need to build a DIE -> parent map so that we
+  /// can get the namespace DIE (or more generally the scope DIE) of a given
+  /// DIE as we need it.
+  ///
+  /// But then some more basic languages like C or assembly don't have
   /// that need.
   ///
   /// This function, depending on the language, tells us if we need to
@@ -7778,6 +8899,9 @@ public:
     if (!we_do_have_to_build_die_parent_map)
       return;
 
+    if (num_threads() > 1 && build_die_parent_maps_concurrently())
+      return;
+
     // Build the DIE -> parent relation for DIEs coming from the
     // .debug_info section in the alternate debug info file.
     die_source source = ALT_DEBUG_INFO_DIE_SOURCE;
@@ -7844,6 +8968,116 @@ public:
 	build_die_parent_relations_under(&cu, source, imported_units);
       }
   }
+
+  /// Collect the offsets of the DIEs of the units that
+  /// build_die_parent_maps() walks, in the order it walks them.
+  ///
+  /// @param units output parameter.  The offsets collected.
+  void
+  collect_unit_die_offsets(unit_die_offsets_type& units) const
+  {
+    size_t header_size = 0;
+    for (Dwarf_Off offset = 0, next_offset = 0;
+	 (dwarf_next_unit(alt_dwarf(), offset, &next_offset, &header_size,
+			  NULL, NULL, NULL, NULL, NULL, NULL) == 0);
+	 offset = next_offset)
+      units.push_back(unit_die_offset(ALT_DEBUG_INFO_DIE_SOURCE,
+				      offset + header_size));
+
+    header_size = 0;
+    for (Dwarf_Off offset = 0, next_offset = 0;
+	 (dwarf_next_unit(dwarf(), offset, &next_offset, &header_size,
+			  NULL, NULL, NULL, NULL, NULL, NULL) == 0);
+	 offset = next_offset)
+      units.push_back(unit_die_offset(PRIMARY_DEBUG_INFO_DIE_SOURCE,
+				      offset + header_size));
+
+    header_size = 0;
+    uint64_t type_signature = 0;
+    Dwarf_Off type_offset;
+    for (Dwarf_Off offset = 0, next_offset = 0;
+	 (dwarf_next_unit(dwarf(), offset, &next_offset, &header_size,
+			  NULL, NULL, NULL, NULL,
+			  &type_signature, &type_offset) == 0);
+	 offset = next_offset)
+      units.push_back(unit_die_offset(TYPE_UNIT_DIE_SOURCE,
+				      offset + header_size));
+  }
+
+  /// Build the DIE -> parent maps (and the maps of the unit import
+  /// points) by spreading the units of the debug info over
+  /// num_threads() worker threads.
+  ///
+  /// Each worker thread walks a contiguous range of units using its
+  /// own debug info handles.  The results are then merged into this
+  /// context in the order of the units, so the resulting maps are
+  /// the same as the ones built by the sequential walk.
+  ///
+  /// @return true iff the maps could be built.  If this returns
+  /// false, then the maps are left empty and the caller is expected
+  /// to build them sequentially.
+  bool
+  build_die_parent_maps_concurrently()
+  {
+    unit_die_offsets_type units;
+    collect_unit_die_offsets(units);
+    if (units.size() < 2)
+      return false;
+
+    size_t num_tasks = std::min(num_threads(), units.size());
+    size_t units_per_task = units.size() / num_tasks;
+    size_t remaining_units = units.size() % num_tasks;
+
+    vector<die_parent_maps_task_sptr> tasks;
+    unit_die_offsets_type::const_iterator b = units.begin();
+    for (size_t i = 0; i < num_tasks; ++i)
+      {
+	unit_die_offsets_type::const_iterator e =
+	  b + units_per_task + (i < remaining_units ? 1 : 0);
+	tasks.push_back
+	  (die_parent_maps_task_sptr
+	   (new die_parent_maps_task(elf_path(), debug_info_root_paths_,
+				     unit_die_offsets_type(b, e))));
+	b = e;
+      }
+
+    {
+      abigail::workers::queue q(num_tasks);
+      for (vector<die_parent_maps_task_sptr>::const_iterator t =
+	     tasks.begin();
+	   t != tasks.end();
+	   ++t)
+	q.schedule_task(*t);
+      q.wait_for_workers_to_complete();
+    }
+
+    for (vector<die_parent_maps_task_sptr>::const_iterator t = tasks.begin();
+	 t != tasks.end();
+	 ++t)
+      if (!(*t)->is_ok)
+	return false;
+
+    for (vector<die_parent_maps_task_sptr>::const_iterator t = tasks.begin();
+	 t != tasks.end();
+	 ++t)
+      {
+	for (size_t i = 0; i < (*t)->walked_units.size(); ++i)
+	  {
+	    const unit_die_offset& u = (*t)->walked_units[i];
+	    tu_die_imported_unit_points_map(u.source)[u.offset] =
+	      (*t)->imported_units[i];
+	  }
+	for (die_source source = PRIMARY_DEBUG_INFO_DIE_SOURCE;
+	     source < NUMBER_OF_DIE_SOURCES;
+	     ++source)
+	  {
+	    const offset_offset_map_type& m = (*t)->parent_maps[source];
+	    die_parent_map(source).insert(m.begin(), m.end());
+	  }
+      }
+
+    return true;
+  }
 };// end class read_context.
 
 static type_or_decl_base_sptr
@@ -7998,6 +9232,154 @@ void
 set_do_log(read_context& ctxt, bool f)
 {ctxt.do_log(f);}
 
+/// Setter of the number of worker threads used to read the debug
+/// info.
+///
+/// When this number is greater than one, the walk of the DIEs of
+/// each unit that builds the DIE -> parent maps is spread over that
+/// many worker threads.  The resulting corpus is the same as the one
+/// built with a single thread.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param n the number of threads to use.  Zero means one.
+void
+set_num_threads(read_context& ctxt, size_t n)
+{ctxt.num_threads(n);}
+
+/// Getter of the number of worker threads used to read the debug
+/// info.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @return the number of threads used to read the debug info.
+size_t
+get_num_threads(const read_context& ctxt)
+{return ctxt.num_threads();}
+
+/// Setter of the directory of the corpus cache.
+///
+/// When this is set, the corpus of a binary is looked up in the
+/// cache, using the build-id of the binary, before being built from
+/// its debug info.  If it's not found there, the corpus built from
+/// the debug info is saved into the cache, in the abixml format.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param dir the path to the directory of the cache.  An empty
+/// string means that no corpus cache is used.
+void
+set_corpus_cache_dir(read_context& ctxt, const string& dir)
+{ctxt.corpus_cache_dir(dir);}
+
+/// Getter of the directory of the corpus cache.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @return the path to the directory of the corpus cache or an empty
+/// string if no corpus cache is used.
+const string&
+get_corpus_cache_dir(const read_context& ctxt)
+{return ctxt.corpus_cache_dir();}
+
+/// Setter of the flag saying if the hashes of the content of the
+/// translation units are to be computed.
+///
+/// When this is set, each translation unit of the corpora built from
+/// the debug info gets the hash of the DIEs of its compilation unit.
+/// See translation_unit::get_content_hash.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param f the new value of the flag.
+void
+set_compute_translation_unit_hashes(read_context& ctxt, bool f)
+{ctxt.compute_tu_hashes(f);}
+
+/// Setter of the hashes of the content of the translation units of a
+/// baseline corpus.
+///
+/// When these are set, the IR of the translation units which content
+/// has the same hash as the translation unit of the same path in the
+/// baseline is not built.  Their absolute paths can then be retrieved
+/// using get_skipped_translation_units.
+///
+/// Note that a translation unit that declares a type which is defined
+/// in a translation unit that changed, or the other way around, is
+/// not skipped, as the resolution of declaration-only types crosses
+/// translation units.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param hashes the hashes of the translation units of the
+/// baseline, indexed by their absolute path.
+void
+set_baseline_translation_unit_hashes
+(read_context& ctxt, const translation_unit_hashes_type& hashes)
+{ctxt.baseline_tu_hashes(hashes);}
+
+/// Getter of the translation units of the last corpus built with a
+/// given context which IR was not built because they are the same
+/// as in the baseline.  See set_baseline_translation_unit_hashes.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @return the absolute paths of the skipped translation units.
+const translation_unit_paths_type&
+get_skipped_translation_units(const read_context& ctxt)
+{return ctxt.skipped_tus();}
+
+/// Getter of the statistics about the use of the corpus cache.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param hits output parameter.  This is set to the number of
+/// corpora that were read from the corpus cache.
+///
+/// @param misses output parameter.  This is set to the number of
+/// corpora that were looked up in the corpus cache but were not found
+/// there.
+void
+get_corpus_cache_stats(const read_context& ctxt,
+		       size_t& hits,
+		       size_t& misses)
+{
+  hits = ctxt.num_corpus_cache_hits();
+  misses = ctxt.num_corpus_cache_misses();
+}
+
+/// Get the times spent in the phases of the construction of the
+/// corpora built with a given DWARF reading context.
+///
+/// The phases are, in order: loading the debug info, loading the ELF
+/// symbols, building the DIE -> parent maps, building the IR,
+/// resolving declaration-only classes and enums, fixing up functions
+/// without symbols, canonicalizing types late and sorting functions
+/// and variables.  A phase which was not entered (e.g, because the
+/// corpus was read from the corpus cache) is not reported.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @return the name of each phase, along with the number of
+/// milliseconds spent in it.
+const phase_timings_type&
+get_phase_timings(const read_context& ctxt)
+{return ctxt.phase_timings();}
+
+/// Get statistics about the memory used by the maps of a DWARF
+/// reading context.
+///
+/// Those maps associate DIEs to their parent DIEs, to their names, to
+/// the IR nodes built for them, etc.  They are reported per kind of
+/// map, along with their approximate size in bytes.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param stats the statistics to add the ones of @p ctxt to.
+void
+get_memory_stats(const read_context& ctxt, memory_stats_type& stats)
+{ctxt.get_memory_stats(stats);}
+
 /// Setter of the "set_ignore_symbol_table" flag.
 ///
 /// This flag tells if we should load information about ELF symbol
@@ -10540,11 +11922,13 @@ get_internal_anonymous_die_name(Dwarf_Die *die,
 /// @param where_offset where in the are logically are in the DIE
 /// stream.
 ///
+/// This is a subroutine of die_qualified_type_name().
+///
 /// @return a copy of the qualified name of the type.
 static string
-die_qualified_type_name(const read_context& ctxt,
-			const Dwarf_Die* die,
-			size_t where_offset)
+compute_die_qualified_type_name(const read_context& ctxt,
+				const Dwarf_Die* die,
+				size_t where_offset)
 {
   if (!die)
     return "";
@@ -10803,22 +12187,56 @@ die_qualified_type_name(const read_context& ctxt,
   return repr;
 }
 
-/// Compute the qualified name of a decl represented by a given DIE.
+/// Compute the qualified name of a DIE that represents a type.
 ///
-/// For instance, for a DIE of tag DW_TAG_subprogram this function
-/// computes the signature of the function *declaration*.
+/// The name is memoized in @p ctxt so that it's computed only once
+/// per DIE, even though it's needed again to compute the names of
+/// all the DIEs that refer to @p die.
 ///
 /// @param ctxt the read context.
 ///
 /// @param die the DIE to consider.
 ///
-/// @param where_offset where we are logically at in the DIE stream.
+/// @param where_offset where in the are logically are in the DIE
+/// stream.
 ///
-/// @return a copy of the computed name.
+/// @return a copy of the qualified name of the type.
 static string
-die_qualified_decl_name(const read_context& ctxt,
+die_qualified_type_name(const read_context& ctxt,
 			const Dwarf_Die* die,
 			size_t where_offset)
+{
+  if (!die)
+    return "";
+
+  string name;
+  die_name_memo_key key = ctxt.get_die_name_memo_key(die, where_offset);
+  if (!ctxt.lookup_die_name_memo(DIE_QUALIFIED_TYPE_NAME, die, key, name))
+    {
+      name = compute_die_qualified_type_name(ctxt, die, where_offset);
+      ctxt.memoize_die_name(DIE_QUALIFIED_TYPE_NAME, die, key, name);
+    }
+  return name;
+}
+
+/// Compute the qualified name of a decl represented by a given DIE.
+///
+/// For instance, for a DIE of tag DW_TAG_subprogram this function
+/// computes the signature of the function *declaration*.
+///
+/// @param ctxt the read context.
+///
+/// @param die the DIE to consider.
+///
+/// @param where_offset where we are logically at in the DIE stream.
+///
+/// This is a subroutine of die_qualified_decl_name().
+///
+/// @return a copy of the computed name.
+static string
+compute_die_qualified_decl_name(const read_context& ctxt,
+				const Dwarf_Die* die,
+				size_t where_offset)
 {
   if (!die || !die_is_decl(die))
     return "";
@@ -10860,6 +12278,36 @@ die_qualified_decl_name(const read_context& ctxt,
   return repr;
 }
 
+/// Compute the qualified name of a decl represented by a given DIE.
+///
+/// The name is memoized in @p ctxt so that it's computed only once
+/// per DIE.
+///
+/// @param ctxt the read context.
+///
+/// @param die the DIE to consider.
+///
+/// @param where_offset where we are logically at in the DIE stream.
+///
+/// @return a copy of the computed name.
+static string
+die_qualified_decl_name(const read_context& ctxt,
+			const Dwarf_Die* die,
+			size_t where_offset)
+{
+  if (!die)
+    return "";
+
+  string name;
+  die_name_memo_key key = ctxt.get_die_name_memo_key(die, where_offset);
+  if (!ctxt.lookup_die_name_memo(DIE_QUALIFIED_DECL_NAME, die, key, name))
+    {
+      name = compute_die_qualified_decl_name(ctxt, die, where_offset);
+      ctxt.memoize_die_name(DIE_QUALIFIED_DECL_NAME, die, key, name);
+    }
+  return name;
+}
+
 /// Compute the qualified name of the artifact represented by a given
 /// DIE.
 ///
@@ -11204,11 +12652,13 @@ die_function_signature(const read_context& ctxt,
 /// this.  It's useful to handle inclusion of DW_TAG_compile_unit
 /// entries.
 ///
+/// This is a subroutine of die_pretty_print_type().
+///
 /// @return the resulting pretty representation.
 static string
-die_pretty_print_type(read_context& ctxt,
-		      const Dwarf_Die* die,
-		      size_t where_offset)
+compute_die_pretty_print_type(read_context& ctxt,
+			      const Dwarf_Die* die,
+			      size_t where_offset)
 {
   if (!die
       || (!die_is_type(die)
@@ -11354,6 +12804,38 @@ die_pretty_print_type(read_context& ctxt,
   return repr;
 }
 
+/// Return a pretty string representation of a type, for internal purposes.
+///
+/// The representation is memoized in @p ctxt so that it's computed
+/// only once per DIE.
+///
+/// @param ctxt the context to use.
+///
+/// @param the DIE of the type to pretty print.
+///
+/// @param where_offset where we logically are placed when calling
+/// this.
+///
+/// @return the resulting pretty representation.
+static string
+die_pretty_print_type(read_context& ctxt,
+		      const Dwarf_Die* die,
+		      size_t where_offset)
+{
+  if (!die)
+    return "";
+
+  string repr;
+  die_name_memo_key key = ctxt.get_die_name_memo_key(die, where_offset);
+  if (!ctxt.lookup_die_name_memo(DIE_PRETTY_TYPE_REPRESENTATION,
+				 die, key, repr))
+    {
+      repr = compute_die_pretty_print_type(ctxt, die, where_offset);
+      ctxt.memoize_die_name(DIE_PRETTY_TYPE_REPRESENTATION, die, key, repr);
+    }
+  return repr;
+}
+
 /// Return a pretty string representation of a declaration, for
 /// internal purposes.
 ///
@@ -11583,6 +13065,130 @@ fn_die_equal_by_linkage_name(const read_context &ctxt,
 	  && llinkage_name == rlinkage_name);
 }
 
+/// Compute a hash of the properties of a DIE that compare_dies always
+/// compares.
+///
+/// These are the tag of the DIE, its size, the tags of its children
+/// and, depending on the kind of the DIE, the offsets of its data
+/// members and the tags of their types, the values of its enumerators
+/// or the lower bounds of its subranges.  The rest of the sub-tree of
+/// the DIE is left out, as compare_dies has short-cuts (for types
+/// that are being compared already, for types that have a canonical
+/// DIE already, etc) for it.
+///
+/// So two DIEs that compare equal have the same structural hash.
+/// Two DIEs that have different structural hashes can thus be
+/// deemed different without comparing them.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param die the DIE to consider.
+///
+/// @return the structural hash of @p die.
+static uint64_t
+compute_die_structural_hash(const read_context& ctxt, const Dwarf_Die* die)
+{
+  hashing::fnv_hasher64 h;
+
+  int tag = dwarf_tag(const_cast<Dwarf_Die*>(die));
+  h.update(static_cast<uint64_t>(tag));
+
+  switch (tag)
+    {
+    case DW_TAG_base_type:
+    case DW_TAG_string_type:
+    case DW_TAG_typedef:
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type:
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+      {
+	uint64_t size = 0;
+	die_size_in_bits(die, size);
+	h.update(size);
+      }
+      break;
+
+    case DW_TAG_enumeration_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+      {
+	uint64_t size = 0;
+	die_size_in_bits(die, size);
+	h.update(size);
+
+	Dwarf_Die child;
+	if (dwarf_child(const_cast<Dwarf_Die*>(die), &child) == 0)
+	  do
+	    {
+	      int child_tag = dwarf_tag(&child);
+	      h.update(static_cast<uint64_t>(child_tag));
+	      if (child_tag == DW_TAG_enumerator)
+		{
+		  uint64_t value = 0;
+		  die_unsigned_constant_attribute(&child, DW_AT_const_value,
+						  value);
+		  h.update(value);
+		}
+	      else if (child_tag == DW_TAG_member
+		       || child_tag == DW_TAG_variable)
+		h.update(compute_die_structural_hash(ctxt, &child));
+	    }
+	  while (dwarf_siblingof(&child, &child) == 0);
+      }
+      break;
+
+    case DW_TAG_member:
+    case DW_TAG_variable:
+      {
+	if (tag == DW_TAG_member)
+	  {
+	    int64_t offset = 0;
+	    die_member_offset(ctxt, die, offset);
+	    h.update(static_cast<uint64_t>(offset));
+	  }
+
+	Dwarf_Die type_die;
+	if (die_die_attribute(die, DW_AT_type, type_die))
+	  h.update(static_cast<uint64_t>(dwarf_tag(&type_die)));
+      }
+      break;
+
+    case DW_TAG_array_type:
+      {
+	// Only the subranges of the arrays are compared, and there
+	// must be as many children in both arrays.
+	Dwarf_Die child;
+	if (dwarf_child(const_cast<Dwarf_Die*>(die), &child) == 0)
+	  do
+	    if (dwarf_tag(&child) == DW_TAG_subrange_type)
+	      h.update(compute_die_structural_hash(ctxt, &child));
+	    else
+	      h.update(static_cast<uint64_t>(0));
+	  while (dwarf_siblingof(&child, &child) == 0);
+      }
+      break;
+
+    case DW_TAG_subrange_type:
+      {
+	// Note that the upper bounds are left out, as compare_dies
+	// can derive the upper bound of a DIE from the DW_AT_count
+	// attribute of the other one.
+	uint64_t lower_bound = 0;
+	die_unsigned_constant_attribute(die, DW_AT_lower_bound, lower_bound);
+	h.update(lower_bound);
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  return h.value();
+}
+
 /// Compare two DIEs emitted by a C compiler.
 ///
 /// @param ctxt the read context used to load the DWARF information.
@@ -12835,6 +14441,14 @@ build_translation_unit_and_add_to_ir(read_context&	ctxt,
       uint64_t l = 0;
       die_unsigned_constant_attribute(die, DW_AT_language, l);
       result->set_language(dwarf_language_to_tu_language(l));
+
+      if (ctxt.compute_tu_hashes())
+	{
+	  translation_unit_hashes_type::const_iterator i =
+	    ctxt.tu_hashes().find(result->get_absolute_path());
+	  if (i != ctxt.tu_hashes().end())
+	    result->set_content_hash(i->second);
+	}
     }
 
   ctxt.cur_transl_unit(result);
@@ -15236,6 +16850,15 @@ function_is_suppressed(const read_context& ctxt,
   string flinkage_name = die_linkage_name(function_die);
   if (flinkage_name.empty() && ctxt.die_is_in_c(function_die))
     flinkage_name = fname;
+
+  // A function which symbol is not in the KMI white list is
+  // suppressed.  Looking the symbol up in the white list is cheaper
+  // than building the qualified name of the function and evaluating
+  // the suppression specifications generated from the white list.
+  if (!flinkage_name.empty()
+      && ctxt.symbol_is_not_kabi_whitelisted(flinkage_name))
+    return true;
+
   string qualified_name = build_qualified_name(scope, fname);
 
   // A non-member non-static function which symbol is not exported is
@@ -15353,6 +16976,13 @@ variable_is_suppressed(const read_context& ctxt,
   string linkage_name = die_linkage_name(variable_die);
   if (linkage_name.empty() && ctxt.die_is_in_c(variable_die))
     linkage_name = name;
+
+  // A variable which symbol is not in the KMI white list is
+  // suppressed, just like in function_is_suppressed.
+  if (!linkage_name.empty()
+      && ctxt.symbol_is_not_kabi_whitelisted(linkage_name))
+    return true;
+
   string qualified_name = build_qualified_name(scope, name);
 
   // If a non member variable that is a declaration (has no defined
@@ -15381,6 +17011,83 @@ variable_is_suppressed(const read_context& ctxt,
 				       /*require_drop_property=*/true);
 }
 
+/// Test if an ELF symbol, or one of its aliases, has its name in a
+/// given set of names.
+///
+/// @param sym the ELF symbol to consider.
+///
+/// @param names the set of names to consider.
+///
+/// @return true iff the name of @p sym or of one of its aliases is
+/// in @p names.
+static bool
+symbol_or_alias_name_is_in(const elf_symbol_sptr& sym,
+			   const symbol_names_set_type& names)
+{
+  elf_symbol_sptr main_sym = sym->get_main_symbol();
+  for (elf_symbol_sptr a = main_sym; a; a = a->get_next_alias())
+    {
+      if (names.find(a->get_name()) != names.end())
+	return true;
+      if (a->get_next_alias() == main_sym)
+	break;
+    }
+  return false;
+}
+
+/// Test if a function or variable DIE is outside of the set of ELF
+/// symbols of interest of the current read context.
+///
+/// Only the DIEs of concrete functions or variables, that is, DIEs
+/// which have an address, are considered.  The other DIEs
+/// (declarations, abstract origins, etc) are always of interest as
+/// they might be needed by the concrete DIEs of interest.
+///
+/// Skipping a DIE that is not of interest before anything is built
+/// for it means that neither its scope nor its type are built,
+/// unless they are reachable from a DIE of interest.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param die the DW_TAG_subprogram or DW_TAG_variable DIE to
+/// consider.
+///
+/// @return true iff a set of symbols of interest was provided for
+/// the kind of @p die and @p die is the DIE of a concrete function
+/// or variable which exported symbol is not in that set.
+static bool
+die_is_not_of_interest(const read_context& ctxt, Dwarf_Die* die)
+{
+  if (get_ignore_symbol_table(ctxt))
+    return false;
+
+  Dwarf_Addr addr = 0;
+  elf_symbol_sptr sym;
+  switch (dwarf_tag(die))
+    {
+    case DW_TAG_subprogram:
+      if (!ctxt.function_symbols_of_interest()
+	  || !ctxt.get_function_address(die, addr))
+	return false;
+      sym = ctxt.function_symbol_is_exported(addr);
+      return (!sym
+	      || !symbol_or_alias_name_is_in
+	      (sym, *ctxt.function_symbols_of_interest()));
+
+    case DW_TAG_variable:
+      if (!ctxt.variable_symbols_of_interest()
+	  || !ctxt.get_variable_address(die, addr))
+	return false;
+      sym = ctxt.variable_symbol_is_exported(addr);
+      return (!sym
+	      || !symbol_or_alias_name_is_in
+	      (sym, *ctxt.variable_symbols_of_interest()));
+
+    default:
+      return false;
+    }
+}
+
 /// Test if a type (designated by a given DIE) in a given scope is
 /// suppressed by the suppression specifications that are associated
 /// to a given read context.
@@ -15784,46 +17491,650 @@ add_var_symbols_to_map(address_set_type& syms,
     }
 }
 
-/// Read all @ref abigail::translation_unit possible from the debug info
-/// accessible through a DWARF Front End Library handle, and stuff
-/// them into a libabigail ABI Corpus.
+/// The content of a unit of the debug info, as seen by
+/// compute_translation_units_hashes.
 ///
-/// @param ctxt the read context.
+/// The unit can be a compilation unit, a partial unit imported by
+/// other units, or a type unit, and it can come from the alternate
+/// debug info file.
+struct unit_content_info
+{
+  /// The hash of the DIEs of the unit.
+  uint64_t			hash;
+  /// The DIEs of the units which DIEs are referred to by the DIEs of
+  /// the unit.
+  vector<Dwarf_Die>		referenced_units;
+  /// Set to true if a reference from a DIE of the unit couldn't be
+  /// resolved.
+  bool				has_unresolved_refs;
+  /// The names of the declaration-only types of the unit.
+  unordered_set<string>		decl_only_type_names;
+  /// The names of the types defined by the unit.
+  unordered_set<string>		defined_type_names;
+
+  unit_content_info()
+    : hash(), has_unresolved_refs()
+  {}
+};
+
+/// Convenience typedef for a map which key is the unit of a DIE (see
+/// Dwarf_Die::cu) and which value is a @ref unit_content_info.
+typedef unordered_map<const void*, unit_content_info> unit_content_info_map;
+
+/// The content of the translation unit of a given path, as seen by
+/// compute_translation_units_hashes.
+struct tu_content_info
+{
+  /// The hasher fed with the hashes of the compilation units of the
+  /// path and of the units they refer to.
+  hashing::fnv_hasher64	hasher;
+  /// The DIEs of the compilation units of the path.
+  vector<Dwarf_Die>	units;
+  /// Set to true if the translation unit must be read even if its
+  /// hash didn't change.
+  bool			must_be_read;
+  /// The names of the declaration-only types of the compilation
+  /// units of the path and of the units they refer to.
+  unordered_set<string>	decl_only_type_names;
+  /// The names of the types defined by the compilation units of the
+  /// path and by the units they refer to.
+  unordered_set<string>	defined_type_names;
+
+  tu_content_info()
+    : must_be_read()
+  {}
+};
+
+/// Convenience typedef for a map which key is the absolute path of a
+/// translation unit and which value is a @ref tu_content_info.
+typedef unordered_map<string, tu_content_info> string_tu_content_info_map;
+
+/// The state of the walk of the DIEs of a unit performed by hash_die.
+struct die_hashing_context
+{
+  const read_context&	reader;
+  hashing::fnv_hasher64	hasher;
+  Dwarf_Off		unit_offset;
+  unit_content_info&	info;
+
+  die_hashing_context(const read_context& r,
+		      Dwarf_Off o,
+		      unit_content_info& i)
+    : reader(r), unit_offset(o), info(i)
+  {}
+};
+
+/// Get the absolute path of the translation unit built from a given
+/// compilation unit DIE.
 ///
-/// @return a pointer to the resulting corpus, or NULL if the corpus
-/// could not be constructed.
-static corpus_sptr
-read_debug_info_into_corpus(read_context& ctxt)
+/// This is the same as what translation_unit::get_absolute_path
+/// returns for that translation unit.
+///
+/// @param die the DW_TAG_compile_unit DIE to consider.
+///
+/// @return the absolute path of the translation unit.
+static string
+compile_unit_absolute_path(Dwarf_Die* die)
 {
-  ctxt.clear_per_corpus_data();
+  string path = die_string_attribute(die, DW_AT_name);
+  if (path.empty())
+    return path;
 
-  if (!ctxt.current_corpus())
-    {
-      corpus_sptr corp (new corpus(ctxt.env(), ctxt.elf_path()));
-      ctxt.current_corpus(corp);
-      if (!ctxt.env())
-	ctxt.env(corp->get_environment());
-    }
+  string compilation_dir = die_string_attribute(die, DW_AT_comp_dir);
+  if (compilation_dir.empty())
+    return path;
 
-  // First set some mundane properties of the corpus gathered from
-  // ELF.
-  ctxt.current_corpus()->set_path(ctxt.elf_path());
-  if (is_linux_kernel(ctxt.elf_handle()))
-    ctxt.current_corpus()->set_origin(corpus::LINUX_KERNEL_BINARY_ORIGIN);
-  else
-    ctxt.current_corpus()->set_origin(corpus::DWARF_ORIGIN);
-  ctxt.current_corpus()->set_soname(ctxt.dt_soname());
-  ctxt.current_corpus()->set_needed(ctxt.dt_needed());
-  ctxt.current_corpus()->set_architecture_name(ctxt.elf_architecture());
-  if (corpus_group_sptr group = ctxt.current_corpus_group())
-    group->add_corpus(ctxt.current_corpus());
+  return compilation_dir + "/" + path;
+}
 
-  // Set symbols information to the corpus.
-  if (!get_ignore_symbol_table(ctxt))
+/// Test if the value of a given attribute is left out of the hash of
+/// the content of a translation unit.
+///
+/// This is the case of the attributes which value depends on the
+/// place of the code and data in the binary, or on the layout of the
+/// debug info sections, rather than on the source code.
+///
+/// @param attr_name the name of the attribute to consider.
+///
+/// @return true iff the value of the attribute is left out.
+static bool
+attribute_value_is_position_dependent(unsigned attr_name)
+{
+  switch (attr_name)
     {
-      if (ctxt.load_in_linux_kernel_mode()
-	  && is_linux_kernel(ctxt.elf_handle()))
-	{
+    case DW_AT_low_pc:
+    case DW_AT_high_pc:
+    case DW_AT_entry_pc:
+    case DW_AT_location:
+    case DW_AT_frame_base:
+    case DW_AT_ranges:
+    case DW_AT_stmt_list:
+    case DW_AT_macro_info:
+    case DW_AT_GNU_macros:
+    case DW_AT_macros:
+      return true;
+    default:
+      return false;
+    }
+}
+
+/// Feed an attribute of a DIE to the hasher of a @ref
+/// die_hashing_context.
+///
+/// This is a callback for dwarf_getattrs.
+///
+/// References to DIEs of the same unit are hashed as offsets relative
+/// to the unit DIE, so that the hash doesn't depend on where the unit
+/// is in the debug info.  References to DIEs of other units, which
+/// might be in the alternate debug info file, are hashed as the tag,
+/// the name and the offset relative to its unit DIE of the
+/// referred-to DIE; the unit of the referred-to DIE is recorded in
+/// unit_content_info::referenced_units so that its content is hashed
+/// as well.
+///
+/// @param attr the attribute to hash.
+///
+/// @param data a pointer to the @ref die_hashing_context to use.
+///
+/// @return DWARF_CB_OK, to visit the next attribute.
+static int
+hash_die_attribute(Dwarf_Attribute* attr, void* data)
+{
+  die_hashing_context* ctxt = static_cast<die_hashing_context*>(data);
+  hashing::fnv_hasher64& h = ctxt->hasher;
+
+  unsigned attr_name = dwarf_whatattr(attr);
+  h.update(static_cast<uint64_t>(attr_name));
+  if (attribute_value_is_position_dependent(attr_name))
+    return DWARF_CB_OK;
+
+  switch (dwarf_whatform(attr))
+    {
+    case DW_FORM_addr:
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_sec_offset:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+      break;
+
+    case DW_FORM_string:
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index:
+    case DW_FORM_GNU_strp_alt:
+      if (const char* s = dwarf_formstring(attr))
+	h.update(string(s));
+      break;
+
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+      {
+	Dwarf_Die target;
+	if (dwarf_formref_die(attr, &target))
+	  h.update(static_cast<uint64_t>(dwarf_dieoffset(&target)
+					 - ctxt->unit_offset));
+      }
+      break;
+
+    case DW_FORM_ref_addr:
+    case DW_FORM_ref_sig8:
+    case DW_FORM_GNU_ref_alt:
+      {
+	Dwarf_Die target, target_unit;
+	if (dwarf_formref_die(attr, &target)
+	    && dwarf_diecu(&target, &target_unit, 0, 0))
+	  {
+	    h.update(static_cast<uint64_t>(dwarf_tag(&target)));
+	    h.update(die_name(&target));
+	    h.update(static_cast<uint64_t>(dwarf_dieoffset(&target)
+					   - dwarf_dieoffset(&target_unit)));
+	    ctxt->info.referenced_units.push_back(target_unit);
+	  }
+	else
+	  ctxt->info.has_unresolved_refs = true;
+      }
+      break;
+
+    case DW_FORM_flag:
+    case DW_FORM_flag_present:
+      {
+	bool flag = false;
+	if (dwarf_formflag(attr, &flag) == 0)
+	  h.update(static_cast<uint64_t>(flag));
+      }
+      break;
+
+    case DW_FORM_sdata:
+    case DW_FORM_implicit_const:
+      {
+	Dwarf_Sword value = 0;
+	if (dwarf_formsdata(attr, &value) == 0)
+	  h.update(static_cast<uint64_t>(value));
+      }
+      break;
+
+    case DW_FORM_block:
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4:
+    case DW_FORM_exprloc:
+    case DW_FORM_data16:
+      {
+	Dwarf_Block block;
+	if (dwarf_formblock(attr, &block) == 0)
+	  {
+	    h.update(static_cast<uint64_t>(block.length));
+	    h.update(block.data, block.length);
+	  }
+      }
+      break;
+
+    default:
+      {
+	Dwarf_Word value = 0;
+	if (dwarf_formudata(attr, &value) == 0)
+	  h.update(static_cast<uint64_t>(value));
+      }
+      break;
+    }
+
+  return DWARF_CB_OK;
+}
+
+/// Feed the ELF symbol of a function or variable DIE to the hasher of
+/// a @ref die_hashing_context.
+///
+/// The addresses of the DIE are left out of its hash, but whether the
+/// function or variable has a symbol, its name, its version, its
+/// aliases, its binding and visibility, and whether it is exported
+/// all shape the IR built for the DIE.  They can change without the
+/// DWARF changing, e.g, when only the version script or the export
+/// list of the binary changes.
+///
+/// @param die the DW_TAG_subprogram or DW_TAG_variable DIE to
+/// consider.
+///
+/// @param ctxt the hashing context to use.
+static void
+hash_die_elf_symbol(Dwarf_Die* die, die_hashing_context& ctxt)
+{
+  const read_context& reader = ctxt.reader;
+  hashing::fnv_hasher64& h = ctxt.hasher;
+
+  Dwarf_Addr address = 0;
+  elf_symbol_sptr sym;
+  bool is_exported = false;
+  if (dwarf_tag(die) == DW_TAG_subprogram)
+    {
+      if (!reader.get_function_address(die, address))
+	return;
+      sym = reader.lookup_elf_fn_symbol_from_address(address);
+      is_exported = bool(reader.function_symbol_is_exported(address));
+    }
+  else
+    {
+      if (!reader.get_variable_address(die, address))
+	return;
+      sym = reader.lookup_elf_var_symbol_from_address(address);
+      is_exported = bool(reader.variable_symbol_is_exported(address));
+    }
+
+  h.update(static_cast<uint64_t>(bool(sym)));
+  if (!sym)
+    return;
+
+  h.update(static_cast<uint64_t>(is_exported));
+  h.update(static_cast<uint64_t>(sym->is_defined()));
+  h.update(static_cast<uint64_t>(sym->get_binding()));
+  h.update(static_cast<uint64_t>(sym->get_visibility()));
+
+  // The order of the aliases depends on the order of the symbol
+  // table, so their IDs are hashed sorted.
+  vector<string> ids;
+  ids.push_back(sym->get_id_string());
+  if (sym->has_aliases())
+    for (elf_symbol_sptr a = sym->get_next_alias();
+	 a && a.get() != sym.get();
+	 a = a->get_next_alias())
+      ids.push_back(a->get_id_string());
+  std::sort(ids.begin(), ids.end());
+  for (vector<string>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+    h.update(*i);
+}
+
+/// Feed a DIE and its sub-tree to the hasher of a @ref
+/// die_hashing_context.
+///
+/// The names of the types declared or defined in the sub-tree are
+/// recorded along the way, in die_hashing_context::info.
+///
+/// @param die the DIE to hash.
+///
+/// @param ctxt the hashing context to use.
+static void
+hash_die(Dwarf_Die* die, die_hashing_context& ctxt)
+{
+  unit_content_info& info = ctxt.info;
+  int tag = dwarf_tag(die);
+  ctxt.hasher.update(static_cast<uint64_t>(tag));
+  dwarf_getattrs(die, hash_die_attribute, &ctxt, 0);
+
+  switch (tag)
+    {
+    case DW_TAG_structure_type:
+    case DW_TAG_class_type:
+    case DW_TAG_union_type:
+    case DW_TAG_enumeration_type:
+      {
+	string name = die_name(die);
+	if (!name.empty())
+	  {
+	    if (die_is_declaration_only(die))
+	      info.decl_only_type_names.insert(name);
+	    else
+	      info.defined_type_names.insert(name);
+	  }
+      }
+      break;
+    case DW_TAG_subprogram:
+    case DW_TAG_variable:
+      hash_die_elf_symbol(die, ctxt);
+      break;
+    default:
+      break;
+    }
+
+  Dwarf_Die child;
+  if (dwarf_child(die, &child) == 0)
+    do
+      hash_die(&child, ctxt);
+    while (dwarf_siblingof(&child, &child) == 0);
+
+  // Mark the end of the children of the DIE, so that the shape of the
+  // tree is part of the hash.
+  ctxt.hasher.update(static_cast<uint64_t>(0));
+}
+
+/// Get the content of a unit of the debug info.
+///
+/// The DIEs of the unit are hashed the first time the unit is
+/// considered, and the result is cached for the next times.
+///
+/// @param unit the unit DIE to consider.
+///
+/// @param units the cache of the content of the units already
+/// hashed.
+///
+/// @param ctxt the read context to look the ELF symbols up from.
+///
+/// @return the content of @p unit.
+static const unit_content_info&
+get_unit_content_info(Dwarf_Die* unit,
+		      unit_content_info_map& units,
+		      const read_context& ctxt)
+{
+  unit_content_info_map::iterator i = units.find(unit->cu);
+  if (i != units.end())
+    return i->second;
+
+  unit_content_info& info = units[unit->cu];
+  die_hashing_context hashing_ctxt(ctxt, dwarf_dieoffset(unit), info);
+  hash_die(unit, hashing_ctxt);
+  info.hash = hashing_ctxt.hasher.value();
+  return info;
+}
+
+/// Feed the hashes of the compilation units of a translation unit,
+/// and of all the units they refer to, directly or not, to the
+/// hasher of the translation unit.
+///
+/// The units referred to are the partial units imported by the
+/// compilation units, the type units of the types they use, or any
+/// unit which DIEs they refer to, in the debug info or in the
+/// alternate debug info.  Their hashes are fed in the order of their
+/// values, so that the result doesn't depend on the layout of the
+/// debug info.  The names of the types they declare or define are
+/// added to the ones of the translation unit.
+///
+/// @param tu the translation unit to consider.
+///
+/// @param units the cache of the content of the units already
+/// hashed.
+///
+/// @param ctxt the read context to look the ELF symbols up from.
+static void
+hash_translation_unit(tu_content_info& tu,
+		      unit_content_info_map& units,
+		      const read_context& ctxt)
+{
+  unordered_set<const void*> own_units, seen;
+  for (vector<Dwarf_Die>::iterator i = tu.units.begin();
+       i != tu.units.end();
+       ++i)
+    {
+      const unit_content_info& info =
+	get_unit_content_info(&*i, units, ctxt);
+      tu.hasher.update(info.hash);
+      own_units.insert(i->cu);
+      seen.insert(i->cu);
+    }
+
+  vector<Dwarf_Die> to_visit = tu.units;
+
+  vector<uint64_t> referenced_unit_hashes;
+  while (!to_visit.empty())
+    {
+      Dwarf_Die unit = to_visit.back();
+      to_visit.pop_back();
+
+      const unit_content_info& info =
+	get_unit_content_info(&unit, units, ctxt);
+      if (info.has_unresolved_refs)
+	tu.must_be_read = true;
+      if (own_units.find(unit.cu) == own_units.end())
+	referenced_unit_hashes.push_back(info.hash);
+      tu.decl_only_type_names.insert(info.decl_only_type_names.begin(),
+				     info.decl_only_type_names.end());
+      tu.defined_type_names.insert(info.defined_type_names.begin(),
+				   info.defined_type_names.end());
+
+      for (vector<Dwarf_Die>::const_iterator i =
+	     info.referenced_units.begin();
+	   i != info.referenced_units.end();
+	   ++i)
+	if (seen.insert(i->cu).second)
+	  to_visit.push_back(*i);
+    }
+
+  std::sort(referenced_unit_hashes.begin(), referenced_unit_hashes.end());
+  for (vector<uint64_t>::const_iterator i = referenced_unit_hashes.begin();
+       i != referenced_unit_hashes.end();
+       ++i)
+    tu.hasher.update(*i);
+}
+
+/// Test if two sets of strings have an element in common.
+///
+/// @param l the first set to consider.
+///
+/// @param r the second set to consider.
+///
+/// @return true iff @p l and @p r have an element in common.
+static bool
+string_sets_intersect(const unordered_set<string>& l,
+		      const unordered_set<string>& r)
+{
+  const unordered_set<string>& smaller = l.size() < r.size() ? l : r;
+  const unordered_set<string>& bigger = l.size() < r.size() ? r : l;
+  for (unordered_set<string>::const_iterator i = smaller.begin();
+       i != smaller.end();
+       ++i)
+    if (bigger.find(*i) != bigger.end())
+      return true;
+  return false;
+}
+
+/// Compute the hashes of the content of the translation units of the
+/// debug info of the current corpus, and determine the translation
+/// units which IR doesn't need to be built because they have the
+/// same hash as in the baseline.
+///
+/// The hash of a translation unit is computed from the hashes of the
+/// DIEs of the compilation units of its path, and of the DIEs of the
+/// units they refer to; see hash_translation_unit.  The hash of the
+/// DIE of a function or variable includes the properties of its ELF
+/// symbol; see hash_die_elf_symbol.  Each unit is
+/// hashed only once, even if several translation units refer to it.
+/// A translation unit which refers to a DIE that can't be found is
+/// never skipped.
+///
+/// A declaration-only type is resolved to a type of the same name
+/// defined in any translation unit.  So an unchanged translation
+/// unit is not skipped if it declares a type which is defined in a
+/// translation unit that is not skipped, or if it defines a type
+/// which is declared in a translation unit that is not skipped.
+///
+/// The hashes end up in read_context::tu_hashes and the skipped
+/// translation units in read_context::skipped_tus.
+///
+/// @param ctxt the read context to consider.
+static void
+compute_translation_units_hashes(read_context& ctxt)
+{
+  string_tu_content_info_map infos;
+  size_t header_size = 0;
+  for (Dwarf_Off offset = 0, next_offset = 0;
+       (dwarf_next_unit(ctxt.dwarf(), offset, &next_offset, &header_size,
+			NULL, NULL, NULL, NULL, NULL, NULL) == 0);
+       offset = next_offset)
+    {
+      Dwarf_Die unit;
+      if (!dwarf_offdie(ctxt.dwarf(), offset + header_size, &unit)
+	  || dwarf_tag(&unit) != DW_TAG_compile_unit)
+	continue;
+
+      infos[compile_unit_absolute_path(&unit)].units.push_back(unit);
+    }
+
+  unit_content_info_map units;
+  for (string_tu_content_info_map::iterator i = infos.begin();
+       i != infos.end();
+       ++i)
+    hash_translation_unit(i->second, units, ctxt);
+
+  const translation_unit_hashes_type& baseline = ctxt.baseline_tu_hashes();
+  unordered_set<string> decl_only_type_names, defined_type_names;
+  vector<string_tu_content_info_map::const_iterator> unchanged_tus;
+  for (string_tu_content_info_map::const_iterator i = infos.begin();
+       i != infos.end();
+       ++i)
+    {
+      string hash = i->second.hasher.value_as_string();
+      ctxt.tu_hashes()[i->first] = hash;
+
+      translation_unit_hashes_type::const_iterator b =
+	baseline.find(i->first);
+      if (!i->second.must_be_read
+	  && b != baseline.end() && b->second == hash)
+	unchanged_tus.push_back(i);
+      else
+	{
+	  decl_only_type_names.insert(i->second.decl_only_type_names.begin(),
+				      i->second.decl_only_type_names.end());
+	  defined_type_names.insert(i->second.defined_type_names.begin(),
+				    i->second.defined_type_names.end());
+	}
+    }
+
+  // Keep the unchanged translation units which types are tied to the
+  // types of the translation units that are read, until there is no
+  // more of them.
+  bool kept_some = true;
+  while (kept_some)
+    {
+      kept_some = false;
+      for (vector<string_tu_content_info_map::const_iterator>::iterator i =
+	     unchanged_tus.begin();
+	   i != unchanged_tus.end();)
+	{
+	  const tu_content_info& info = (*i)->second;
+	  if (string_sets_intersect(info.decl_only_type_names,
+				    defined_type_names)
+	      || string_sets_intersect(info.defined_type_names,
+				       decl_only_type_names))
+	    {
+	      decl_only_type_names.insert(info.decl_only_type_names.begin(),
+					  info.decl_only_type_names.end());
+	      defined_type_names.insert(info.defined_type_names.begin(),
+					info.defined_type_names.end());
+	      i = unchanged_tus.erase(i);
+	      kept_some = true;
+	    }
+	  else
+	    ++i;
+	}
+    }
+
+  for (vector<string_tu_content_info_map::const_iterator>::const_iterator i =
+	 unchanged_tus.begin();
+       i != unchanged_tus.end();
+       ++i)
+    ctxt.skipped_tus().insert((*i)->first);
+}
+
+/// Read all @ref abigail::translation_unit possible from the debug info
+/// accessible through a DWARF Front End Library handle, and stuff
+/// them into a libabigail ABI Corpus.
+///
+/// @param ctxt the read context.
+///
+/// @return a pointer to the resulting corpus, or NULL if the corpus
+/// could not be constructed.
+static corpus_sptr
+read_debug_info_into_corpus(read_context& ctxt)
+{
+  ctxt.clear_per_corpus_data();
+
+  if (!ctxt.current_corpus())
+    {
+      corpus_sptr corp (new corpus(ctxt.env(), ctxt.elf_path()));
+      ctxt.current_corpus(corp);
+      if (!ctxt.env())
+	ctxt.env(corp->get_environment());
+    }
+
+  // First set some mundane properties of the corpus gathered from
+  // ELF.
+  ctxt.current_corpus()->set_path(ctxt.elf_path());
+  if (is_linux_kernel(ctxt.elf_handle()))
+    ctxt.current_corpus()->set_origin(corpus::LINUX_KERNEL_BINARY_ORIGIN);
+  else
+    ctxt.current_corpus()->set_origin(corpus::DWARF_ORIGIN);
+  ctxt.current_corpus()->set_soname(ctxt.dt_soname());
+  ctxt.current_corpus()->set_needed(ctxt.dt_needed());
+  ctxt.current_corpus()->set_architecture_name(ctxt.elf_architecture());
+  if (corpus_group_sptr group = ctxt.current_corpus_group())
+    group->add_corpus(ctxt.current_corpus());
+
+  // Set symbols information to the corpus.
+  if (!get_ignore_symbol_table(ctxt))
+    {
+      if (ctxt.load_in_linux_kernel_mode()
+	  && is_linux_kernel(ctxt.elf_handle()))
+	{
 	  string_elf_symbols_map_sptr exported_fn_symbols_map
 	    (new string_elf_symbols_map_type);
 	  add_fn_symbols_to_map(*ctxt.linux_exported_fn_syms(),
@@ -15877,16 +18188,15 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "building die -> parent maps ...";
-	t.start();
-      }
+      cerr << "building die -> parent maps ...";
+    t.start();
 
     ctxt.build_die_parent_maps();
 
+    t.stop();
+    ctxt.record_phase_time("die-parent-maps", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     << ":"
 	     << t
@@ -15894,15 +18204,33 @@ read_debug_info_into_corpus(read_context& ctxt)
       }
   }
 
+  if (ctxt.compute_tu_hashes())
+    {
+      tools_utils::timer t;
+      if (ctxt.do_log())
+	cerr << "hashing the translation units ...";
+      t.start();
+
+      compute_translation_units_hashes(ctxt);
+
+      t.stop();
+      ctxt.record_phase_time("tu-hashing", t);
+      if (ctxt.do_log())
+	{
+	  cerr << " DONE@" << ctxt.current_corpus()->get_path()
+	       << ":"
+	       << t
+	       << "\n";
+	}
+    }
+
   ctxt.env()->canonicalization_is_done(false);
 
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "building the libabigail internal representation ...";
-	t.start();
-      }
+      cerr << "building the libabigail internal representation ...";
+    t.start();
     // And now walk all the DIEs again to build the libabigail IR.
     Dwarf_Half dwarf_version = 0;
     for (Dwarf_Off offset = 0, next_offset = 0;
@@ -15917,6 +18245,11 @@ read_debug_info_into_corpus(read_context& ctxt)
 	    || dwarf_tag(&unit) != DW_TAG_compile_unit)
 	  continue;
 
+	if (!ctxt.skipped_tus().empty()
+	    && (ctxt.skipped_tus().find(compile_unit_absolute_path(&unit))
+		!= ctxt.skipped_tus().end()))
+	  continue;
+
 	ctxt.dwarf_version(dwarf_version);
 
 	address_size *= 8;
@@ -15927,9 +18260,10 @@ read_debug_info_into_corpus(read_context& ctxt)
 	  build_translation_unit_and_add_to_ir(ctxt, &unit, address_size);
 	ABG_ASSERT(ir_node);
       }
+    t.stop();
+    ctxt.record_phase_time("ir-construction", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     << ":"
 	     << t
@@ -15940,14 +18274,13 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "resolving declaration only classes ...";
-	t.start();
-      }
+      cerr << "resolving declaration only classes ...";
+    t.start();
     ctxt.resolve_declaration_only_classes();
+    t.stop();
+    ctxt.record_phase_time("decl-only-classes-resolution", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     << ":"
 	     << t
@@ -15958,14 +18291,13 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "resolving declaration only enums ...";
-	t.start();
-      }
+      cerr << "resolving declaration only enums ...";
+    t.start();
     ctxt.resolve_declaration_only_enums();
+    t.stop();
+    ctxt.record_phase_time("decl-only-enums-resolution", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     << ":"
 	     << t
@@ -15976,15 +18308,14 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "fixing up functions with linkage name but "
-	     << "no advertised underlying symbols ....";
-	t.start();
-      }
+      cerr << "fixing up functions with linkage name but "
+	   << "no advertised underlying symbols ....";
+    t.start();
     ctxt.fixup_functions_with_no_symbols();
+    t.stop();
+    ctxt.record_phase_time("functions-without-symbols-fixup", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     <<":"
 	     << t
@@ -16006,15 +18337,14 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "perform late type canonicalizing ...\n";
-	t.start();
-      }
+      cerr << "perform late type canonicalizing ...\n";
+    t.start();
 
     ctxt.perform_late_type_canonicalizing();
+    t.stop();
+    ctxt.record_phase_time("late-canonicalization", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << "late type canonicalizing DONE@"
 	     << ctxt.current_corpus()->get_path()
 	     << ":"
@@ -16028,15 +18358,14 @@ read_debug_info_into_corpus(read_context& ctxt)
   {
     tools_utils::timer t;
     if (ctxt.do_log())
-      {
-	cerr << "sort functions and variables ...";
-	t.start();
-      }
+      cerr << "sort functions and variables ...";
+    t.start();
     ctxt.current_corpus()->sort_functions();
     ctxt.current_corpus()->sort_variables();
+    t.stop();
+    ctxt.record_phase_time("functions-and-variables-sorting", t);
     if (ctxt.do_log())
       {
-	t.stop();
 	cerr << " DONE@" << ctxt.current_corpus()->get_path()
 	     << ":"
 	     << t
@@ -16601,6 +18930,9 @@ build_ir_node_from_die(read_context&	ctxt,
 	if (tag == DW_TAG_member)
 	  ABG_ASSERT(!is_c_language(ctxt.cur_transl_unit()->get_language()));
 
+	if (die_is_not_of_interest(ctxt, die))
+	  break;
+
 	if (die_die_attribute(die, DW_AT_specification, spec_die, false)
 	    || (var_is_cloned = die_die_attribute(die, DW_AT_abstract_origin,
 						  spec_die, false)))
@@ -16664,7 +18996,7 @@ build_ir_node_from_die(read_context&	ctxt,
 	Dwarf_Die abstract_origin_die;
 	Dwarf_Die *interface_die = 0, *origin_die = 0;
 	scope_decl_sptr interface_scope;
-	if (die_is_artificial(die))
+	if (die_is_artificial(die) || die_is_not_of_interest(ctxt, die))
 	  break;
 
 	function_decl_sptr fn;
@@ -17045,6 +19377,29 @@ reset_read_context(read_context_sptr	&ctxt,
 		     read_all_types, linux_kernel_mode);
 }
 
+/// Make a read context use the same options as another one.
+///
+/// This is what reset_read_context() does when it re-uses a context
+/// for another binary: the options of the context, like the number
+/// of threads or whether to log, are kept.  So a context created
+/// afresh can be given the options of another context with this
+/// function to behave as if it was re-used from that one.  Note that
+/// the environment of the context and the "load all types" and "linux
+/// kernel mode" options it was created with are not changed.
+///
+/// @param ctxt the read context to set the options of.
+///
+/// @param other the read context to take the options from.
+void
+set_read_context_options_from(read_context& ctxt, const read_context& other)
+{
+  read_context::options_type options = other.options_;
+  options.env = ctxt.options_.env;
+  options.load_all_types = ctxt.options_.load_all_types;
+  options.load_in_linux_kernel_mode = ctxt.options_.load_in_linux_kernel_mode;
+  ctxt.options_ = options;
+}
+
 /// Add suppressions specifications to the set of suppressions to be
 /// used during the construction of the ABI internal representation
 /// (the ABI corpus) from ELF and DWARF.
@@ -17080,6 +19435,67 @@ add_read_context_suppressions(read_context& ctxt,
       ctxt.get_suppressions().push_back(*i);
 }
 
+/// Set the KMI white list to use while reading ELF and DWARF
+/// information.
+///
+/// The functions and variables which ELF symbols are not in the
+/// white list are dropped on the floor before any part of their
+/// internal representation is built, just like if they were dropped
+/// by the suppression specifications generated from the white list
+/// by gen_suppr_spec_from_kernel_abi_whitelists.  Looking a symbol
+/// up in the white list is however cheaper than evaluating these
+/// suppression specifications.
+///
+/// Note that, just like the suppression specifications, the white
+/// list is forgotten by reset_read_context.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param whitelisted_names the names of the ELF symbols of the KMI
+/// white list.  If this is nil, no white list is used.
+void
+set_kernel_abi_whitelist(read_context& ctxt,
+			 const symbol_names_set_sptr& whitelisted_names)
+{ctxt.kabi_whitelist(whitelisted_names);}
+
+/// Restrict the functions for which the DWARF reader builds an
+/// internal representation to those which ELF symbol (or an alias of
+/// it) has its name in a given set.
+///
+/// The DIEs of the other concrete functions are skipped before
+/// anything (their scope, their type, etc) is built for them.  Types
+/// are thus only built when they are reachable from the functions
+/// and variables of interest.  This makes reading a big binary much
+/// cheaper when only a few of its functions are needed, like when
+/// checking the ABI compatibility of an application with a library.
+///
+/// Note that the set is forgotten by reset_read_context.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param names the names of the ELF symbols of the functions of
+/// interest.  If this is nil, all the functions are of interest.
+void
+set_function_symbols_of_interest(read_context& ctxt,
+				 const symbol_names_set_sptr& names)
+{ctxt.function_symbols_of_interest(names);}
+
+/// Restrict the variables for which the DWARF reader builds an
+/// internal representation to those which ELF symbol (or an alias of
+/// it) has its name in a given set.
+///
+/// This is the counterpart of set_function_symbols_of_interest for
+/// variables.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param names the names of the ELF symbols of the variables of
+/// interest.  If this is nil, all the variables are of interest.
+void
+set_variable_symbols_of_interest(read_context& ctxt,
+				 const symbol_names_set_sptr& names)
+{ctxt.variable_symbols_of_interest(names);}
+
 /// Set the @ref corpus_group being created to the current read context.
 ///
 /// @param ctxt the read_context to consider.
@@ -17092,10 +19508,80 @@ set_read_context_corpus_group(read_context& ctxt,
   ctxt.cur_corpus_group_ = group;
 }
 
+/// Compute the path to the file of the corpus cache that contains
+/// the corpus of the binary being read.
+///
+/// The name of that file is made of the build-id of the binary,
+/// followed by a hash of the key computed by
+/// read_context::get_corpus_cache_key().
+///
+/// Note that no corpus cache is used if the binary has no build-id,
+/// if its debug info couldn't be found or if the context has no key
+/// for its corpus.
+///
+/// @param ctxt the context used to read the binary.
+///
+/// @param s the status of the reading of the debug info so far.
+///
+/// @param path output parameter.  This is set to the path of the file
+/// of the cache if the function returns true.
+///
+/// @return true iff the corpus of the binary can be cached.
+static bool
+get_corpus_cache_path(const read_context& ctxt, status s, string& path)
+{
+  string key;
+  if (ctxt.corpus_cache_dir().empty()
+      || (s & STATUS_DEBUG_INFO_NOT_FOUND)
+      || (s & STATUS_ALT_DEBUG_INFO_NOT_FOUND)
+      || !ctxt.elf_module()
+      || !ctxt.get_corpus_cache_key(key))
+    return false;
+
+  const unsigned char* build_id = 0;
+  GElf_Addr build_id_vaddr = 0;
+  int build_id_len =
+    dwfl_module_build_id(ctxt.elf_module(), &build_id, &build_id_vaddr);
+  if (build_id_len <= 0)
+    return false;
+
+  std::ostringstream o;
+  o << ctxt.corpus_cache_dir() << "/" << std::hex << std::setfill('0');
+  for (int i = 0; i < build_id_len; ++i)
+    o << std::setw(2) << static_cast<unsigned>(build_id[i]);
+  o << "-" << std::setw(8) << hashing::fnv_hash(key) << ".abi";
+  path = o.str();
+
+  return true;
+}
+
+/// Load the ELF file and the debug info of the binary a read context
+/// is for, without building any ABI artifact yet.
+///
+/// read_corpus_from_elf() loads them itself if that hasn't been done
+/// already.  Note that if this function fails to find the debug info,
+/// read_corpus_from_elf() doesn't look for it again.  As this
+/// function doesn't touch the environment of the context, it can be
+/// invoked concurrently on distinct contexts.  This is useful to
+/// overlap the opening (and possibly the decompression) of the ELF
+/// and debug info files of several binaries with the construction of
+/// the corpus of another binary.
+///
+/// @param ctxt the context of the binary to consider.
+///
+/// @return true iff the debug info of the binary was found.
+bool
+preload_debug_info(read_context& ctxt)
+{return ctxt.load_debug_info();}
+
 /// Read all @ref abigail::translation_unit possible from the debug info
 /// accessible from an elf file, stuff them into a libabigail ABI
 /// Corpus and return it.
 ///
+/// If a corpus cache directory was set to the context, the corpus is
+/// read from that cache.  If it's not found there, it's first built
+/// from the debug info and saved into the cache.
+///
 /// @param ctxt the context to use for reading the elf file.
 ///
 /// @param resulting_corp a pointer to the resulting abigail::corpus.
@@ -17106,9 +19592,13 @@ read_corpus_from_elf(read_context& ctxt, status& status)
 {
   status = STATUS_UNKNOWN;
 
+  tools_utils::timer t(tools_utils::timer::START_ON_INSTANTIATION_TIMER_KIND);
+
   // Load debug info from the elf path.
   if (!ctxt.load_debug_info())
     status |= STATUS_DEBUG_INFO_NOT_FOUND;
+  t.stop();
+  ctxt.record_phase_time("debug-info-loading", t);
 
   {
     string alt_di_path;
@@ -17116,6 +19606,15 @@ read_corpus_from_elf(read_context& ctxt, status& status)
       status |= STATUS_ALT_DEBUG_INFO_NOT_FOUND;
   }
 
+  string cache_path;
+  if (get_corpus_cache_path(ctxt, status, cache_path))
+    if (corpus_sptr corp = ctxt.read_corpus_from_cache(cache_path))
+      {
+	status |= STATUS_OK;
+	return corp;
+      }
+
+  t.start();
   ctxt.load_elf_properties();  // DT_SONAME, DT_NEEDED, architecture
 
   if (!get_ignore_symbol_table(ctxt))
@@ -17124,6 +19623,8 @@ read_corpus_from_elf(read_context& ctxt, status& status)
       if (!ctxt.load_symbol_maps())
 	status |= STATUS_NO_SYMBOLS_FOUND;
     }
+  t.stop();
+  ctxt.record_phase_time("elf-symbols-loading", t);
 
   if (// If no elf symbol was found ...
       status & STATUS_NO_SYMBOLS_FOUND
@@ -17262,6 +19763,103 @@ lookup_symbol_from_elf(const environment*		env,
   return value;
 }
 
+/// Look into the symbol tables of a given elf file and find the
+/// symbols of several given names.
+///
+/// Unlike invoking @ref lookup_symbol_from_elf once per name, this
+/// opens the ELF file once and indexes the names of the symbols of
+/// its symbol table once.  Each lookup is then done in constant time.
+///
+/// Like @ref lookup_symbol_from_elf, if @p demangle is false and the
+/// ELF file has a hash table, the symbols are looked for among the
+/// symbols of the symbol table the hash table refers to.  Otherwise,
+/// they are looked for in the symbol table of the file.
+///
+/// @param env the environment we are operating from.
+///
+/// @param elf_path the path to the elf file to consider.
+///
+/// @param symbol_names the names of the symbols to look for.
+///
+/// @param demangle if true, compare the names in @p symbol_names to
+/// the demangled names of the symbols of the symbol table.
+///
+/// @param symbols output parameter.  For each name of @p symbol_names
+/// for which symbols were found, this associates the name with the
+/// symbols found.
+///
+/// @return the number of names of @p symbol_names for which symbols
+/// were found.
+size_t
+lookup_symbols_from_elf(const environment*		env,
+			const string&			elf_path,
+			const vector<string>&		symbol_names,
+			bool				demangle,
+			string_elf_symbols_map_type&	symbols)
+{
+  if (elf_version(EV_CURRENT) == EV_NONE)
+    return 0;
+
+  int fd = open(elf_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  Elf* elf = elf_begin(fd, ELF_C_READ, 0);
+  if (elf == 0)
+    {
+      close(fd);
+      return 0;
+    }
+
+  size_t hash_table_index = 0, symbol_table_index = 0;
+  size_t first_symbol_index = 0;
+  hash_table_kind ht_kind = NO_HASH_TABLE_KIND;
+
+  if (!demangle)
+    ht_kind = find_hash_table_section_index(elf,
+					    hash_table_index,
+					    symbol_table_index);
+
+  if (ht_kind == GNU_HASH_TABLE_KIND)
+    {
+      // The GNU hash table only refers to the symbols that come
+      // after a given index of the symbol table.
+      gnu_ht ht;
+      if (setup_gnu_ht(elf, hash_table_index, symbol_table_index, ht))
+	first_symbol_index = ht.first_sym_index;
+      else
+	first_symbol_index = ht.sym_count;
+    }
+  else if (ht_kind == SYSV_HASH_TABLE_KIND)
+    // The first symbol of the table is the undefined symbol.
+    first_symbol_index = 1;
+  else if (!find_symbol_table_section_index(elf, symbol_table_index))
+    symbol_table_index = 0;
+
+  size_t result = 0;
+  if (Elf_Scn* symbol_table = symbol_table_index
+      ? elf_getscn(elf, symbol_table_index)
+      : 0)
+    {
+      elf_symbol_index index(env, elf, symbol_table, first_symbol_index);
+      for (vector<string>::const_iterator i = symbol_names.begin();
+	   i != symbol_names.end();
+	   ++i)
+	{
+	  vector<elf_symbol_sptr> syms;
+	  if (i->empty() || !index.lookup_symbols(*i, demangle, syms))
+	    continue;
+	  symbols[*i] = syms;
+	  ++result;
+	}
+    }
+
+  elf_end(elf);
+  close(fd);
+
+  return result;
+}
+
 /// Look into the symbol tables of an elf file to see if a public
 /// function of a given name is found.
 ///
@@ -17418,6 +20016,50 @@ has_alt_debug_info(const string&	elf_path,
   return STATUS_OK;
 }
 
+/// Get the size of the debug info of a given ELF file.
+///
+/// This is the added sizes of the DWARF sections of the file that
+/// contains the debug info of the ELF file, which might be the ELF
+/// file itself or a split debug info file, and of its alternate debug
+/// info file, if any.  As the time taken to build the corpus of an
+/// ELF file mostly depends on the size of its debug info, this can be
+/// used to estimate that time, without building the corpus.
+///
+/// @param elf_path the path to the elf file to consider.
+///
+/// @param debug_info_root_path a pointer to the root directory under
+/// which the split debug info file associated to elf_path is to be
+/// found.  This has to be NULL if the debug info file is not in a
+/// split file.
+///
+/// @param size out parameter.  This is set to the size, in bytes, of
+/// the debug info of @p elf_path, if the function returns STATUS_OK.
+///
+/// @return STATUS_OK upon successful completion,
+/// STATUS_DEBUG_INFO_NOT_FOUND if the debug info could not be found.
+status
+get_debug_info_size(const string&	elf_path,
+		    char**		debug_info_root_path,
+		    uint64_t&		size)
+{
+  vector<char**> di_roots;
+  di_roots.push_back(debug_info_root_path);
+  read_context_sptr c = create_read_context(elf_path, di_roots, 0);
+  read_context& ctxt = *c;
+
+  if (!ctxt.load_debug_info())
+    return STATUS_DEBUG_INFO_NOT_FOUND;
+
+  size = 0;
+  if (Elf* elf = dwarf_getelf(ctxt.dwarf()))
+    size += elf_helpers::get_debug_sections_size(elf);
+  if (ctxt.alt_dwarf())
+    if (Elf* elf = dwarf_getelf(ctxt.alt_dwarf()))
+      size += elf_helpers::get_debug_sections_size(elf);
+
+  return STATUS_OK;
+}
+
 /// Fetch the SONAME ELF property from an ELF binary file.
 ///
 /// @param path The path to the elf file to consider.
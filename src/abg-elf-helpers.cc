@@ -25,6 +25,7 @@
 #include "abg-elf-helpers.h"
 
 #include <elf.h>
+#include <cstring>
 
 #include "abg-tools-utils.h"
 
@@ -346,6 +347,42 @@ find_section(Elf* elf_handle, const std::string& name, Elf64_Word section_type)
   return 0;
 }
 
+/// Get the added sizes of the DWARF sections of an ELF file.
+///
+/// These are the sections which names start with ".debug_" or, for
+/// compressed sections, with ".zdebug_".
+///
+/// @param elf_handle the elf handle to consider.
+///
+/// @return the added sizes, in bytes, of the DWARF sections of @p
+/// elf_handle.
+uint64_t
+get_debug_sections_size(Elf* elf_handle)
+{
+  size_t section_header_string_index = 0;
+  if (elf_getshdrstrndx (elf_handle, &section_header_string_index) < 0)
+    return 0;
+
+  uint64_t size = 0;
+  Elf_Scn* section = 0;
+  GElf_Shdr header_mem, *header;
+  while ((section = elf_nextscn(elf_handle, section)) != 0)
+    {
+      header = gelf_getshdr(section, &header_mem);
+      if (header == NULL || header->sh_type == SHT_NOBITS)
+	continue;
+
+      const char* section_name =
+	elf_strptr(elf_handle, section_header_string_index, header->sh_name);
+      if (section_name
+	  && (strncmp(section_name, ".debug_", 7) == 0
+	      || strncmp(section_name, ".zdebug_", 8) == 0))
+	size += header->sh_size;
+    }
+
+  return size;
+}
+
 /// Find the symbol table.
 ///
 /// If we are looking at a relocatable or executable file, this
@@ -790,6 +827,50 @@ get_version_for_symbol(Elf*			elf_handle,
 				       verneed_section))
     return false;
 
+  return get_version_for_symbol(elf_handle, versym_section,
+				verdef_section, verneed_section,
+				symbol_index, get_def_version,
+				version);
+}
+
+/// Return the version for a symbol that is at a given index in its
+/// SHT_SYMTAB section, using symbol versionning sections that were
+/// looked up beforehand.
+///
+/// This is useful to get the versions of many symbols of a given ELF
+/// file, without looking up the symbol versionning sections again
+/// for each one of them.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @param versym_section the SHT_GNU_versym section of the ELF file,
+/// or nil.
+///
+/// @param verdef_section the SHT_GNU_verdef section of the ELF file,
+/// or nil.
+///
+/// @param verneed_section the SHT_GNU_verneed section of the ELF
+/// file, or nil.
+///
+/// @param symbol_index the index of the symbol to consider.
+///
+/// @param get_def_version if this is true, the version is looked for
+/// in @p verdef_section.  Otherwise, it is looked for in @p
+/// verneed_section.
+///
+/// @param version the version found for symbol at @p symbol_index.
+///
+/// @return true iff a version was found for symbol at index @p
+/// symbol_index.
+bool
+get_version_for_symbol(Elf*			elf_handle,
+		       Elf_Scn*			versym_section,
+		       Elf_Scn*			verdef_section,
+		       Elf_Scn*			verneed_section,
+		       size_t			symbol_index,
+		       bool			get_def_version,
+		       elf_symbol::version&	version)
+{
   GElf_Versym versym_mem;
   Elf_Data* versym_data = (versym_section)
     ? elf_getdata(versym_section, NULL)
@@ -1027,5 +1108,232 @@ maybe_adjust_et_rel_sym_addr_to_abs_addr(Elf* elf_handle, GElf_Sym* sym)
   return addr + section_header.sh_addr;
 }
 
+/// Constructor of @ref elf_symbol_index.
+///
+/// This looks up the sections needed to build the symbols of the
+/// symbol table.  The names of the symbols are indexed lazily, by
+/// the first lookup by name.
+///
+/// @param env the environment the symbols are to be created in.
+///
+/// @param elf_handle the ELF file to consider.
+///
+/// @param symtab_section the symbol table section to index.  It must
+/// be a section of @p elf_handle.
+///
+/// @param first_symbol_index the index of the first symbol of the
+/// symbol table to consider.  The symbols before it are ignored by
+/// the lookups by name.  This is useful to restrict the lookups to
+/// the symbols that are present in the GNU hash table of the ELF
+/// file.
+elf_symbol_index::elf_symbol_index(const environment*	env,
+				   Elf*			elf_handle,
+				   Elf_Scn*		symtab_section,
+				   size_t		first_symbol_index)
+  : env_(env),
+    elf_handle_(elf_handle),
+    symtab_section_(symtab_section),
+    symtab_data_(),
+    strtab_index_(),
+    first_symbol_index_(first_symbol_index),
+    nb_symbols_(),
+    versym_section_(),
+    verdef_section_(),
+    verneed_section_(),
+    ksymtab_strings_index_(),
+    names_indexed_(),
+    demangled_names_indexed_()
+{
+  ABG_ASSERT(elf_handle_ && symtab_section_);
+
+  GElf_Shdr header_mem;
+  GElf_Shdr* header = gelf_getshdr(symtab_section_, &header_mem);
+  ABG_ASSERT(header);
+  strtab_index_ = header->sh_link;
+  if (header->sh_entsize)
+    nb_symbols_ = header->sh_size / header->sh_entsize;
+
+  symtab_data_ = elf_getdata(symtab_section_, 0);
+  if (!symtab_data_)
+    nb_symbols_ = 0;
+
+  get_symbol_versionning_sections(elf_handle_,
+				  versym_section_,
+				  verdef_section_,
+				  verneed_section_);
+
+  if (Elf_Scn* strings_section = find_ksymtab_strings_section(elf_handle_))
+    ksymtab_strings_index_ = elf_ndxscn(strings_section);
+}
+
+/// Getter of the symbol table section that is indexed.
+///
+/// @return the symbol table section that is indexed.
+Elf_Scn*
+elf_symbol_index::get_symbol_table_section() const
+{return symtab_section_;}
+
+/// Getter of the number of symbols of the indexed symbol table.
+///
+/// @return the number of symbols of the symbol table.
+size_t
+elf_symbol_index::get_number_of_symbols() const
+{return nb_symbols_;}
+
+/// Get the native ELF symbol at a given index of the symbol table.
+///
+/// @param symbol_index the index of the symbol to get.
+///
+/// @param native_sym output parameter.  This is set to the symbol
+/// found, iff the function returns true.
+///
+/// @return true iff the symbol was found.
+bool
+elf_symbol_index::get_native_symbol(size_t	symbol_index,
+				    GElf_Sym&	native_sym) const
+{
+  if (symbol_index >= nb_symbols_)
+    return false;
+  return gelf_getsym(symtab_data_, symbol_index, &native_sym) != 0;
+}
+
+/// Build an instance of @ref elf_symbol for a native ELF symbol of
+/// the symbol table.
+///
+/// The version of the symbol is the version definition of the symbol
+/// if it is defined, or the version it needs otherwise.
+///
+/// @param symbol_index the index of the symbol in the symbol table.
+///
+/// @param native_sym the native symbol at index @p symbol_index.
+///
+/// @return the new instance of @ref elf_symbol.
+elf_symbol_sptr
+elf_symbol_index::create_symbol(size_t		symbol_index,
+				const GElf_Sym&	native_sym) const
+{
+  bool sym_is_defined = native_sym.st_shndx != SHN_UNDEF;
+  // This occurs in relocatable files.
+  bool sym_is_common = native_sym.st_shndx == SHN_COMMON;
+
+  const char* name_str = elf_strptr(elf_handle_, strtab_index_,
+				    native_sym.st_name);
+  if (name_str == 0)
+    name_str = "";
+
+  elf_symbol::version ver;
+  get_version_for_symbol(elf_handle_, versym_section_,
+			 verdef_section_, verneed_section_,
+			 symbol_index, sym_is_defined, ver);
+
+  return elf_symbol::create
+    (env_, symbol_index, native_sym.st_size, name_str,
+     stt_to_elf_symbol_type(GELF_ST_TYPE(native_sym.st_info)),
+     stb_to_elf_symbol_binding(GELF_ST_BIND(native_sym.st_info)),
+     sym_is_defined, sym_is_common, ver,
+     stv_to_elf_symbol_visibility(GELF_ST_VISIBILITY(native_sym.st_other)),
+     native_sym.st_shndx == ksymtab_strings_index_);
+}
+
+/// Build an instance of @ref elf_symbol for the symbol at a given
+/// index of the symbol table.
+///
+/// @param symbol_index the index of the symbol to consider.
+///
+/// @return the new instance of @ref elf_symbol, or nil if there is
+/// no symbol at index @p symbol_index.
+elf_symbol_sptr
+elf_symbol_index::create_symbol(size_t symbol_index) const
+{
+  GElf_Sym native_sym;
+  if (!get_native_symbol(symbol_index, native_sym))
+    return elf_symbol_sptr();
+  return create_symbol(symbol_index, native_sym);
+}
+
+/// Index the symbols of the symbol table by name.
+///
+/// @param demangle if true, index the symbols by their demangled
+/// names.  Otherwise, index them by their names.
+void
+elf_symbol_index::index_names(bool demangle)
+{
+  string_indexes_map& names = demangle ? demangled_names_ : names_;
+
+  for (size_t i = first_symbol_index_; i < nb_symbols_; ++i)
+    {
+      GElf_Sym native_sym;
+      if (!gelf_getsym(symtab_data_, i, &native_sym))
+	continue;
+
+      const char* name_str = elf_strptr(elf_handle_, strtab_index_,
+					native_sym.st_name);
+      if (!name_str)
+	continue;
+
+      if (demangle)
+	names[demangle_cplus_mangled_name(name_str)].push_back(i);
+      else
+	names[name_str].push_back(i);
+    }
+
+  if (demangle)
+    demangled_names_indexed_ = true;
+  else
+    names_indexed_ = true;
+}
+
+/// Look up the indexes of the symbols of a given name.
+///
+/// @param name the name of the symbols to look for.
+///
+/// @param demangle if true, @p name is compared to the demangled
+/// names of the symbols.
+///
+/// @return the indexes of the symbols found, in increasing order, or
+/// nil if no symbol was found.
+const std::vector<size_t>*
+elf_symbol_index::lookup_symbol_indexes(const std::string& name,
+					bool demangle)
+{
+  if (demangle ? !demangled_names_indexed_ : !names_indexed_)
+    index_names(demangle);
+
+  string_indexes_map& names = demangle ? demangled_names_ : names_;
+  string_indexes_map::const_iterator i = names.find(name);
+  if (i == names.end())
+    return 0;
+  return &i->second;
+}
+
+/// Look up the symbols of a given name and build instances of @ref
+/// elf_symbol for them.
+///
+/// @param name the name of the symbols to look for.
+///
+/// @param demangle if true, @p name is compared to the demangled
+/// names of the symbols.
+///
+/// @param syms output parameter.  The symbols found are added to
+/// this vector.
+///
+/// @return true iff at least one symbol was found.
+bool
+elf_symbol_index::lookup_symbols(const std::string&		name,
+				 bool				demangle,
+				 std::vector<elf_symbol_sptr>&	syms)
+{
+  const std::vector<size_t>* indexes = lookup_symbol_indexes(name, demangle);
+  if (!indexes)
+    return false;
+
+  for (std::vector<size_t>::const_iterator i = indexes->begin();
+       i != indexes->end();
+       ++i)
+    syms.push_back(create_symbol(*i));
+
+  return true;
+}
+
 } // end namespace elf_helpers
 } // end namespace abigail
@@ -63,6 +63,9 @@ find_section(Elf*		elf_handle,
 	     const std::string& name,
 	     Elf64_Word		section_type);
 
+uint64_t
+get_debug_sections_size(Elf* elf_handle);
+
 Elf_Scn*
 find_symbol_table_section(Elf* elf_handle);
 
@@ -139,6 +142,90 @@ get_version_for_symbol(Elf*			elf_handle,
 		       bool			get_def_version,
 		       elf_symbol::version&	version);
 
+bool
+get_version_for_symbol(Elf*			elf_handle,
+		       Elf_Scn*			versym_section,
+		       Elf_Scn*			verdef_section,
+		       Elf_Scn*			verneed_section,
+		       size_t			symbol_index,
+		       bool			get_def_version,
+		       elf_symbol::version&	version);
+
+//
+// Index of the symbols of a symbol table
+//
+
+/// An index of the symbols of a symbol table section of an ELF file.
+///
+/// The sections needed to build an @ref elf_symbol out of a native
+/// ELF symbol (symbol versionning sections, string table, etc) are
+/// looked up only once, when the index is created.  The names of the
+/// symbols are indexed the first time a symbol is looked up by name;
+/// subsequent lookups by name are then done in constant time.
+///
+/// So one instance of this type is meant to be shared by all the
+/// lookups of symbols performed on a given symbol table.
+class elf_symbol_index
+{
+  typedef abg_compat::unordered_map<std::string,
+				    std::vector<size_t> > string_indexes_map;
+
+  const environment*	env_;
+  Elf*			elf_handle_;
+  Elf_Scn*		symtab_section_;
+  Elf_Data*		symtab_data_;
+  size_t		strtab_index_;
+  size_t		first_symbol_index_;
+  size_t		nb_symbols_;
+  Elf_Scn*		versym_section_;
+  Elf_Scn*		verdef_section_;
+  Elf_Scn*		verneed_section_;
+  size_t		ksymtab_strings_index_;
+  bool			names_indexed_;
+  bool			demangled_names_indexed_;
+  string_indexes_map	names_;
+  string_indexes_map	demangled_names_;
+
+  elf_symbol_index();
+
+  void
+  index_names(bool demangle);
+
+public:
+
+  elf_symbol_index(const environment*	env,
+		   Elf*			elf_handle,
+		   Elf_Scn*		symtab_section,
+		   size_t		first_symbol_index = 0);
+
+  Elf_Scn*
+  get_symbol_table_section() const;
+
+  size_t
+  get_number_of_symbols() const;
+
+  bool
+  get_native_symbol(size_t symbol_index, GElf_Sym& native_sym) const;
+
+  elf_symbol_sptr
+  create_symbol(size_t symbol_index, const GElf_Sym& native_sym) const;
+
+  elf_symbol_sptr
+  create_symbol(size_t symbol_index) const;
+
+  const std::vector<size_t>*
+  lookup_symbol_indexes(const std::string& name, bool demangle);
+
+  bool
+  lookup_symbols(const std::string&		name,
+		 bool				demangle,
+		 std::vector<elf_symbol_sptr>&	syms);
+}; // end class elf_symbol_index
+
+/// Convenience typedef for a shared pointer to an @ref
+/// elf_symbol_index.
+typedef shared_ptr<elf_symbol_index> elf_symbol_index_sptr;
+
 //
 // Architecture specific helpers
 //
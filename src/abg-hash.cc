@@ -90,6 +90,77 @@ fnv_hash(const std::string& str)
   return hash;
 }
 
+/// Default constructor of @ref fnv_hasher64.
+///
+/// The hash is initialized to the FNV-1a 64-bit offset basis.
+fnv_hasher64::fnv_hasher64()
+  : hash_(0xcbf29ce484222325ULL)
+{}
+
+/// Feed a sequence of bytes to the hash.
+///
+/// @param data the bytes to feed to the hash.
+///
+/// @param size the number of bytes to feed to the hash.
+void
+fnv_hasher64::update(const void* data, std::size_t size)
+{
+  const uint64_t prime = 0x100000001b3ULL;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (std::size_t i = 0; i < size; ++i)
+    {
+      hash_ = hash_ ^ bytes[i];
+      hash_ = hash_ * prime;
+    }
+}
+
+/// Feed the characters of a string to the hash.
+///
+/// Note that the terminating null character is fed too, so that
+/// feeding "ab" then "c" gives a different hash from feeding "a" then
+/// "bc".
+///
+/// @param str the string to feed to the hash.
+void
+fnv_hasher64::update(const std::string& str)
+{update(str.c_str(), str.size() + 1);}
+
+/// Feed an integer to the hash.
+///
+/// The bytes of the integer are fed from the least significant one,
+/// so that the hash does not depend on the endianness of the host.
+///
+/// @param value the integer to feed to the hash.
+void
+fnv_hasher64::update(uint64_t value)
+{
+  uint8_t bytes[sizeof(value)];
+  for (std::size_t i = 0; i < sizeof(value); ++i)
+    bytes[i] = (value >> (8 * i)) & 0xff;
+  update(bytes, sizeof(bytes));
+}
+
+/// Getter of the value of the hash of the bytes fed so far.
+///
+/// @return the value of the hash.
+uint64_t
+fnv_hasher64::value() const
+{return hash_;}
+
+/// Getter of the value of the hash of the bytes fed so far, as a
+/// string of 16 hexadecimal digits.
+///
+/// @return the value of the hash, as a string.
+std::string
+fnv_hasher64::value_as_string() const
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string result(16, '0');
+  for (int i = 15; i >= 0; --i)
+    result[15 - i] = digits[(hash_ >> (4 * i)) & 0xf];
+  return result;
+}
+
 }//end namespace hashing
 
 using std::list;
@@ -143,6 +143,7 @@ struct translation_unit::priv
   std::string					path_;
   std::string					comp_dir_path_;
   std::string					abs_path_;
+  std::string					content_hash_;
   location_manager				loc_mgr_;
   mutable global_scope_sptr			global_scope_;
   mutable vector<type_base_sptr>		synthesized_types_;
@@ -25,6 +25,8 @@
 /// Definitions for the Internal Representation artifacts of libabigail.
 
 #include <cxxabi.h>
+#include <pthread.h>
+#include <cstring>
 #include <vector>
 #include <utility>
 #include <algorithm>
@@ -40,6 +42,7 @@ ABG_BEGIN_EXPORT_DECLARATIONS
 #include "abg-interned-str.h"
 #include "abg-ir.h"
 #include "abg-corpus.h"
+#include "abg-hash.h"
 #include "abg-corpus-priv.h"
 
 ABG_END_EXPORT_DECLARATIONS
@@ -134,22 +137,232 @@ using abg_compat::unordered_map;
 using abg_compat::dynamic_pointer_cast;
 using abg_compat::static_pointer_cast;
 
-/// Convenience typedef for a map of string -> string*.
-typedef unordered_map<string, string*> pool_map_type;
+/// The number of shards of an @ref interned_string_pool.  This must
+/// be a power of two.
+static const size_t NUMBER_OF_STRING_POOL_SHARDS = 16;
+
+/// A shard of an @ref interned_string_pool.
+///
+/// A shard holds the strings which hash values select it.  Each
+/// string is constructed in place, next to its hash value, in big
+/// blocks of memory that are carved out by bumping a pointer; short
+/// strings thus don't need any allocation of their own.  The strings
+/// are indexed by an open addressing hash table that stores pointers
+/// to them.  As the hash values are stored along with the strings,
+/// looking up a string only compares the characters of the strings
+/// which hash value is the same, and growing the table doesn't hash
+/// the characters of the strings again.
+///
+/// Each shard has its own mutex, so that strings can be interned
+/// concurrently by several threads, with little contention.
+class string_pool_shard
+{
+  /// A string of the shard, along with its hash value.
+  struct entry
+  {
+    uint64_t	hash;
+    string	value;
+
+    entry(uint64_t h, const char* s, size_t len)
+      : hash(h), value(s, len)
+    {}
+  }; // end struct entry
+
+  pthread_mutex_t	mutex_;
+  vector<entry*>	table_;
+  size_t		num_entries_;
+  vector<char*>	blocks_;
+  char*			cur_;
+  size_t		num_bytes_left_;
+  size_t		num_bytes_reserved_;
+
+  string_pool_shard(const string_pool_shard&);
+  string_pool_shard& operator=(const string_pool_shard&);
+
+  /// Look up the slot of the hash table for a given string.
+  ///
+  /// @param s the characters of the string to look for.
+  ///
+  /// @param len the number of characters of @p s.
+  ///
+  /// @param h the hash value of @p s.
+  ///
+  /// @return the slot of the entry for @p s, or the empty slot where
+  /// that entry would have to be added.
+  entry**
+  find_slot(const char* s, size_t len, uint64_t h)
+  {
+    size_t mask = table_.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask)
+      {
+	entry* e = table_[i];
+	if (!e
+	    || (e->hash == h
+		&& e->value.size() == len
+		&& memcmp(e->value.data(), s, len) == 0))
+	  return &table_[i];
+      }
+  }
+
+  /// Double the size of the hash table.
+  void
+  grow()
+  {
+    vector<entry*> table(table_.size() * 2);
+    size_t mask = table.size() - 1;
+    for (vector<entry*>::const_iterator i = table_.begin();
+	 i != table_.end();
+	 ++i)
+      if (*i)
+	{
+	  size_t j = (*i)->hash & mask;
+	  while (table[j])
+	    j = (j + 1) & mask;
+	  table[j] = *i;
+	}
+    table_.swap(table);
+  }
+
+  /// Carve the memory for a new entry out of the current block.
+  ///
+  /// @return the memory of the new entry.
+  void*
+  allocate_entry()
+  {
+    if (num_bytes_left_ < sizeof(entry))
+      {
+	cur_ = static_cast<char*>(::operator new(block_size));
+	blocks_.push_back(cur_);
+	num_bytes_left_ = block_size;
+	num_bytes_reserved_ += block_size;
+      }
+    void* result = cur_;
+    cur_ += sizeof(entry);
+    num_bytes_left_ -= sizeof(entry);
+    return result;
+  }
+
+public:
+  /// The size of the blocks of memory the entries are carved from.
+  static const size_t block_size = 64 * 1024;
+
+  string_pool_shard()
+    : table_(64),
+      num_entries_(),
+      cur_(),
+      num_bytes_left_(),
+      num_bytes_reserved_()
+  {pthread_mutex_init(&mutex_, 0);}
+
+  ~string_pool_shard()
+  {
+    for (vector<entry*>::iterator i = table_.begin(); i != table_.end(); ++i)
+      if (*i)
+	(*i)->~entry();
+    for (vector<char*>::iterator i = blocks_.begin(); i != blocks_.end(); ++i)
+      ::operator delete(*i);
+    pthread_mutex_destroy(&mutex_);
+  }
+
+  /// Get the string of the shard which has a given value.
+  ///
+  /// @param s the characters of the string to look for.
+  ///
+  /// @param len the number of characters of @p s.
+  ///
+  /// @param h the hash value of @p s.
+  ///
+  /// @param create if true and if the shard doesn't contain the
+  /// string, add it.
+  ///
+  /// @return the string of the shard which has the value of @p s, or
+  /// nil if there is no such string and @p create is false.
+  string*
+  get_string(const char* s, size_t len, uint64_t h, bool create)
+  {
+    string* result = 0;
+    pthread_mutex_lock(&mutex_);
+    entry** slot = find_slot(s, len, h);
+    if (*slot)
+      result = &(*slot)->value;
+    else if (create)
+      {
+	*slot = new (allocate_entry()) entry(h, s, len);
+	result = &(*slot)->value;
+	// Keep the load factor of the table under 1/2.
+	if (++num_entries_ * 2 > table_.size())
+	  grow();
+      }
+    pthread_mutex_unlock(&mutex_);
+    return result;
+  }
+
+  /// Get statistics about the memory used by the strings of the
+  /// shard.
+  ///
+  /// @param num_strings this is incremented by the number of strings
+  /// of the shard.
+  ///
+  /// @param num_bytes this is incremented by the approximate number
+  /// of bytes used by the strings of the shard.
+  void
+  get_stats(size_t& num_strings, size_t& num_bytes)
+  {
+    pthread_mutex_lock(&mutex_);
+    num_strings += num_entries_;
+    num_bytes += num_bytes_reserved_ + table_.size() * sizeof(entry*);
+    for (vector<entry*>::const_iterator i = table_.begin();
+	 i != table_.end();
+	 ++i)
+      if (*i)
+	{
+	  // The characters of short strings are stored in the string
+	  // object itself, and thus in the blocks of the shard.
+	  const char* chars = (*i)->value.data();
+	  if (chars < reinterpret_cast<const char*>(*i)
+	      || chars >= reinterpret_cast<const char*>(*i + 1))
+	    num_bytes += (*i)->value.capacity() + 1;
+	}
+    pthread_mutex_unlock(&mutex_);
+  }
+}; // end class string_pool_shard
 
 /// The type of the private data structure of type @ref
 /// intered_string_pool.
 struct interned_string_pool::priv
 {
-  pool_map_type map;
+  string_pool_shard shards[NUMBER_OF_STRING_POOL_SHARDS];
+
+  /// Get the string of the pool which has a given value.
+  ///
+  /// @param s the characters of the string to look for.  It must not
+  /// be empty.
+  ///
+  /// @param len the number of characters of @p s.
+  ///
+  /// @param create if true and if the pool doesn't contain the
+  /// string, add it.
+  ///
+  /// @return the string of the pool which has the value of @p s, or
+  /// nil if there is no such string and @p create is false.
+  string*
+  get_string(const char* s, size_t len, bool create)
+  {
+    hashing::fnv_hasher64 hasher;
+    hasher.update(s, len);
+    uint64_t h = hasher.value();
+    // The low order bits of the hash value are used by the hash
+    // table of the shard, so use the high order ones to select it.
+    string_pool_shard& shard =
+      shards[(h >> 32) & (NUMBER_OF_STRING_POOL_SHARDS - 1)];
+    return shard.get_string(s, len, h, create);
+  }
 }; //end struc struct interned_string_pool::priv
 
 /// Default constructor.
 interned_string_pool::interned_string_pool()
   : priv_(new priv)
-{
-  priv_->map[""] = 0;
-}
+{}
 
 /// Test if the interned string pool already contains a string with a
 /// given value.
@@ -159,7 +372,7 @@ interned_string_pool::interned_string_pool()
 /// @return true if the pool contains a string with the value @p s.
 bool
 interned_string_pool::has_string(const char* s) const
-{return priv_->map.find(s) != priv_->map.end();}
+{return !*s || priv_->get_string(s, strlen(s), /*create=*/false);}
 
 /// Get a pointer to the interned string which has a given value.
 ///
@@ -170,38 +383,50 @@ interned_string_pool::has_string(const char* s) const
 const char*
 interned_string_pool::get_string(const char* s) const
 {
-  unordered_map<string, string*>::const_iterator i =
-    priv_->map.find(s);
-  if (i == priv_->map.end())
-    return 0;
-  if (i->second)
-    return i->second->c_str();
-  return "";
+  if (!*s)
+    return "";
+  if (string* result = priv_->get_string(s, strlen(s), /*create=*/false))
+    return result->c_str();
+  return 0;
+}
+
+/// Get statistics about the memory used by the strings of the pool.
+///
+/// @param num_strings output parameter.  This is set to the number of
+/// strings of the pool.
+///
+/// @param num_bytes output parameter.  This is set to the approximate
+/// number of bytes used by the strings of the pool, including the
+/// overhead of the hash tables that index them.
+void
+interned_string_pool::get_stats(size_t& num_strings, size_t& num_bytes) const
+{
+  num_strings = 0;
+  num_bytes = 0;
+  for (size_t i = 0; i < NUMBER_OF_STRING_POOL_SHARDS; ++i)
+    priv_->shards[i].get_stats(num_strings, num_bytes);
 }
 
 /// Create an interned string with a given value.
 ///
+/// This can be called concurrently by several threads.
+///
 /// @param str_value the value of the interned string to create.
 ///
 /// @return the new created instance of @ref interned_string created.
 interned_string
 interned_string_pool::create_string(const std::string& str_value)
 {
-  string*& result = priv_->map[str_value];
-  if (!result && !str_value.empty())
-    result = new string(str_value);
-  return interned_string(result);
+  if (str_value.empty())
+    return interned_string();
+  return interned_string(priv_->get_string(str_value.data(),
+					   str_value.size(),
+					   /*create=*/true));
 }
 
 /// Destructor.
 interned_string_pool::~interned_string_pool()
-{
-  for (pool_map_type::iterator i = priv_->map.begin();
-       i != priv_->map.end();
-       ++i)
-    if (i->second)
-      delete i->second;
-}
+{}
 
 /// Equality operator.
 ///
@@ -897,6 +1122,27 @@ translation_unit::get_absolute_path() const
   return priv_->abs_path_;
 }
 
+/// Getter of the hash of the content of the translation unit.
+///
+/// That hash is computed by the DWARF reader from the debug
+/// information the translation unit is built from, when it's asked to
+/// do so.  It's then saved to, and read back from, the abixml
+/// format.  Two instances of a translation unit which content hashes
+/// are equal are built from the same debug information.
+///
+/// @return the hash of the content of the translation unit, or an
+/// empty string if it's not known.
+const std::string&
+translation_unit::get_content_hash() const
+{return priv_->content_hash_;}
+
+/// Setter of the hash of the content of the translation unit.
+///
+/// @param h the new hash of the content of the translation unit.
+void
+translation_unit::set_content_hash(const std::string& h)
+{priv_->content_hash_ = h;}
+
 /// Set the corpus this translation unit is a member of.
 ///
 /// Note that adding a translation unit to a @ref corpus automatically
@@ -2658,12 +2904,16 @@ struct environment::priv
   unordered_set<const function_type*>	fn_types_being_compared_;
   vector<type_base_sptr>	 extra_live_types_;
   interned_string_pool		 string_pool_;
+  size_t			 num_deep_type_comparisons_;
+  size_t			 num_avoided_type_comparisons_;
   bool				 canonicalization_is_done_;
   bool				 do_on_the_fly_canonicalization_;
   bool				 decl_only_class_equals_definition_;
 
   priv()
-    : canonicalization_is_done_(),
+    : num_deep_type_comparisons_(),
+      num_avoided_type_comparisons_(),
+      canonicalization_is_done_(),
       do_on_the_fly_canonicalization_(true),
       decl_only_class_equals_definition_(false)
   {}
@@ -2694,6 +2944,54 @@ const environment::canonical_types_map_type&
 environment::get_canonical_types_map() const
 {return const_cast<environment*>(this)->get_canonical_types_map();}
 
+/// Get statistics about the map of canonical types of the current
+/// environment.
+///
+/// The canonical types are stored in buckets of types that have the
+/// same pretty representation.  When looking for the canonical type
+/// of a given type, the candidates of the matching bucket which
+/// structural hash value is different from the hash of the type are
+/// skipped; the other ones are structurally compared to the type.
+///
+/// @param num_buckets output parameter.  This is set to the number of
+/// buckets of the map of canonical types.
+///
+/// @param num_canonical_types output parameter.  This is set to the
+/// number of canonical types of the environment.
+///
+/// @param longest_bucket_length output parameter.  This is set to the
+/// number of canonical types of the longest bucket.
+///
+/// @param num_deep_comparisons output parameter.  This is set to the
+/// number of structural comparisons performed while looking for
+/// canonical types.
+///
+/// @param num_avoided_comparisons output parameter.  This is set to
+/// the number of structural comparisons that were avoided because the
+/// hash values of the types being compared were different.
+void
+environment::get_canonical_types_stats(size_t& num_buckets,
+				       size_t& num_canonical_types,
+				       size_t& longest_bucket_length,
+				       size_t& num_deep_comparisons,
+				       size_t& num_avoided_comparisons) const
+{
+  num_buckets = priv_->canonical_types_.size();
+  num_canonical_types = 0;
+  longest_bucket_length = 0;
+  for (canonical_types_map_type::const_iterator i =
+	 priv_->canonical_types_.begin();
+       i != priv_->canonical_types_.end();
+       ++i)
+    {
+      num_canonical_types += i->second.size();
+      if (i->second.size() > longest_bucket_length)
+	longest_bucket_length = i->second.size();
+    }
+  num_deep_comparisons = priv_->num_deep_type_comparisons_;
+  num_avoided_comparisons = priv_->num_avoided_type_comparisons_;
+}
+
 /// Helper to detect if a type is either a reference, a pointer, or a
 /// qualified type.
 static bool
@@ -3010,6 +3308,40 @@ interned_string
 environment::intern(const string& s) const
 {return const_cast<environment*>(this)->priv_->string_pool_.create_string(s);}
 
+/// Get statistics about the memory used by the current environment.
+///
+/// This reports the strings interned in the environment and the map
+/// of canonical types.  Note that the canonical types themselves are
+/// IR nodes that belong to translation units; they are reported by
+/// get_memory_stats() for @ref translation_unit.
+///
+/// @param stats the statistics to add the ones of the current
+/// environment to.
+void
+environment::get_memory_stats(memory_stats_type& stats) const
+{
+  size_t num_strings = 0, num_bytes = 0;
+  priv_->string_pool_.get_stats(num_strings, num_bytes);
+  add_memory_stats(stats, "interned strings", num_strings, num_bytes);
+
+  size_t num_canonical_types = 0;
+  num_bytes =
+    priv_->canonical_types_.bucket_count() * sizeof(void*);
+  for (canonical_types_map_type::const_iterator i =
+	 priv_->canonical_types_.begin();
+       i != priv_->canonical_types_.end();
+       ++i)
+    {
+      num_canonical_types += i->second.size();
+      num_bytes += sizeof(canonical_types_map_type::value_type)
+	+ sizeof(void*)
+	+ i->first.capacity() + 1
+	+ i->second.capacity() * sizeof(type_base_sptr);
+    }
+  add_memory_stats(stats, "canonical types map entries",
+		   num_canonical_types, num_bytes);
+}
+
 // </environment stuff>
 
 // <type_or_decl_base stuff>
@@ -11945,6 +12277,62 @@ types_defined_same_linux_kernel_corpus_public(const type_base& t1,
   return false;
 }
 
+/// Compute a hash value for a type that is about to be looked up in
+/// the map of canonical types.
+///
+/// The types of a given bucket of the map of canonical types all
+/// have the same pretty representation.  This function hashes the
+/// properties of the type that are not part of its pretty
+/// representation, but that are nonetheless compared by the equality
+/// operators of the type.  So if two types have different hash
+/// values, then they are different and don't need to be compared
+/// structurally.
+///
+/// Note that the sub-types of the type are not hashed, so the hash
+/// value is cheap to compute.  Also note that a type for which the
+/// hash cannot be computed this way (e.g, a declaration-only class)
+/// has a hash value of zero.
+///
+/// @param t the type to hash.
+///
+/// @return the hash value of @p t or zero if it couldn't be computed.
+static size_t
+hash_type_for_canonicalization(const type_base* t)
+{
+  abg_compat::hash<size_t> hash_size;
+  type_base::hash hash_type;
+  size_t result = 0;
+
+  if (const class_or_union* c = is_class_or_union_type(t))
+    {
+      if (c->get_is_declaration_only())
+	return 0;
+      result = hash_type(*c);
+      result = hashing::combine_hashes
+	(result, hash_size(c->get_non_static_data_members().size()));
+      result = hashing::combine_hashes
+	(result, hash_size(c->get_member_function_templates().size()));
+      result = hashing::combine_hashes
+	(result, hash_size(c->get_member_class_templates().size()));
+      if (const class_decl* cl = is_class_type(c))
+	result = hashing::combine_hashes
+	  (result, hash_size(cl->get_base_specifiers().size()));
+    }
+  else if (const enum_type_decl* e = is_enum_type(t))
+    {
+      result = hash_type(*e);
+      for (enum_type_decl::enumerators::const_iterator i =
+	     e->get_enumerators().begin();
+	   i != e->get_enumerators().end();
+	   ++i)
+	result = hashing::combine_hashes(result, hash_size(i->get_value()));
+    }
+  else if (const type_decl* d = is_type_decl(t))
+    result = hash_type(*d);
+
+  return result;
+}
+
 /// Compute the canonical type for a given instance of @ref type_base.
 ///
 /// Consider two types T and T'.  The canonical type of T, denoted
@@ -12041,6 +12429,8 @@ type_base::get_canonical_type_for(type_base_sptr t)
   else
     {
       vector<type_base_sptr> &v = i->second;
+      size_t t_hash = 0;
+      bool t_hash_computed = false;
       // Let's compare 't' structurally (i.e, compare its sub-types
       // recursively) against the canonical types of the system. If it
       // equals a given canonical type C, then it means C is the
@@ -12134,8 +12524,29 @@ type_base::get_canonical_type_for(type_base_sptr t)
 	  // Compare types by considering that decl-only classes don't
 	  // equal their definition.
 	  env->decl_only_class_equals_definition(false);
-	  bool equal = types_defined_same_linux_kernel_corpus_public(**it, *t)
-		       || *it == t;
+	  bool equal = types_defined_same_linux_kernel_corpus_public(**it, *t);
+	  if (!equal)
+	    {
+	      // Structurally equal types have the same hash value, as
+	      // computed by hash_type_for_canonicalization.  So if the
+	      // hash values of the two types are different, there is no
+	      // need to compare them structurally.  Note that a hash
+	      // value of zero means the hash couldn't be computed; such
+	      // a type is always compared structurally.
+	      if (!t_hash_computed)
+		{
+		  t_hash = hash_type_for_canonicalization(t.get());
+		  t_hash_computed = true;
+		}
+	      size_t it_hash = hash_type_for_canonicalization(it->get());
+	      if (t_hash && it_hash && t_hash != it_hash)
+		++env->priv_->num_avoided_type_comparisons_;
+	      else
+		{
+		  ++env->priv_->num_deep_type_comparisons_;
+		  equal = (*it == t);
+		}
+	    }
 	  // Restore the state of the on-the-fly-canonicalization and
 	  // the decl-only-class-being-equal-to-a-matching-definition
 	  // flags.
@@ -16104,7 +16515,7 @@ equals(const var_decl& l, const var_decl& r, change_kind* k)
       // The variables have underlying elf symbols that are equal, so
       // now, let's compare the decl_base part of the variables w/o
       // considering their decl names.
-      const interned_string &n1 = l.get_name(), &n2 = r.get_name();
+      interned_string n1 = l.get_name(), n2 = r.get_name();
       const_cast<var_decl&>(l).set_name("");
       const_cast<var_decl&>(r).set_name("");
       bool decl_bases_different = !l.decl_base::operator==(r);
@@ -23706,6 +24117,228 @@ ir_node_visitor::visit_end(member_class_template* d)
 
 // </ir_node_visitor stuff>
 
+// <memory stats stuff>
+
+/// Add the memory footprint of a number of instances of a given kind
+/// of artifact to a set of memory statistics.
+///
+/// If the statistics already have an entry for that kind of
+/// artifact, the instances are added to that entry.  Otherwise, a new
+/// entry is appended to the statistics.
+///
+/// @param stats the statistics to consider.
+///
+/// @param kind the name of the kind of artifact.
+///
+/// @param count the number of instances to add.
+///
+/// @param bytes the approximate number of bytes used by the
+/// instances.
+///
+/// @param shallow true if @p bytes is only the size of the instances
+/// themselves, not accounting for the memory they own.  See @ref
+/// memory_stats_entry::shallow.
+void
+add_memory_stats(memory_stats_type& stats,
+		 const string& kind,
+		 size_t count,
+		 size_t bytes,
+		 bool shallow)
+{
+  for (memory_stats_type::iterator i = stats.begin(); i != stats.end(); ++i)
+    if (i->kind == kind)
+      {
+	i->count += count;
+	i->bytes += bytes;
+	i->shallow = i->shallow || shallow;
+	return;
+      }
+  stats.push_back(memory_stats_entry(kind, count, bytes, shallow));
+}
+
+/// A visitor that counts the IR nodes of a translation unit, per kind
+/// of node.
+///
+/// The size of a node is the shallow size of the object of its most
+/// derived type.  The private data of the node, its containers and
+/// its strings, which make up most of its footprint, are not
+/// accounted for.  The nodes it refers to are counted separately.
+class ir_node_memory_stats_collector : public ir_node_visitor
+{
+  memory_stats_type&				stats_;
+  unordered_set<const type_or_decl_base*>	seen_;
+
+  /// Count a node, unless it has been counted already.
+  ///
+  /// @param node the node to count.
+  ///
+  /// @param kind the name of the kind of node.
+  ///
+  /// @param size the size of the node.
+  ///
+  /// @return true iff the node had not been counted yet, and so its
+  /// sub-nodes must be visited.
+  bool
+  count(const type_or_decl_base* node, const char* kind, size_t size)
+  {
+    if (!seen_.insert(node).second)
+      return false;
+    add_memory_stats(stats_, kind, 1, size, /*shallow=*/true);
+    return true;
+  }
+
+public:
+
+  ir_node_memory_stats_collector(memory_stats_type& stats)
+    : stats_(stats)
+  {}
+
+  virtual bool
+  visit_begin(decl_base* d)
+  {return count(d, "decl_base", sizeof(decl_base));}
+
+  virtual bool
+  visit_begin(scope_decl* d)
+  {return count(d, "scope_decl", sizeof(scope_decl));}
+
+  virtual bool
+  visit_begin(type_base* t)
+  {return count(t, "type_base", sizeof(type_base));}
+
+  virtual bool
+  visit_begin(scope_type_decl* t)
+  {return count(t, "scope_type_decl", sizeof(scope_type_decl));}
+
+  virtual bool
+  visit_begin(type_decl* t)
+  {return count(t, "type_decl", sizeof(type_decl));}
+
+  virtual bool
+  visit_begin(namespace_decl* d)
+  {return count(d, "namespace_decl", sizeof(namespace_decl));}
+
+  virtual bool
+  visit_begin(qualified_type_def* t)
+  {return count(t, "qualified_type_def", sizeof(qualified_type_def));}
+
+  virtual bool
+  visit_begin(pointer_type_def* t)
+  {return count(t, "pointer_type_def", sizeof(pointer_type_def));}
+
+  virtual bool
+  visit_begin(reference_type_def* t)
+  {return count(t, "reference_type_def", sizeof(reference_type_def));}
+
+  virtual bool
+  visit_begin(array_type_def* t)
+  {return count(t, "array_type_def", sizeof(array_type_def));}
+
+  virtual bool
+  visit_begin(array_type_def::subrange_type* t)
+  {
+    return count(t, "array_type_def::subrange_type",
+		 sizeof(array_type_def::subrange_type));
+  }
+
+  virtual bool
+  visit_begin(enum_type_decl* t)
+  {return count(t, "enum_type_decl", sizeof(enum_type_decl));}
+
+  virtual bool
+  visit_begin(typedef_decl* t)
+  {return count(t, "typedef_decl", sizeof(typedef_decl));}
+
+  virtual bool
+  visit_begin(function_type* t)
+  {
+    bool is_method = is_method_type(t);
+    if (!count(t,
+	       is_method ? "method_type" : "function_type",
+	       is_method ? sizeof(method_type) : sizeof(function_type)))
+      return false;
+    size_t num_parms = t->get_parameters().size();
+    add_memory_stats(stats_, "function_decl::parameter", num_parms,
+		     num_parms * sizeof(function_decl::parameter),
+		     /*shallow=*/true);
+    return true;
+  }
+
+  virtual bool
+  visit_begin(var_decl* d)
+  {return count(d, "var_decl", sizeof(var_decl));}
+
+  virtual bool
+  visit_begin(function_decl* d)
+  {
+    return count(d, "function_decl",
+		 is_member_function(d)
+		 ? sizeof(method_decl)
+		 : sizeof(function_decl));
+  }
+
+  virtual bool
+  visit_begin(function_tdecl* d)
+  {return count(d, "function_tdecl", sizeof(function_tdecl));}
+
+  virtual bool
+  visit_begin(class_tdecl* d)
+  {return count(d, "class_tdecl", sizeof(class_tdecl));}
+
+  virtual bool
+  visit_begin(class_decl* t)
+  {return count(t, "class_decl", sizeof(class_decl));}
+
+  virtual bool
+  visit_begin(union_decl* t)
+  {return count(t, "union_decl", sizeof(union_decl));}
+
+  virtual bool
+  visit_begin(class_decl::base_spec* d)
+  {return count(d, "class_decl::base_spec", sizeof(class_decl::base_spec));}
+
+  virtual bool
+  visit_begin(member_function_template* d)
+  {
+    return count(d, "member_function_template",
+		 sizeof(member_function_template));
+  }
+
+  virtual bool
+  visit_begin(member_class_template* d)
+  {
+    return count(d, "member_class_template",
+		 sizeof(member_class_template));
+  }
+}; // end class ir_node_memory_stats_collector
+
+/// Get statistics about the memory used by the IR nodes of a
+/// translation unit.
+///
+/// The IR nodes are counted per kind of node.  Their size is the
+/// shallow size of the object of their most derived type, not
+/// accounting for the private data, the containers and the strings
+/// the nodes own.  So the entries reported are marked as shallow.
+///
+/// @param tu the translation unit to consider.
+///
+/// @param stats the statistics to add the ones of @p tu to.
+void
+get_memory_stats(const translation_unit& tu, memory_stats_type& stats)
+{
+  ir_node_memory_stats_collector v(stats);
+  const_cast<translation_unit&>(tu).traverse(v);
+
+  // Function types are not necessarily reachable from the global
+  // scope of the translation unit.
+  for (vector<function_type_sptr>::const_iterator i =
+	 tu.get_live_fn_types().begin();
+       i != tu.get_live_fn_types().end();
+       ++i)
+    (*i)->traverse(v);
+}
+
+// </memory stats stuff>
+
 // <debugging facilities>
 
 /// Generate a different string at each invocation.
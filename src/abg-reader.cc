@@ -31,12 +31,17 @@
 #include <cerrno>
 #include <deque>
 #include <assert.h>
+#include <pthread.h>
+#include <fstream>
 #include <sstream>
 #include <libxml/xmlstring.h>
+#include <libxml/parser.h>
+#include <libxml/parserInternals.h>
 #include <libxml/xmlreader.h>
 
 #include "abg-cxx-compat.h"
 #include "abg-suppression-priv.h"
+#include "abg-workers.h"
 
 #include "abg-internal.h"
 #include "abg-tools-utils.h"
@@ -84,6 +89,14 @@ static bool	read_is_non_reachable_type(xmlNodePtr, bool&);
 
 class read_context;
 
+struct translation_units_skipping_input;
+
+class translation_unit_parse_task;
+
+/// A convenience typedef for a shared pointer to
+/// translation_unit_parse_task.
+typedef shared_ptr<translation_unit_parse_task> translation_unit_parse_task_sptr;
+
 /// This abstracts the context in which the current ABI
 /// instrumentation dump is being de-serialized.  It carries useful
 /// information needed during the de-serialization, but that does not
@@ -113,6 +126,15 @@ public:
 
   typedef unordered_map<xmlNodePtr, decl_base_sptr> xml_node_decl_base_sptr_map;
 
+  typedef unordered_map<string, size_t> string_size_map;
+
+  /// A range of bytes of the input file, made of the offset of its
+  /// first byte and of the offset of the byte following its last
+  /// byte.
+  typedef std::pair<size_t, size_t> byte_range;
+
+  typedef vector<byte_range> byte_ranges_type;
+
 private:
   string						m_path;
   environment*						m_env;
@@ -122,15 +144,31 @@ private:
   vector<type_base_sptr>				m_types_to_canonicalize;
   string_xml_node_map					m_id_xml_node_map;
   xml_node_decl_base_sptr_map				m_xml_node_decl_map;
+  shared_ptr<translation_units_skipping_input>		m_skipping_input;
   xml::reader_sptr					m_reader;
   xmlNodePtr						m_corp_node;
+  bool							m_can_stream_corpora;
+  bool							m_streaming_corpus;
+  size_t						m_num_streamed_corpora;
+  size_t						m_num_streamed_tu_nodes;
+  deque<xmlNodePtr>					m_pending_tu_nodes;
+  vector<xmlNodePtr>					m_retained_tu_nodes;
+  bool							m_decl_only_type_ids_indexed;
+  vector<string_size_map>				m_decl_only_type_ids_maps;
+  vector<byte_ranges_type>				m_tu_byte_ranges;
+  size_t						m_num_threads;
+  std::ifstream						m_tu_parse_input;
+  vector<translation_unit_parse_task_sptr>		m_tu_parse_tasks;
+  shared_ptr<workers::queue>				m_tu_parse_queue;
   deque<shared_ptr<decl_base> >			m_decls_stack;
   corpus_sptr						m_corpus;
   corpus_group_sptr					m_corpus_group;
   corpus::exported_decls_builder*			m_exported_decls_builder;
   suppr::suppressions_type				m_supprs;
+  mutable suppr::suppressions_index			m_supprs_index;
   bool							m_tracking_non_reachable_types;
   bool							m_drop_undefined_syms;
+  translation_unit_paths_type				m_tus_to_skip;
 
   read_context();
 
@@ -140,11 +178,20 @@ public:
     : m_env(env),
       m_reader(reader),
       m_corp_node(),
+      m_can_stream_corpora(),
+      m_streaming_corpus(),
+      m_num_streamed_corpora(),
+      m_num_streamed_tu_nodes(),
+      m_decl_only_type_ids_indexed(),
+      m_num_threads(1),
       m_exported_decls_builder(),
       m_tracking_non_reachable_types(),
       m_drop_undefined_syms()
   {}
 
+  ~read_context()
+  {free_translation_unit_nodes();}
+
   /// Getter for the flag that tells us if we are tracking types that
   /// are not reachable from global functions and variables.
   ///
@@ -227,6 +274,109 @@ public:
   set_corpus_node(xmlNodePtr node)
   {m_corp_node = node;}
 
+  /// Getter of the flag saying if the current corpus is being read
+  /// one translation unit at a time from the xmlTextReader, rather
+  /// than from a tree of XML nodes built for the whole corpus.
+  ///
+  /// @return true iff the current corpus is being streamed.
+  bool
+  streaming_corpus() const
+  {return m_streaming_corpus;}
+
+  /// Setter of the flag saying if the current corpus is being read
+  /// one translation unit at a time from the xmlTextReader.
+  ///
+  /// @param f the new value of the flag.
+  void
+  streaming_corpus(bool f)
+  {m_streaming_corpus = f;}
+
+  /// Setter of the flag saying if the corpora read by this context
+  /// can be streamed.
+  ///
+  /// That is the case if the input is an ABIXML file, as streaming a
+  /// corpus requires parsing the file a second time.
+  ///
+  /// @param f the new value of the flag.
+  void
+  can_stream_corpora(bool f)
+  {m_can_stream_corpora = f;}
+
+  /// Getter of the number of threads used to load the translation
+  /// units of the corpora.
+  ///
+  /// @return the number of threads.
+  size_t
+  num_threads() const
+  {return m_num_threads;}
+
+  /// Setter of the number of threads used to load the translation
+  /// units of the corpora.
+  ///
+  /// @param n the new number of threads.  Zero means one.
+  void
+  num_threads(size_t n)
+  {m_num_threads = n ? n : 1;}
+
+  /// Getter of the translation units which content is not to be
+  /// read.
+  ///
+  /// @return the absolute paths of the translation units to skip.
+  const translation_unit_paths_type&
+  tus_to_skip() const
+  {return m_tus_to_skip;}
+
+  /// Setter of the translation units which content is not to be
+  /// read.
+  ///
+  /// @param paths the absolute paths of the translation units to
+  /// skip.
+  void
+  tus_to_skip(const translation_unit_paths_type& paths)
+  {m_tus_to_skip = paths;}
+
+  /// Getter of the flag saying if the translation units of the
+  /// corpora are parsed by worker threads.
+  ///
+  /// @return true iff the translation units are parsed by worker
+  /// threads.
+  bool
+  loading_translation_units_concurrently() const
+  {return bool(m_skipping_input);}
+
+  void
+  index_input();
+
+  void
+  start_loading_translation_units_concurrently();
+
+  bool
+  start_streaming_corpus();
+
+  size_t
+  num_translation_units_parsed_ahead() const;
+
+  void
+  schedule_translation_unit_parsing(size_t i);
+
+  xmlNodePtr
+  get_parsed_translation_unit_node(size_t i);
+
+  xmlNodePtr
+  read_translation_unit_node_from_reader();
+
+  xmlNodePtr
+  read_next_translation_unit_node();
+
+  xmlNodePtr
+  read_ahead_until_type_id_is_mapped(const string& id);
+
+  void
+  forget_translation_unit_node(xmlNodePtr node);
+
+  void
+  free_translation_unit_nodes();
+
   const string_xml_node_map&
   get_id_xml_node_map() const
   {return m_id_xml_node_map;}
@@ -711,7 +861,13 @@ public:
   /// @return the vector of suppression specifications.
   suppr::suppressions_type&
   get_suppressions()
-  {return m_supprs;}
+  {
+    // The suppression specifications might be modified by the
+    // caller, so the index of suppression specifications has to be
+    // built again.
+    m_supprs_index.clear();
+    return m_supprs;
+  }
 
   /// Getter of the vector of the suppression specifications
   /// associated to the current read context.
@@ -719,7 +875,22 @@ public:
   /// @return the vector of suppression specifications.
   const suppr::suppressions_type&
   get_suppressions() const
-  {return const_cast<read_context*>(this)->get_suppressions();}
+  {return m_supprs;}
+
+  /// Getter of the index of the suppression specifications
+  /// associated to the current read context.
+  ///
+  /// The index is built the first time this is invoked after the
+  /// suppression specifications might have been modified.
+  ///
+  /// @return the index of the suppression specifications.
+  const suppr::suppressions_index&
+  get_suppressions_index() const
+  {
+    if (!m_supprs_index.is_built())
+      m_supprs_index.build(m_supprs);
+    return m_supprs_index;
+  }
 
   /// Test if there are suppression specifications (associated to the
   /// current corpus) that match a given SONAME or file name.
@@ -1283,7 +1454,11 @@ read_context::build_or_get_type_decl(const string& id,
 
   if (!t)
     {
-      xmlNodePtr n = get_xml_node_from_id(id);
+      xmlNodePtr n = streaming_corpus()
+	// The XML node to build the type from might be in a
+	// translation unit that has not been read yet.
+	? read_ahead_until_type_id_is_mapped(id)
+	: get_xml_node_from_id(id);
       ABG_ASSERT(n);
 
       scope_decl_sptr scope;
@@ -1363,6 +1538,820 @@ walk_xml_node_to_map_type_ids(read_context& ctxt,
     walk_xml_node_to_map_type_ids(ctxt, n);
 }
 
+/// A SAX parser of an ABIXML file that indexes, for each corpus, the
+/// translation units containing the last declaration-only XML node
+/// of each type ID, as well as the ranges of bytes of the
+/// 'abi-instr' elements.
+class decl_only_type_ids_indexer
+{
+  vector<read_context::string_size_map>& maps_;
+  vector<read_context::byte_ranges_type>& ranges_;
+  xmlParserCtxtPtr parser_;
+  size_t num_tus_;
+
+public:
+
+  /// Constructor of the indexer.
+  ///
+  /// @param maps the vector to add the index of each corpus to.  In
+  /// each index, the key is a type ID and the value is the number of
+  /// the translation unit, starting at 1, that contains the last
+  /// declaration-only XML node of that ID.
+  ///
+  /// @param ranges the vector to add the byte ranges of the
+  /// 'abi-instr' elements of each corpus to.  The first offset of
+  /// each range is the offset of the end of the start tag, rather
+  /// than the offset of its first byte.  Note that the offsets are
+  /// relative to the decompressed content of the file.
+  decl_only_type_ids_indexer(vector<read_context::string_size_map>& maps,
+			     vector<read_context::byte_ranges_type>& ranges)
+    : maps_(maps), ranges_(ranges), parser_(), num_tus_()
+  {}
+
+  /// Parse an ABIXML file and index it.
+  ///
+  /// @param path the path to the file.
+  ///
+  /// @return true upon successful completion.
+  bool
+  index(const string& path)
+  {
+    xmlSAXHandler handler;
+    memset(&handler, 0, sizeof(handler));
+    handler.initialized = XML_SAX2_MAGIC;
+    handler.startElementNs = start_element;
+    handler.endElementNs = end_element;
+    // Errors are reported by the xmlTextReader anyway.
+    handler.serror = ignore_error;
+
+    // This is what xmlSAXUserParseFile does, except that the parser
+    // context is kept around to get the offsets of the elements.
+    parser_ = xmlCreateFileParserCtxt(path.c_str());
+    if (!parser_)
+      return false;
+    if (parser_->sax != (xmlSAXHandlerPtr) &xmlDefaultSAXHandler)
+      xmlFree(parser_->sax);
+    parser_->sax = &handler;
+    parser_->userData = this;
+
+    xmlParseDocument(parser_);
+    bool is_ok = parser_->wellFormed;
+
+    parser_->sax = 0;
+    if (parser_->myDoc)
+      xmlFreeDoc(parser_->myDoc);
+    xmlFreeParserCtxt(parser_);
+    parser_ = 0;
+    return is_ok;
+  }
+
+private:
+
+  /// The SAX callback invoked for each start tag.
+  static void
+  start_element(void* ctxt, const xmlChar* name,
+		const xmlChar* /*prefix*/, const xmlChar* /*uri*/,
+		int /*nb_namespaces*/, const xmlChar** /*namespaces*/,
+		int nb_attributes, int /*nb_defaulted*/,
+		const xmlChar** attributes)
+  {
+    decl_only_type_ids_indexer* indexer =
+      static_cast<decl_only_type_ids_indexer*>(ctxt);
+
+    if (xmlStrEqual(name, BAD_CAST("abi-corpus")))
+      {
+	indexer->maps_.push_back(read_context::string_size_map());
+	indexer->ranges_.push_back(read_context::byte_ranges_type());
+	indexer->num_tus_ = 0;
+	return;
+      }
+
+    if (indexer->maps_.empty())
+      return;
+
+    if (xmlStrEqual(name, BAD_CAST("abi-instr")))
+      {
+	++indexer->num_tus_;
+	// The parser is right past the attributes of the element.
+	size_t offset = xmlByteConsumed(indexer->parser_);
+	indexer->ranges_.back().push_back(std::make_pair(offset, offset));
+	return;
+      }
+
+    // Each attribute is made of five pointers: its local name, its
+    // prefix, its URI, and the start and the end of its value.
+    const xmlChar *id = 0, *id_end = 0;
+    bool is_decl_only = false;
+    for (int i = 0; i < nb_attributes; ++i, attributes += 5)
+      if (xmlStrEqual(attributes[0], BAD_CAST("id")))
+	{
+	  id = attributes[3];
+	  id_end = attributes[4];
+	}
+      else if (xmlStrEqual(attributes[0], BAD_CAST("is-declaration-only")))
+	is_decl_only = (attributes[4] - attributes[3] == 3
+			&& !xmlStrncmp(attributes[3], BAD_CAST("yes"), 3));
+
+    if (is_decl_only && id)
+      indexer->maps_.back()[string(reinterpret_cast<const char*>(id),
+				   id_end - id)] = indexer->num_tus_;
+  }
+
+  /// The SAX callback invoked for each end tag.
+  static void
+  end_element(void* ctxt, const xmlChar* name,
+	      const xmlChar* /*prefix*/, const xmlChar* /*uri*/)
+  {
+    decl_only_type_ids_indexer* indexer =
+      static_cast<decl_only_type_ids_indexer*>(ctxt);
+
+    if (!indexer->ranges_.empty()
+	&& !indexer->ranges_.back().empty()
+	&& xmlStrEqual(name, BAD_CAST("abi-instr")))
+      // The parser is right past the end tag.
+      indexer->ranges_.back().back().second =
+	xmlByteConsumed(indexer->parser_);
+  }
+
+  /// The SAX callback invoked for errors.
+  static void
+  ignore_error(void*, xmlErrorPtr)
+  {}
+}; // end class decl_only_type_ids_indexer
+
+/// Parse the input file with a SAX parser to index the type IDs of
+/// its declaration-only XML nodes and the byte ranges of its
+/// translation units, if that has not been done already.
+///
+/// If the file cannot be parsed, the indexes are left empty.
+void
+read_context::index_input()
+{
+  if (m_decl_only_type_ids_indexed)
+    return;
+
+  m_decl_only_type_ids_indexed = true;
+  decl_only_type_ids_indexer indexer(m_decl_only_type_ids_maps,
+				     m_tu_byte_ranges);
+  if (!indexer.index(get_path()))
+    {
+      m_decl_only_type_ids_maps.clear();
+      m_tu_byte_ranges.clear();
+    }
+}
+
+/// The input of an xmlTextReader that reads an ABIXML file in which
+/// the 'abi-instr' elements of given byte ranges are replaced by
+/// empty 'abi-instr' elements.
+///
+/// This lets the reader move past translation units that are parsed
+/// by worker threads, without parsing them again.
+struct translation_units_skipping_input
+{
+  std::ifstream			in;
+  read_context::byte_ranges_type	ranges;
+  size_t			offset;
+  size_t			next_range;
+  size_t			placeholder_offset;
+
+  translation_units_skipping_input()
+    : offset(), next_range(), placeholder_offset()
+  {}
+}; // end struct translation_units_skipping_input
+
+/// The empty element that replaces the skipped 'abi-instr' elements.
+static const char skipped_translation_unit_placeholder[] = "<abi-instr/>";
+
+/// The number of translation units per worker thread that are parsed
+/// ahead of the construction of their IR, as translation units are
+/// often small.
+static const size_t num_translation_units_parsed_per_thread = 8;
+
+/// This is an xmlInputReadCallback, meant to be passed to
+/// xmlReaderForIO.  It reads a number of bytes from a
+/// translation_units_skipping_input.
+///
+/// @param context the translation_units_skipping_input to read
+/// from.
+///
+/// @param buffer the buffer where to copy the data read.
+///
+/// @param len the number of bytes to read.
+///
+/// @return the number of bytes read or -1 in case of error.
+static int
+read_skipping_translation_units(void* context, char* buffer, int len)
+{
+  translation_units_skipping_input* input =
+    static_cast<translation_units_skipping_input*>(context);
+
+  if (input->next_range < input->ranges.size()
+      && input->offset == input->ranges[input->next_range].first)
+    {
+      // Emit the placeholder of the translation unit, and then move
+      // past it.
+      size_t size = sizeof(skipped_translation_unit_placeholder) - 1;
+      size_t n = std::min(static_cast<size_t>(len),
+			  size - input->placeholder_offset);
+      memcpy(buffer,
+	     skipped_translation_unit_placeholder + input->placeholder_offset,
+	     n);
+      input->placeholder_offset += n;
+      if (input->placeholder_offset == size)
+	{
+	  input->placeholder_offset = 0;
+	  input->offset = input->ranges[input->next_range].second;
+	  ++input->next_range;
+	  input->in.clear();
+	  input->in.seekg(input->offset);
+	}
+      return n;
+    }
+
+  size_t n = len;
+  if (input->next_range < input->ranges.size())
+    n = std::min(n, input->ranges[input->next_range].first - input->offset);
+  input->in.read(buffer, n);
+  n = input->in.gcount();
+  if (!n && input->in.bad())
+    return -1;
+  input->offset += n;
+  return n;
+}
+
+/// This is an xmlInputCloseCallback, meant to be passed to
+/// xmlReaderForIO.  The translation_units_skipping_input is owned by
+/// the read_context, so this does nothing.
+///
+/// @return 0.
+static int
+close_skipping_translation_units(void*)
+{return 0;}
+
+/// Make the byte ranges of 'abi-instr' elements computed by
+/// decl_only_type_ids_indexer start at the first byte of their start
+/// tag.
+///
+/// As the values of attributes cannot contain a '<', the start tag
+/// begins at the last '<' that precedes the end of its attributes.
+///
+/// @param in the input file.
+///
+/// @param ranges the ranges to adjust.
+///
+/// @return true iff all the ranges could be adjusted.
+static bool
+adjust_translation_units_byte_ranges(std::istream& in,
+				     read_context::byte_ranges_type& ranges)
+{
+  char buf[4096];
+  for (read_context::byte_ranges_type::iterator r = ranges.begin();
+       r != ranges.end();
+       ++r)
+    {
+      bool found = false;
+      for (size_t end = r->first; !found && end;)
+	{
+	  size_t begin = end > sizeof(buf) ? end - sizeof(buf) : 0;
+	  in.seekg(begin);
+	  if (!in.read(buf, end - begin))
+	    return false;
+	  for (size_t i = end - begin; i; --i)
+	    if (buf[i - 1] == '<')
+	      {
+		r->first = begin + i - 1;
+		found = true;
+		break;
+	      }
+	  end = begin;
+	}
+      if (!found)
+	return false;
+    }
+  return true;
+}
+
+/// Set things up so that the translation units of the corpora of
+/// the input file are parsed by worker threads, ahead of the
+/// construction of their IR.
+///
+/// The xmlTextReader is replaced by one that sees an empty
+/// 'abi-instr' element in place of each translation unit.  Then,
+/// read_translation_unit_node_from_reader gets the XML nodes of the
+/// translation units from the worker threads.
+///
+/// This is done only if the number of threads is greater than one
+/// and if the reader has not started reading the input.  It is not
+/// done either for compressed files, as the byte ranges of the
+/// translation units are relative to their decompressed content.
+void
+read_context::start_loading_translation_units_concurrently()
+{
+  if (num_threads() < 2
+      || !m_can_stream_corpora
+      || get_path().empty()
+      || loading_translation_units_concurrently()
+      || !m_reader
+      || xmlTextReaderReadState(m_reader.get()) != XML_TEXTREADER_MODE_INITIAL)
+    return;
+
+  shared_ptr<translation_units_skipping_input>
+    input(new translation_units_skipping_input);
+  input->in.open(get_path().c_str(), std::ios::binary);
+  char magic[5];
+  if (!input->in.read(magic, sizeof(magic))
+      || strncmp(magic, "<abi-", sizeof(magic)))
+    return;
+
+  index_input();
+  for (vector<byte_ranges_type>::iterator i = m_tu_byte_ranges.begin();
+       i != m_tu_byte_ranges.end();
+       ++i)
+    {
+      if (!adjust_translation_units_byte_ranges(input->in, *i))
+	return;
+      input->ranges.insert(input->ranges.end(), i->begin(), i->end());
+    }
+  if (input->ranges.empty())
+    return;
+
+  input->in.clear();
+  input->in.seekg(0);
+  xml::reader_sptr reader =
+    xml::build_sptr(xmlReaderForIO(&read_skipping_translation_units,
+				   &close_skipping_translation_units,
+				   input.get(), get_path().c_str(), 0, 0));
+  if (!reader)
+    return;
+
+  m_tu_parse_input.open(get_path().c_str(), std::ios::binary);
+  if (!m_tu_parse_input)
+    return;
+
+  m_skipping_input = input;
+  m_reader = reader;
+}
+
+/// Start streaming the corpus which 'abi-corpus' element node the
+/// xmlTextReader is on.
+///
+/// In a tree of XML nodes built for a whole corpus, a type is built
+/// from the last declaration-only XML node that has its ID, if any,
+/// or else from the first XML node that has its ID.  As the type can
+/// be needed before that XML node is reached when the corpus is
+/// streamed, the input file is first parsed by a SAX parser that
+/// indexes the translation units containing the last
+/// declaration-only XML node of each type ID.
+///
+/// @return true iff the corpus can be streamed.  Otherwise, a tree
+/// of XML nodes must be built for the whole corpus.
+bool
+read_context::start_streaming_corpus()
+{
+  if (!m_can_stream_corpora || get_path().empty())
+    return false;
+
+  index_input();
+
+  if (m_num_streamed_corpora >= m_decl_only_type_ids_maps.size())
+    return false;
+
+  ++m_num_streamed_corpora;
+  m_num_streamed_tu_nodes = 0;
+  streaming_corpus(true);
+
+  if (loading_translation_units_concurrently())
+    {
+      m_tu_parse_queue.reset();
+      m_tu_parse_tasks.clear();
+      m_tu_parse_tasks.resize
+	(m_tu_byte_ranges[m_num_streamed_corpora - 1].size());
+      m_tu_parse_queue.reset(new workers::queue(num_threads()));
+      size_t n = std::min(num_translation_units_parsed_ahead(),
+			  m_tu_parse_tasks.size());
+      for (size_t i = 0; i < n; ++i)
+	schedule_translation_unit_parsing(i);
+    }
+
+  return true;
+}
+
+/// Collect the type IDs defined in an XML sub-tree, along with the
+/// XML nodes defining them, in the order in which
+/// walk_xml_node_to_map_type_ids maps them.
+///
+/// @param node the XML sub-tree to walk.
+///
+/// @param ids the vector to add the IDs and their nodes to.
+static void
+collect_type_ids(xmlNodePtr node,
+		 vector<std::pair<string, xmlNodePtr> >& ids)
+{
+  if (!node || node->type != XML_ELEMENT_NODE)
+    return;
+
+  if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(node, "id"))
+    ids.push_back(std::make_pair(CHAR_STR(s), node));
+
+  for (xmlNodePtr n = node->children; n; n = n->next)
+    collect_type_ids(n, ids);
+}
+
+/// A task that parses the 'abi-instr' element of a translation unit
+/// into its own XML document.
+///
+/// The task only uses its own XML parser and document, so several
+/// instances of it can be performed concurrently.  As the tasks of a
+/// corpus are all performed by the same queue, the reader waits for
+/// each of them with translation_unit_parse_task::wait_until_done.
+class translation_unit_parse_task : public workers::task
+{
+  string		path_;
+  string		bytes_;
+  bool			done_;
+  pthread_mutex_t	mutex_;
+  pthread_cond_t	cond_;
+
+public:
+
+  /// The parsed document, or nil if the translation unit could not
+  /// be parsed.  Its root element is the 'abi-instr' element.
+  xmlDocPtr			doc;
+
+  /// The type IDs defined in the translation unit and the XML nodes
+  /// defining them.
+  vector<std::pair<string, xmlNodePtr> > ids;
+
+  /// Constructor of the task.
+  ///
+  /// @param path the path to the input file.
+  ///
+  /// @param bytes the bytes of the 'abi-instr' element.  They are
+  /// moved into the task.
+  translation_unit_parse_task(const string& path, string& bytes)
+    : path_(path), done_(false), doc()
+  {
+    bytes_.swap(bytes);
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&cond_, 0);
+  }
+
+  ~translation_unit_parse_task()
+  {
+    if (doc)
+      xmlFreeDoc(doc);
+    pthread_cond_destroy(&cond_);
+    pthread_mutex_destroy(&mutex_);
+  }
+
+  /// Parse the bytes of the translation unit and collect the type IDs
+  /// it defines.
+  virtual void
+  perform()
+  {
+    doc = xmlReadMemory(bytes_.data(), bytes_.size(), path_.c_str(), 0, 0);
+    if (doc)
+      collect_type_ids(xmlDocGetRootElement(doc), ids);
+    string().swap(bytes_);
+
+    pthread_mutex_lock(&mutex_);
+    done_ = true;
+    pthread_cond_broadcast(&cond_);
+    pthread_mutex_unlock(&mutex_);
+  }
+
+  /// Wait until the task has been performed by a worker thread.
+  void
+  wait_until_done()
+  {
+    pthread_mutex_lock(&mutex_);
+    while (!done_)
+      pthread_cond_wait(&cond_, &mutex_);
+    pthread_mutex_unlock(&mutex_);
+  }
+}; // end class translation_unit_parse_task
+
+/// Getter of the number of translation units of the corpus being
+/// streamed that are parsed by the worker threads ahead of the one
+/// which IR is being built.
+///
+/// This bounds the number of parsed translation units held in
+/// memory.
+///
+/// @return the number of translation units parsed ahead.
+size_t
+read_context::num_translation_units_parsed_ahead() const
+{return num_threads() * num_translation_units_parsed_per_thread;}
+
+/// Schedule the parsing of a translation unit of the corpus being
+/// streamed, by the worker threads of the queue of that corpus.
+///
+/// The bytes of the translation unit are read from the input file,
+/// which is opened once for all the translation units, and handed
+/// to the task.
+///
+/// @param i the index of the translation unit in the corpus.
+void
+read_context::schedule_translation_unit_parsing(size_t i)
+{
+  const byte_range& range = m_tu_byte_ranges[m_num_streamed_corpora - 1][i];
+  string bytes(range.second - range.first, '\0');
+  m_tu_parse_input.clear();
+  m_tu_parse_input.seekg(range.first);
+  if (!m_tu_parse_input.read(&bytes[0], bytes.size()))
+    return;
+
+  m_tu_parse_tasks[i].reset(new translation_unit_parse_task(get_path(),
+							     bytes));
+  m_tu_parse_queue->schedule_task(m_tu_parse_tasks[i]);
+}
+
+/// Get the XML node of a translation unit of the corpus being
+/// streamed, parsed by a worker thread.
+///
+/// While the translation units are returned, the worker threads keep
+/// parsing the ones that follow them, up to
+/// read_context::num_translation_units_parsed_ahead.  The type IDs
+/// defined in the translation unit are mapped to their XML nodes.
+///
+/// @param i the index of the translation unit in the corpus.
+///
+/// @return the 'abi-instr' element node of the translation unit, or
+/// nil if it could not be parsed.  It must be released by
+/// read_context::forget_translation_unit_node.
+xmlNodePtr
+read_context::get_parsed_translation_unit_node(size_t i)
+{
+  if (i >= m_tu_parse_tasks.size())
+    return 0;
+
+  size_t next = i + num_translation_units_parsed_ahead();
+  if (next < m_tu_parse_tasks.size())
+    schedule_translation_unit_parsing(next);
+
+  translation_unit_parse_task_sptr task = m_tu_parse_tasks[i];
+  m_tu_parse_tasks[i].reset();
+  if (!task)
+    return 0;
+  task->wait_until_done();
+  if (!task->doc)
+    return 0;
+
+  xmlNodePtr node = xmlDocGetRootElement(task->doc);
+  task->doc = 0;
+  for (vector<std::pair<string, xmlNodePtr> >::const_iterator j =
+	 task->ids.begin();
+       j != task->ids.end();
+       ++j)
+    map_id_and_node(j->first, j->second);
+
+  return node;
+}
+
+/// Take an XML element node that has been expanded by the
+/// xmlTextReader out of the document built by the reader.
+///
+/// The reader frees the nodes of the document as it moves forward.
+/// So the attributes and the children of the node are moved to a new
+/// element node of the same name, which is not part of the document.
+/// The node left in the document is thus an empty element node,
+/// which the reader can move past as usual.
+///
+/// @param node the expanded node to consider.
+///
+/// @return the new node.  It must be freed with xmlFreeNode.
+static xmlNodePtr
+take_expanded_node(xmlNodePtr node)
+{
+  xmlNodePtr result = xmlNewDocNode(node->doc, 0, node->name, 0);
+  result->line = node->line;
+
+  result->properties = node->properties;
+  result->children = node->children;
+  result->last = node->last;
+  node->properties = 0;
+  node->children = node->last = 0;
+
+  for (xmlAttrPtr a = result->properties; a; a = a->next)
+    a->parent = result;
+  for (xmlNodePtr n = result->children; n; n = n->next)
+    n->parent = result;
+
+  return result;
+}
+
+/// Read the next 'abi-instr' element node from the xmlTextReader.
+///
+/// The sub-tree of the element is taken out of the document built by
+/// the reader, using take_expanded_node, or it is the one parsed by
+/// a worker thread if the translation units are loaded concurrently.
+/// It must be released by read_context::forget_translation_unit_node.
+/// The type IDs defined in the sub-tree are mapped to their XML
+/// nodes.
+///
+/// @return the 'abi-instr' element node, or nil if the next element
+/// node is not an 'abi-instr' one.  In that case, the reader is left
+/// on that element node.
+xmlNodePtr
+read_context::read_translation_unit_node_from_reader()
+{
+  xml::reader_sptr reader = get_reader();
+  if (!reader)
+    return 0;
+
+  int status = 1;
+  while (status == 1
+	 && XML_READER_GET_NODE_TYPE(reader) != XML_READER_TYPE_ELEMENT)
+    status = advance_cursor(*this);
+
+  if (status != 1 || !xmlStrEqual(XML_READER_GET_NODE_NAME(reader).get(),
+				  BAD_CAST("abi-instr")))
+    return 0;
+
+  if (loading_translation_units_concurrently())
+    {
+      // The reader is on the empty element that stands for the
+      // translation unit.
+      xmlTextReaderNext(reader.get());
+      return get_parsed_translation_unit_node(m_num_streamed_tu_nodes++);
+    }
+
+  xmlNodePtr node = xmlTextReaderExpand(reader.get());
+  if (!node)
+    return 0;
+
+  node = take_expanded_node(node);
+  xmlTextReaderNext(reader.get());
+  ++m_num_streamed_tu_nodes;
+  walk_xml_node_to_map_type_ids(*this, node);
+  return node;
+}
+
+/// Get the XML node of the next translation unit of the corpus being
+/// streamed.
+///
+/// That is either a translation unit that has already been read
+/// ahead by read_ahead_until_type_id_is_mapped, or the next one read
+/// from the xmlTextReader.
+///
+/// @return the XML node of the next translation unit, or nil if there
+/// is none.
+xmlNodePtr
+read_context::read_next_translation_unit_node()
+{
+  if (m_pending_tu_nodes.empty())
+    return read_translation_unit_node_from_reader();
+
+  xmlNodePtr node = m_pending_tu_nodes.front();
+  m_pending_tu_nodes.pop_front();
+  return node;
+}
+
+/// Get the XML node to build a type from, in the corpus being
+/// streamed.
+///
+/// If that XML node is in a translation unit that comes later in the
+/// input, the translation units up to that one are read ahead.  They
+/// are kept until read_next_translation_unit_node returns them.
+///
+/// @param id the ID of the type to consider.
+///
+/// @return the XML node to build the type from, or nil if it could
+/// not be found.
+xmlNodePtr
+read_context::read_ahead_until_type_id_is_mapped(const string& id)
+{
+  const string_size_map& decl_only_type_ids =
+    m_decl_only_type_ids_maps[m_num_streamed_corpora - 1];
+  string_size_map::const_iterator i = decl_only_type_ids.find(id);
+  bool has_decl_only_node = i != decl_only_type_ids.end();
+
+  while (has_decl_only_node
+	 ? m_num_streamed_tu_nodes < i->second
+	 : !get_xml_node_from_id(id))
+    {
+      xmlNodePtr node = read_translation_unit_node_from_reader();
+      if (!node)
+	break;
+      m_pending_tu_nodes.push_back(node);
+    }
+
+  return get_xml_node_from_id(id);
+}
+
+/// Walk an XML sub-tree and collect its element nodes.
+///
+/// @param node the XML sub-tree to walk.
+///
+/// @param nodes the vector to add the element nodes to.
+static void
+collect_xml_element_nodes(xmlNodePtr node, vector<xmlNodePtr>& nodes)
+{
+  if (!node || node->type != XML_ELEMENT_NODE)
+    return;
+
+  nodes.push_back(node);
+  for (xmlNodePtr n = node->children; n; n = n->next)
+    collect_xml_element_nodes(n, nodes);
+}
+
+/// Free the XML node of a translation unit of the corpus being
+/// streamed.
+///
+/// @param node the node to free.  It is either a node returned by
+/// take_expanded_node, or the root element of a document parsed by
+/// a translation_unit_parse_task.
+static void
+free_translation_unit_xml_node(xmlNodePtr node)
+{
+  if (node->parent && node->parent == reinterpret_cast<xmlNodePtr>(node->doc))
+    xmlFreeDoc(node->doc);
+  else
+    xmlFreeNode(node);
+}
+
+/// Release the XML node of a translation unit of the corpus being
+/// streamed, once that translation unit has been read.
+///
+/// The XML nodes of the translation unit are removed from the maps
+/// of the read context, and then freed.  If the translation unit
+/// defines a type ID for which no type has been built yet (e.g,
+/// because the translation unit was not read as a translation unit
+/// of the same path had been read before) then it is kept until the
+/// end of the corpus, so that the type can still be built later.
+///
+/// @param node the XML node of the translation unit to release.
+void
+read_context::forget_translation_unit_node(xmlNodePtr node)
+{
+  vector<xmlNodePtr> nodes;
+  collect_xml_element_nodes(node, nodes);
+
+  vector<string> ids;
+  for (vector<xmlNodePtr>::const_iterator i = nodes.begin();
+       i != nodes.end();
+       ++i)
+    if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(*i, "id"))
+      {
+	string id = CHAR_STR(s);
+	if (get_xml_node_from_id(id) != *i)
+	  continue;
+	if (!get_type_decl(id)
+	    && !get_fn_tmpl_decl(id)
+	    && !get_class_tmpl_decl(id))
+	  {
+	    m_retained_tu_nodes.push_back(node);
+	    return;
+	  }
+	ids.push_back(id);
+      }
+
+  for (vector<string>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+    get_id_xml_node_map().erase(*i);
+  for (vector<xmlNodePtr>::const_iterator i = nodes.begin();
+       i != nodes.end();
+       ++i)
+    get_xml_node_decl_map().erase(*i);
+  free_translation_unit_xml_node(node);
+}
+
+/// Free the XML nodes of the translation units of the corpus being
+/// streamed that are still around.
+///
+/// This must be called before the xmlTextReader is freed.
+void
+read_context::free_translation_unit_nodes()
+{
+  if (m_pending_tu_nodes.empty() && m_retained_tu_nodes.empty())
+    return;
+
+  m_retained_tu_nodes.insert(m_retained_tu_nodes.end(),
+			     m_pending_tu_nodes.begin(),
+			     m_pending_tu_nodes.end());
+  m_pending_tu_nodes.clear();
+  for (vector<xmlNodePtr>::const_iterator i = m_retained_tu_nodes.begin();
+       i != m_retained_tu_nodes.end();
+       ++i)
+    {
+      vector<xmlNodePtr> nodes;
+      collect_xml_element_nodes(*i, nodes);
+      for (vector<xmlNodePtr>::const_iterator j = nodes.begin();
+	   j != nodes.end();
+	   ++j)
+	{
+	  if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(*j, "id"))
+	    {
+	      string id = CHAR_STR(s);
+	      if (get_xml_node_from_id(id) == *j)
+		get_id_xml_node_map().erase(id);
+	    }
+	  get_xml_node_decl_map().erase(*j);
+	}
+      free_translation_unit_xml_node(*i);
+    }
+  m_retained_tu_nodes.clear();
+}
+
 static bool
 read_translation_unit(read_context& ctxt, translation_unit& tu, xmlNodePtr node)
 {
@@ -1391,6 +2380,10 @@ read_translation_unit(read_context& ctxt, translation_unit& tu, xmlNodePtr node)
     tu.set_language(string_to_translation_unit_language
 		     (reinterpret_cast<char*>(language_str.get())));
 
+  xml::xml_char_sptr content_hash_str =
+    XML_NODE_GET_ATTRIBUTE(node, "content-hash");
+  if (content_hash_str)
+    tu.set_content_hash(reinterpret_cast<char*>(content_hash_str.get()));
 
   // We are at global scope, as we've just seen the top-most
   // "abi-instr" element.
@@ -1401,6 +2394,18 @@ read_translation_unit(read_context& ctxt, translation_unit& tu, xmlNodePtr node)
       || !ctxt.get_corpus())
     walk_xml_node_to_map_type_ids(ctxt, node);
 
+  // The content of a translation unit to skip is not read.  The
+  // types it defines can still be built if they are referred to by
+  // the translation units that are read, though.
+  if (!ctxt.tus_to_skip().empty()
+      && (ctxt.tus_to_skip().find(tu.get_absolute_path())
+	  != ctxt.tus_to_skip().end()))
+    {
+      ctxt.pop_scope_or_abort(tu.get_global_scope());
+      ctxt.clear_per_translation_unit_data();
+      return true;
+    }
+
   for (xmlNodePtr n = node->children; n; n = n->next)
     {
       if (n->type != XML_ELEMENT_NODE)
@@ -1566,7 +2571,7 @@ read_symbol_db_from_input(read_context&		 ctxt,
 	  status = advance_cursor (ctxt);
 
 	if (status != 1)
-	  return false;
+	  break;
 
 	bool has_fn_syms = false, has_var_syms = false;
 	if (xmlStrEqual (XML_READER_GET_NODE_NAME(reader).get(),
@@ -1595,6 +2600,9 @@ read_symbol_db_from_input(read_context&		 ctxt,
 	      found = true;
 	  }
 
+	// build_elf_symbol_db sets the corpus node, but the node is
+	// going to be freed by the reader as it moves past it.
+	ctxt.set_corpus_node(0);
 	xmlTextReaderNext(reader.get());
       }
   else
@@ -1718,7 +2726,12 @@ read_elf_needed_from_input(read_context&	ctxt,
   if (node)
     {
       result = build_needed(node, needed);
-      ctxt.set_corpus_node(node);
+      if (ctxt.get_corpus_node())
+	ctxt.set_corpus_node(node);
+      else
+	// This is the necessary counter-part of the
+	// xmlTextReaderExpand() call above.
+	xmlTextReaderNext(reader.get());
     }
 
   return result;
@@ -1773,10 +2786,131 @@ consider_types_not_reachable_from_public_interfaces(read_context& ctxt,
 						    bool flag)
 {ctxt.tracking_non_reachable_types(flag);}
 
+/// Setter of the number of threads used to load the translation units
+/// of the corpora read from an ABIXML file.
+///
+/// When this number is greater than one, the input file is split
+/// into its translation units, which worker threads parse into trees
+/// of XML nodes ahead of the construction of their IR.  The IR
+/// itself is built sequentially, in the order of the input, as the
+/// types of all the translation units are created in the same
+/// environment.  The resulting corpora are thus the same as the ones
+/// built with a single thread.
+///
+/// This must be called before reading the first corpus or corpus
+/// group of the input.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param n the number of threads to use.  Zero means one.
+void
+set_num_threads(read_context& ctxt, size_t n)
+{ctxt.num_threads(n);}
+
+/// Getter of the number of threads used to load the translation
+/// units of the corpora read from an ABIXML file.
+///
+/// @param ctxt the read context to consider.
+///
+/// @return the number of threads.
+size_t
+get_num_threads(const read_context& ctxt)
+{return ctxt.num_threads();}
+
+/// Setter of the translation units which content is not to be read
+/// from an ABIXML file.
+///
+/// The translation units of these paths are still added to the
+/// corpora that are read, but their functions, variables and types
+/// are not read.  Types they define are nonetheless built if they
+/// are referred to by the translation units that are read.
+///
+/// This is useful to compare only the translation units which
+/// content changed since a baseline.  See
+/// dwarf_reader::set_baseline_translation_unit_hashes.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param paths the absolute paths of the translation units to skip.
+void
+set_translation_units_to_skip(read_context& ctxt,
+			      const translation_unit_paths_type& paths)
+{ctxt.tus_to_skip(paths);}
+
+/// Read the hashes of the content of the translation units of the
+/// ABIXML document of a read context.
+///
+/// These are the values of the 'content-hash' attributes of the
+/// 'abi-instr' elements, which are emitted when the corpus was built
+/// with dwarf_reader::set_compute_translation_unit_hashes.  The
+/// content of the translation units is not read.
+///
+/// Note that this consumes the input of the read context.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param hashes output parameter.  The hashes read, indexed by the
+/// absolute path of their translation units.
+///
+/// @return true upon successful completion, false if the input could
+/// not be read.
+bool
+read_translation_unit_hashes(read_context& ctxt,
+			     translation_unit_hashes_type& hashes)
+{
+  xml::reader_sptr reader = ctxt.get_reader();
+  if (!reader)
+    return false;
+
+  int status = advance_cursor(ctxt);
+  while (status == 1)
+    {
+      if (XML_READER_GET_NODE_TYPE(reader) != XML_READER_TYPE_ELEMENT
+	  || !xmlStrEqual(XML_READER_GET_NODE_NAME(reader).get(),
+			  BAD_CAST("abi-instr")))
+	{
+	  status = advance_cursor(ctxt);
+	  continue;
+	}
+
+      xml::xml_char_sptr hash_str =
+	XML_READER_GET_ATTRIBUTE(reader, "content-hash");
+      xml::xml_char_sptr path_str = XML_READER_GET_ATTRIBUTE(reader, "path");
+      if (hash_str && path_str)
+	{
+	  // This is what translation_unit::get_absolute_path returns.
+	  string path;
+	  xml::xml_char_sptr comp_dir_path_str =
+	    XML_READER_GET_ATTRIBUTE(reader, "comp-dir-path");
+	  if (comp_dir_path_str && *comp_dir_path_str.get())
+	    {
+	      path = reinterpret_cast<char*>(comp_dir_path_str.get());
+	      path += "/";
+	    }
+	  path += reinterpret_cast<char*>(path_str.get());
+	  hashes[path] = reinterpret_cast<char*>(hash_str.get());
+	}
+
+      // Move past the content of the translation unit.
+      status = xmlTextReaderNext(reader.get());
+    }
+
+  return status == 0;
+}
+
 /// Parse the input XML document containing an ABI corpus, represented
 /// by an 'abi-corpus' element node, associated to the current
 /// context.
 ///
+/// When the corpus is read from the xmlTextReader, it is streamed.
+/// That is, rather than building the tree of XML nodes of the whole
+/// corpus, the translation units are read one at a time and the tree
+/// of XML nodes of each one of them is freed as soon as it has been
+/// read.  If a translation unit refers to a type defined in a
+/// translation unit that comes later in the input, that later
+/// translation unit is read ahead.  See set_num_threads to have the
+/// translation units parsed by worker threads.
+///
 /// @param ctxt the current input context.
 ///
 /// @return the corpus resulting from the parsing
@@ -1785,11 +2919,12 @@ read_corpus_from_input(read_context& ctxt)
 {
   corpus_sptr nil;
 
+  ctxt.start_loading_translation_units_concurrently();
   xml::reader_sptr reader = ctxt.get_reader();
   if (!reader)
     return nil;
 
-  bool call_reader_next = false;
+  bool is_tracking_non_reachable_types = false, call_reader_next = false;
 
   xmlNodePtr node = ctxt.get_corpus_node();
   if (!node)
@@ -1848,15 +2983,32 @@ read_corpus_from_input(read_context& ctxt)
       //      |soname_not_regexp
       //      |file_name_regexp
       //      |file_name_not_regexp) = <soname-or-file-name>
-      if ((!soname.empty() || !path.empty())
+      if (!ctxt.get_corpus_group()
+	  && (!soname.empty() || !path.empty())
 	  && ctxt.corpus_is_suppressed_by_soname_or_filename(soname, path))
 	return nil;
 
-      node = xmlTextReaderExpand(reader.get());
-      if (!node)
+      if (xml::xml_char_sptr s =
+	  XML_READER_GET_ATTRIBUTE(reader, "tracking-non-reachable-types"))
+	is_tracking_non_reachable_types =
+	  xmlStrEqual(s.get(), BAD_CAST("yes"));
+
+      if (xmlTextReaderIsEmptyElement(reader.get()) == 1)
 	return nil;
 
-      call_reader_next = true;
+      if (!ctxt.start_streaming_corpus())
+	{
+	  node = xmlTextReaderExpand(reader.get());
+	  if (!node)
+	    return nil;
+	  call_reader_next = true;
+	}
+      // Move to the first child node of the abi-corpus element.
+      else if (advance_cursor(ctxt) != 1)
+	{
+	  ctxt.streaming_corpus(false);
+	  return nil;
+	}
     }
   else
     {
@@ -1888,14 +3040,19 @@ read_corpus_from_input(read_context& ctxt)
 	corp.set_soname(reinterpret_cast<char*>(soname_str.get()));
     }
 
-  if (!node->children)
-    return nil;
+  if (!ctxt.streaming_corpus())
+    {
+      read_tracking_non_reachable_types(node, is_tracking_non_reachable_types);
 
-  ctxt.set_corpus_node(node->children);
+      if (!node->children)
+	return nil;
 
-  corpus& corp = *ctxt.get_corpus();
+      ctxt.set_corpus_node(node->children);
+
+      walk_xml_node_to_map_type_ids(ctxt, node);
+    }
 
-  walk_xml_node_to_map_type_ids(ctxt, node);
+  corpus& corp = *ctxt.get_corpus();
 
   // Read the needed element
   vector<string> needed;
@@ -1927,18 +3084,25 @@ read_corpus_from_input(read_context& ctxt)
   ctxt.get_environment()->canonicalization_is_done(false);
 
   // Read the translation units.
-  do
+  if (ctxt.streaming_corpus())
     {
-      translation_unit_sptr tu = read_translation_unit_from_input(ctxt);
-      is_ok = bool(tu);
+      while (xmlNodePtr n = ctxt.read_next_translation_unit_node())
+	{
+	  get_or_read_and_add_translation_unit(ctxt, n);
+	  ctxt.forget_translation_unit_node(n);
+	}
+      ctxt.free_translation_unit_nodes();
     }
-  while (is_ok);
+  else
+    do
+      {
+	translation_unit_sptr tu = read_translation_unit_from_input(ctxt);
+	is_ok = bool(tu);
+      }
+    while (is_ok);
 
   if (ctxt.tracking_non_reachable_types())
     {
-      bool is_tracking_non_reachable_types = false;
-      read_tracking_non_reachable_types(node, is_tracking_non_reachable_types);
-
       ABG_ASSERT
 	(corp.recording_types_reachable_from_public_interface_supported()
 	 == is_tracking_non_reachable_types);
@@ -1951,7 +3115,10 @@ read_corpus_from_input(read_context& ctxt)
 
   corp.set_origin(corpus::NATIVE_XML_ORIGIN);
 
-  if (call_reader_next)
+  if (ctxt.streaming_corpus())
+    // The xmlTextReader is already past the abi-corpus element.
+    ctxt.streaming_corpus(false);
+  else if (call_reader_next)
     {
       // This is the necessary counter-part of the xmlTextReaderExpand()
       // call at the beginning of the function.
@@ -1984,6 +3151,7 @@ read_corpus_group_from_input(read_context& ctxt)
 {
   corpus_group_sptr nil;
 
+  ctxt.start_loading_translation_units_concurrently();
   xml::reader_sptr reader = ctxt.get_reader();
   if (!reader)
     return nil;
@@ -2010,20 +3178,19 @@ read_corpus_group_from_input(read_context& ctxt)
   if (path_str)
     group->set_path(reinterpret_cast<char*>(path_str.get()));
 
-  xmlNodePtr node = xmlTextReaderExpand(reader.get());
-  if (!node)
-    return nil;
+  if (xmlTextReaderIsEmptyElement(reader.get()) == 1)
+    return ctxt.get_corpus_group();
 
-  //node = xml::get_first_element_sibling_if_text(node->children);
-  node = xml::advance_to_next_sibling_element(node->children);
-  ctxt.set_corpus_node(node);
+  // Rather than building the tree of XML nodes of the whole group,
+  // stream its corpora one at a time from the reader.
+  if (advance_cursor(ctxt) != 1)
+    return nil;
+  ctxt.set_corpus_node(0);
 
   corpus_sptr corp;
   while ((corp = read_corpus_from_input(ctxt)))
     ctxt.get_corpus_group()->add_corpus(corp);
 
-  xmlTextReaderNext(reader.get());
-
   return ctxt.get_corpus_group();
 }
 
@@ -3418,10 +4585,29 @@ build_type_decl(read_context&		ctxt,
     }
 
   const environment* env = ctxt.get_environment();
-  type_decl_sptr decl(new type_decl(env, name, size_in_bits,
-				    alignment_in_bits, loc));
-  decl->set_is_anonymous(is_anonymous);
-  decl->set_is_declaration_only(is_decl_only);
+  type_decl_sptr decl;
+  if (name == "void" && size_in_bits == 0 && alignment_in_bits == 0
+      && ctxt.get_corpus())
+    {
+      // The void type of a corpus is the one of the environment, just
+      // like when the corpus is built from DWARF, so that
+      // environment::is_void_type recognizes it.  It's added to the
+      // scope of the first translation unit that uses it.
+      decl = is_type_decl(env->get_void_type());
+      if (has_scope(decl))
+	{
+	  ctxt.key_type_decl(decl, id);
+	  ctxt.map_xml_node_to_decl(node, decl);
+	  return decl;
+	}
+    }
+  else
+    {
+      decl.reset(new type_decl(env, name, size_in_bits,
+			       alignment_in_bits, loc));
+      decl->set_is_anonymous(is_anonymous);
+      decl->set_is_declaration_only(is_decl_only);
+    }
   if (ctxt.push_and_key_type_decl(decl, id, add_to_current_scope))
     {
       ctxt.map_xml_node_to_decl(node, decl);
@@ -5923,6 +7109,7 @@ create_native_xml_read_context(const string& path, environment *env)
   corpus_sptr corp(new corpus(env));
   result->set_corpus(corp);
   result->set_path(path);
+  result->can_stream_corpora(true);
   return result;
 }
 
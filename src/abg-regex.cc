@@ -25,6 +25,7 @@
 
 #include "config.h"
 
+#include <cstring>
 #include <sstream>
 #include <ostream>
 
@@ -114,6 +115,140 @@ generate_from_strings(const std::vector<std::string>& strs)
   return os.str();
 }
 
+/// The characters that are special in a POSIX extended regular
+/// expression, and which are thus escaped by @ref escape.
+static const char regex_specials[] = "^.[]$()|*+?{}\\";
+
+/// Test if a character is special in a POSIX extended regular
+/// expression.
+///
+/// @param c the character to consider.
+///
+/// @return true iff @p c is special.
+static bool
+is_special(char c)
+{return c && strchr(regex_specials, c);}
+
+/// Get the set of strings matched by a regex pattern, if that pattern
+/// is equivalent to testing set membership.
+///
+/// This recognizes the patterns generated by @ref
+/// generate_from_strings, that is, "^(s1|s2|...)$", as well as the
+/// patterns of the form "^s$", where the strings are made of
+/// characters that are either not special or escaped.  A string
+/// matches such a pattern if and only if it is one of the literals
+/// returned, so the pattern can be replaced by a lookup in a set.
+///
+/// @param str the regex pattern to consider.
+///
+/// @param literals output parameter.  This is set to the strings
+/// matched by @p str, if the function returns true.
+///
+/// @return true iff @p str is equivalent to testing the membership
+/// in the set @p literals.
+bool
+get_literals(const std::string& str, std::vector<std::string>& literals)
+{
+  literals.clear();
+
+  std::string::size_type len = str.size();
+  if (len < 3 || str[0] != '^')
+    return false;
+
+  std::string::size_type i = 1;
+  bool grouped = str[i] == '(';
+  if (grouped)
+    ++i;
+
+  std::string literal;
+  for (; i < len; ++i)
+    {
+      char c = str[i];
+      if (c == '\\')
+	{
+	  // Only the escaped special characters are literals.
+	  // Sequences like "\w" or "\1" have a meaning of their own.
+	  if (i + 1 >= len || !is_special(str[i + 1]))
+	    break;
+	  literal += str[++i];
+	}
+      else if (grouped && (c == '|' || c == ')'))
+	{
+	  if (literal.empty())
+	    break;
+	  literals.push_back(literal);
+	  literal.clear();
+	  if (c == ')')
+	    {
+	      if (i + 2 == len && str[i + 1] == '$')
+		return true;
+	      break;
+	    }
+	}
+      else if (!grouped && c == '$')
+	{
+	  if (i + 1 == len && !literal.empty())
+	    {
+	      literals.push_back(literal);
+	      return true;
+	    }
+	  break;
+	}
+      else if (is_special(c))
+	break;
+      else
+	literal += c;
+    }
+
+  literals.clear();
+  return false;
+}
+
+/// Get the literal prefix of the strings matched by a regex pattern.
+///
+/// For a pattern like "^foo_bar.*", all the matched strings start
+/// with "foo_bar".  Testing that prefix is a cheap way to rule out
+/// most of the strings that cannot match the pattern.
+///
+/// @param str the regex pattern to consider.
+///
+/// @return the prefix of all the strings matched by @p str, or the
+/// empty string if none could be determined.
+std::string
+get_literal_prefix(const std::string& str)
+{
+  std::string prefix;
+  // An alternation anywhere in the pattern might apply to the
+  // anchor, like in "^foo|bar"; let's not try to be smart there.
+  if (str.empty() || str[0] != '^' || str.find('|') != std::string::npos)
+    return prefix;
+
+  std::string::size_type len = str.size();
+  for (std::string::size_type i = 1; i < len; ++i)
+    {
+      char c = str[i];
+      if (c == '\\')
+	{
+	  if (i + 1 >= len || !is_special(str[i + 1]))
+	    break;
+	  c = str[++i];
+	}
+      else if (is_special(c))
+	break;
+
+      // A character that might be repeated zero times is not part
+      // of the prefix.  One that is repeated at least once is, but
+      // it ends it.
+      char next = i + 1 < len ? str[i + 1] : 0;
+      if (next == '*' || next == '?' || next == '{')
+	break;
+      prefix += c;
+      if (next == '+')
+	break;
+    }
+  return prefix;
+}
+
 /// Compile a regex from a string.
 ///
 /// The result is held in a shared pointer. This will be null if regex
@@ -216,6 +216,150 @@ public:
 
 // </suppression_base stuff>
 
+// <literal_set stuff>
+
+/// The set of names a regular expression of a suppression
+/// specification is equivalent to, if any.
+///
+/// The regular expressions generated from KMI white lists are of the
+/// form "^(name1|name2|...)$" and can list tens of thousands of
+/// names.  Matching a name against such a regular expression amounts
+/// to looking the name up in a hash set, which is much faster than
+/// running the regular expression engine.
+class literal_set
+{
+  mutable bool				computed_;
+  mutable bool				is_literal_set_;
+  mutable unordered_set<string>		literals_;
+
+public:
+  literal_set()
+    : computed_(),
+      is_literal_set_()
+  {}
+
+  /// Getter of the set of names a regular expression is equivalent
+  /// to.
+  ///
+  /// The set is computed the first time this is invoked.
+  ///
+  /// @param regex_str the string of the regular expression to
+  /// consider.  It must be the same for all the invocations of this
+  /// function on the current instance of @ref literal_set.
+  ///
+  /// @return the set of names @p regex_str is equivalent to, or nil
+  /// if @p regex_str is not equivalent to a set of names.
+  const unordered_set<string>*
+  get(const string& regex_str) const
+  {
+    if (!computed_)
+      {
+	vector<string> literals;
+	if (regex::get_literals(regex_str, literals))
+	  {
+	    literals_.insert(literals.begin(), literals.end());
+	    is_literal_set_ = true;
+	  }
+	computed_ = true;
+      }
+    return is_literal_set_ ? &literals_ : 0;
+  }
+}; // end class literal_set
+
+bool
+regex_matches(const regex::regex_t_sptr&	regexp,
+	      const string&			regex_str,
+	      const literal_set&		literals,
+	      const string&			str);
+
+// </literal_set stuff>
+
+// <suppressions_index stuff>
+
+/// An index of the function, variable and type suppression
+/// specifications of a set of suppression specifications, keyed by
+/// the names of the ABI artifacts they can match.
+///
+/// Looking up the name of an artifact in this index yields the
+/// suppression specifications that can possibly match it: those
+/// which name property equals that name or is a regular expression
+/// equivalent to a set of names containing it, those which name
+/// property is a regular expression with a literal prefix that
+/// starts that name, and those with a name property from which no
+/// literal could be extracted.  The other suppression specifications
+/// cannot match the artifact so they don't need to be evaluated.
+class suppressions_index
+{
+public:
+  /// The kinds of names ABI artifacts are looked up by.
+  enum name_kind
+  {
+    FUNCTION_NAME,
+    FUNCTION_SYMBOL_NAME,
+    VARIABLE_NAME,
+    VARIABLE_SYMBOL_NAME,
+    TYPE_NAME,
+    NUMBER_OF_NAME_KINDS
+  };
+
+  /// Convenience typedef for a vector of indexes of suppression
+  /// specifications in a @ref suppressions_type.
+  typedef vector<size_t> suppr_indexes_type;
+
+private:
+  typedef unordered_map<string, suppr_indexes_type> string_suppr_indexes_map;
+
+  /// The index of the suppression specifications for one kind of
+  /// name.
+  struct names_index
+  {
+    string_suppr_indexes_map		exact_names;
+    string_suppr_indexes_map		prefixes;
+    vector<string::size_type>		prefix_lengths;
+    suppr_indexes_type			others;
+  };
+
+  names_index				indexes_[NUMBER_OF_NAME_KINDS];
+  bool					built_;
+
+  void
+  add_name(name_kind kind, const string& name, size_t i);
+
+  void
+  add_regex(name_kind			kind,
+	    const string&		regex_str,
+	    const literal_set&		literals,
+	    size_t			i);
+
+  void
+  add_other(name_kind kind, size_t i);
+
+public:
+  suppressions_index()
+    : built_()
+  {}
+
+  /// Test if the index has been built.
+  ///
+  /// @return true iff the index has been built.
+  bool
+  is_built() const
+  {return built_;}
+
+  void
+  build(const suppressions_type& supprs);
+
+  void
+  clear();
+
+  void
+  get_candidates(name_kind		kind,
+		 const string&		name,
+		 suppr_indexes_type&	candidates) const;
+}; // end class suppressions_index
+
+// </suppressions_index stuff>
+
 // <function_suppression stuff>
 
 class function_suppression::parameter_spec::priv
@@ -275,6 +419,10 @@ struct function_suppression::priv
   string				symbol_version_regex_str_;
   mutable regex::regex_t_sptr		symbol_version_regex_;
   bool					allow_other_aliases_;
+  literal_set				name_regex_literals_;
+  literal_set				name_not_regex_literals_;
+  literal_set				symbol_name_regex_literals_;
+  literal_set				symbol_name_not_regex_literals_;
 
   priv():
     change_kind_(ALL_CHANGE_KIND),
@@ -452,22 +600,52 @@ function_is_suppressed(const ReadContextType&	ctxt,
 		       const string&		fn_linkage_name,
 		       bool			require_drop_property = false)
 {
-  for (suppr::suppressions_type::const_iterator i =
-	 ctxt.get_suppressions().begin();
-       i != ctxt.get_suppressions().end();
-       ++i)
-    if (suppr::function_suppression_sptr suppr = is_function_suppression(*i))
-      {
-	if (require_drop_property && !(*i)->get_drops_artifact_from_ir())
-	  continue;
-	if (!fn_name.empty()
-	    && ctxt.suppression_matches_function_name(*suppr, fn_name))
-	  return true;
-	if (!fn_linkage_name.empty()
-	    && ctxt.suppression_matches_function_sym_name(*suppr,
-							  fn_linkage_name))
-	  return true;
-      }
+  const suppressions_type& supprs = ctxt.get_suppressions();
+  if (supprs.empty())
+    return false;
+
+  // Only evaluate the suppression specifications that can possibly
+  // match the names of the function.
+  const suppressions_index& index = ctxt.get_suppressions_index();
+  suppressions_index::suppr_indexes_type candidates;
+
+  if (!fn_name.empty())
+    {
+      index.get_candidates(suppressions_index::FUNCTION_NAME,
+			   fn_name, candidates);
+      for (suppressions_index::suppr_indexes_type::const_iterator i =
+	     candidates.begin();
+	   i != candidates.end();
+	   ++i)
+	{
+	  const function_suppression& suppr =
+	    static_cast<const function_suppression&>(*supprs[*i]);
+	  if (require_drop_property && !suppr.get_drops_artifact_from_ir())
+	    continue;
+	  if (ctxt.suppression_matches_function_name(suppr, fn_name))
+	    return true;
+	}
+    }
+
+  if (!fn_linkage_name.empty())
+    {
+      index.get_candidates(suppressions_index::FUNCTION_SYMBOL_NAME,
+			   fn_linkage_name, candidates);
+      for (suppressions_index::suppr_indexes_type::const_iterator i =
+	     candidates.begin();
+	   i != candidates.end();
+	   ++i)
+	{
+	  const function_suppression& suppr =
+	    static_cast<const function_suppression&>(*supprs[*i]);
+	  if (require_drop_property && !suppr.get_drops_artifact_from_ir())
+	    continue;
+	  if (ctxt.suppression_matches_function_sym_name(suppr,
+							 fn_linkage_name))
+	    return true;
+	}
+    }
+
   return false;
 }
 // </function_suppression stuff>
@@ -496,6 +674,10 @@ struct variable_suppression::priv
   string				type_name_;
   string				type_name_regex_str_;
   mutable regex::regex_t_sptr		type_name_regex_;
+  literal_set				name_regex_literals_;
+  literal_set				name_not_regex_literals_;
+  literal_set				symbol_name_regex_literals_;
+  literal_set				symbol_name_not_regex_literals_;
 
   priv(const string& name,
        const string& name_regex_str,
@@ -626,22 +808,52 @@ variable_is_suppressed(const ReadContextType&	ctxt,
 		       const string&		var_linkage_name,
 		       bool			require_drop_property = false)
 {
-  for (suppr::suppressions_type::const_iterator i =
-	 ctxt.get_suppressions().begin();
-       i != ctxt.get_suppressions().end();
-       ++i)
-    if (suppr::variable_suppression_sptr suppr = is_variable_suppression(*i))
-      {
-	if (require_drop_property && !(*i)->get_drops_artifact_from_ir())
-	  continue;
-	if (!var_name.empty()
-	    && ctxt.suppression_matches_variable_name(*suppr, var_name))
-	  return true;
-	if (!var_linkage_name.empty()
-	    && ctxt.suppression_matches_variable_sym_name(*suppr,
-							  var_linkage_name))
-	  return true;
-      }
+  const suppressions_type& supprs = ctxt.get_suppressions();
+  if (supprs.empty())
+    return false;
+
+  // Only evaluate the suppression specifications that can possibly
+  // match the names of the variable.
+  const suppressions_index& index = ctxt.get_suppressions_index();
+  suppressions_index::suppr_indexes_type candidates;
+
+  if (!var_name.empty())
+    {
+      index.get_candidates(suppressions_index::VARIABLE_NAME,
+			   var_name, candidates);
+      for (suppressions_index::suppr_indexes_type::const_iterator i =
+	     candidates.begin();
+	   i != candidates.end();
+	   ++i)
+	{
+	  const variable_suppression& suppr =
+	    static_cast<const variable_suppression&>(*supprs[*i]);
+	  if (require_drop_property && !suppr.get_drops_artifact_from_ir())
+	    continue;
+	  if (ctxt.suppression_matches_variable_name(suppr, var_name))
+	    return true;
+	}
+    }
+
+  if (!var_linkage_name.empty())
+    {
+      index.get_candidates(suppressions_index::VARIABLE_SYMBOL_NAME,
+			   var_linkage_name, candidates);
+      for (suppressions_index::suppr_indexes_type::const_iterator i =
+	     candidates.begin();
+	   i != candidates.end();
+	   ++i)
+	{
+	  const variable_suppression& suppr =
+	    static_cast<const variable_suppression&>(*supprs[*i]);
+	  if (require_drop_property && !suppr.get_drops_artifact_from_ir())
+	    continue;
+	  if (ctxt.suppression_matches_variable_sym_name(suppr,
+							 var_linkage_name))
+	    return true;
+	}
+    }
+
   return false;
 }
 
@@ -665,6 +877,8 @@ class type_suppression::priv
   string				source_location_to_keep_regex_str_;
   mutable regex::regex_t_sptr		source_location_to_keep_regex_;
   mutable vector<string>		changed_enumerator_names_;
+  literal_set				type_name_regex_literals_;
+  literal_set				type_name_not_regex_literals_;
 
   priv();
 
@@ -729,6 +943,22 @@ public:
   set_type_name_not_regex(regex::regex_t_sptr r)
   {type_name_not_regex_ = r;}
 
+  /// Getter for the set of names the 'type_name_regex' property is
+  /// equivalent to, if any.
+  ///
+  /// @return the set of names of the 'type_name_regex' property.
+  const literal_set&
+  get_type_name_regex_literals() const
+  {return type_name_regex_literals_;}
+
+  /// Getter for the set of names the 'type_name_not_regex' property
+  /// is equivalent to, if any.
+  ///
+  /// @return the set of names of the 'type_name_not_regex' property.
+  const literal_set&
+  get_type_name_not_regex_literals() const
+  {return type_name_not_regex_literals_;}
+
   /// Getter for the string that denotes the 'type_name_not_regex'
   /// property.
   ///
@@ -847,23 +1077,33 @@ type_is_suppressed(const ReadContextType&	ctxt,
 		   bool&			type_is_private,
 		   bool require_drop_property = false)
 {
-  for (suppr::suppressions_type::const_iterator i =
-	 ctxt.get_suppressions().begin();
-       i != ctxt.get_suppressions().end();
-       ++i)
-    if (suppr::type_suppression_sptr suppr = is_type_suppression(*i))
-      {
-	if (require_drop_property && !(*i)->get_drops_artifact_from_ir())
-	  continue;
-	if (ctxt.suppression_matches_type_name_or_location(*suppr, type_name,
-							   type_location))
-	  {
-	    if (is_private_type_suppr_spec(*suppr))
-	      type_is_private = true;
-
-	    return true;
-	  }
-      }
+  const suppressions_type& supprs = ctxt.get_suppressions();
+  if (!supprs.empty())
+    {
+      // Only evaluate the suppression specifications that can
+      // possibly match the name of the type.
+      suppressions_index::suppr_indexes_type candidates;
+      ctxt.get_suppressions_index().get_candidates
+	(suppressions_index::TYPE_NAME, type_name, candidates);
+      for (suppressions_index::suppr_indexes_type::const_iterator i =
+	     candidates.begin();
+	   i != candidates.end();
+	   ++i)
+	{
+	  const type_suppression& suppr =
+	    static_cast<const type_suppression&>(*supprs[*i]);
+	  if (require_drop_property && !suppr.get_drops_artifact_from_ir())
+	    continue;
+	  if (ctxt.suppression_matches_type_name_or_location(suppr, type_name,
+							     type_location))
+	    {
+	      if (is_private_type_suppr_spec(suppr))
+		type_is_private = true;
+
+	      return true;
+	    }
+	}
+    }
 
   type_is_private = false;
   return false;
@@ -1014,14 +1014,20 @@ suppression_matches_type_name(const type_suppression&	s,
 	  if (const regex_t_sptr& type_name_regex =
 	      s.priv_->get_type_name_regex())
 	    {
-	      if (!regex::match(type_name_regex, type_name))
+	      if (!regex_matches(type_name_regex,
+				 s.get_type_name_regex_str(),
+				 s.priv_->get_type_name_regex_literals(),
+				 type_name))
 		return false;
 	    }
 
 	  if (const regex_t_sptr type_name_not_regex =
 	      s.priv_->get_type_name_not_regex())
 	    {
-	      if (regex::match(type_name_not_regex, type_name))
+	      if (regex_matches(type_name_not_regex,
+				s.priv_->get_type_name_not_regex_str(),
+				s.priv_->get_type_name_not_regex_literals(),
+				type_name))
 		return false;
 	    }
 	}
@@ -2900,6 +2906,34 @@ operator|(function_suppression::change_kind l,
       (static_cast<unsigned>(l) | static_cast<unsigned>(r));
 }
 
+/// Test if a string matches a regular expression of a suppression
+/// specification.
+///
+/// If the regular expression is equivalent to a set of names, like
+/// the regular expressions generated from KMI white lists, the
+/// string is looked up in that set rather than being matched by the
+/// regular expression engine.
+///
+/// @param regexp the compiled regular expression.
+///
+/// @param regex_str the string of the regular expression @p regexp.
+///
+/// @param literals the set of names @p regex_str is equivalent to.
+///
+/// @param str the string to match.
+///
+/// @return true iff @p str matches @p regexp.
+bool
+regex_matches(const regex_t_sptr&	regexp,
+	      const string&		regex_str,
+	      const literal_set&	literals,
+	      const string&		str)
+{
+  if (const unordered_set<string>* names = literals.get(regex_str))
+    return names->find(str) != names->end();
+  return regex::match(regexp, str);
+}
+
   /// Test whether if a given function suppression matches a function
   /// designated by a regular expression that describes its name.
   ///
@@ -2917,12 +2951,14 @@ suppression_matches_function_name(const suppr::function_suppression& s,
 {
   if (regex_t_sptr regexp = s.priv_->get_name_regex())
     {
-      if (!regex::match(regexp, fn_name))
+      if (!regex_matches(regexp, s.priv_->name_regex_str_,
+			 s.priv_->name_regex_literals_, fn_name))
 	return false;
     }
   else if (regex_t_sptr regexp = s.priv_->get_name_not_regex())
     {
-      if (regex::match(regexp, fn_name))
+      if (regex_matches(regexp, s.priv_->name_not_regex_str_,
+			s.priv_->name_not_regex_literals_, fn_name))
 	return false;
     }
   else if (s.priv_->name_.empty())
@@ -2953,12 +2989,16 @@ suppression_matches_function_sym_name(const suppr::function_suppression& s,
 {
   if (regex_t_sptr regexp = s.priv_->get_symbol_name_regex())
     {
-      if (!regex::match(regexp, fn_linkage_name))
+      if (!regex_matches(regexp, s.priv_->symbol_name_regex_str_,
+			 s.priv_->symbol_name_regex_literals_,
+			 fn_linkage_name))
 	return false;
     }
   else if (regex_t_sptr regexp = s.priv_->get_symbol_name_not_regex())
     {
-      if (regex::match(regexp, fn_linkage_name))
+      if (regex_matches(regexp, s.priv_->symbol_name_not_regex_str_,
+			s.priv_->symbol_name_not_regex_literals_,
+			fn_linkage_name))
 	return false;
     }
   else if (s.priv_->symbol_name_.empty())
@@ -2986,12 +3026,14 @@ suppression_matches_variable_name(const suppr::variable_suppression& s,
 {
   if (regex_t_sptr regexp = s.priv_->get_name_regex())
     {
-      if (!regex::match(regexp, var_name))
+      if (!regex_matches(regexp, s.priv_->name_regex_str_,
+			 s.priv_->name_regex_literals_, var_name))
 	return false;
     }
   else if (regex_t_sptr regexp = s.priv_->get_name_not_regex())
     {
-      if (regex::match(regexp, var_name))
+      if (regex_matches(regexp, s.priv_->name_not_regex_str_,
+			s.priv_->name_not_regex_literals_, var_name))
 	return false;
     }
   else if (s.priv_->name_.empty())
@@ -3020,13 +3062,17 @@ suppression_matches_variable_sym_name(const suppr::variable_suppression& s,
 {
   if (regex_t_sptr regexp = s.priv_->get_symbol_name_regex())
     {
-      if (!regex::match(regexp, var_linkage_name))
+      if (!regex_matches(regexp, s.priv_->symbol_name_regex_str_,
+			 s.priv_->symbol_name_regex_literals_,
+			 var_linkage_name))
 	return false;
     }
   else if (regex_t_sptr regexp =
 	   s.priv_->get_symbol_name_not_regex())
     {
-      if (regex::match(regexp, var_linkage_name))
+      if (regex_matches(regexp, s.priv_->symbol_name_not_regex_str_,
+			s.priv_->symbol_name_not_regex_literals_,
+			var_linkage_name))
 	return false;
     }
   else if (s.priv_->symbol_name_.empty())
@@ -4471,5 +4517,217 @@ is_private_type_suppr_spec(const suppression_sptr& s)
 }
 
 // </file_suppression stuff>
+
+// <suppressions_index stuff>
+
+/// Index a suppression specification by an exact name.
+///
+/// @param kind the kind of name to index the suppression
+/// specification by.
+///
+/// @param name the name that the suppression specification matches.
+///
+/// @param i the index of the suppression specification in the
+/// vector of suppression specifications the index is built from.
+void
+suppressions_index::add_name(name_kind kind, const string& name, size_t i)
+{indexes_[kind].exact_names[name].push_back(i);}
+
+/// Index a suppression specification by a regular expression.
+///
+/// If the regular expression is equivalent to a set of names, the
+/// suppression specification is indexed by each one of these names.
+/// Otherwise, if the names matched by the regular expression all
+/// start with a literal prefix, the suppression specification is
+/// indexed by that prefix.  Otherwise, the suppression specification
+/// is a candidate for all the names.
+///
+/// @param kind the kind of name to index the suppression
+/// specification by.
+///
+/// @param regex_str the regular expression that the names matched
+/// by the suppression specification match.
+///
+/// @param literals the set of names @p regex_str is equivalent to.
+///
+/// @param i the index of the suppression specification in the
+/// vector of suppression specifications the index is built from.
+void
+suppressions_index::add_regex(name_kind		kind,
+			      const string&		regex_str,
+			      const literal_set&	literals,
+			      size_t			i)
+{
+  if (const unordered_set<string>* names = literals.get(regex_str))
+    {
+      for (unordered_set<string>::const_iterator n = names->begin();
+	   n != names->end();
+	   ++n)
+	add_name(kind, *n, i);
+      return;
+    }
+
+  string prefix = regex::get_literal_prefix(regex_str);
+  if (prefix.empty())
+    {
+      add_other(kind, i);
+      return;
+    }
+
+  names_index& index = indexes_[kind];
+  index.prefixes[prefix].push_back(i);
+  if (std::find(index.prefix_lengths.begin(),
+		index.prefix_lengths.end(),
+		prefix.size()) == index.prefix_lengths.end())
+    index.prefix_lengths.push_back(prefix.size());
+}
+
+/// Index a suppression specification that is a candidate for all the
+/// names of a given kind.
+///
+/// @param kind the kind of name to consider.
+///
+/// @param i the index of the suppression specification in the
+/// vector of suppression specifications the index is built from.
+void
+suppressions_index::add_other(name_kind kind, size_t i)
+{indexes_[kind].others.push_back(i);}
+
+/// Build the index of a vector of suppression specifications.
+///
+/// The properties used to index a suppression specification are
+/// considered in the same order as in the functions that test if
+/// the suppression specification matches a given name, like
+/// suppression_matches_function_name.
+///
+/// @param supprs the suppression specifications to index.
+void
+suppressions_index::build(const suppressions_type& supprs)
+{
+  clear();
+
+  for (size_t i = 0; i < supprs.size(); ++i)
+    {
+      const suppression_base* s = supprs[i].get();
+      if (const function_suppression* fn_suppr =
+	  dynamic_cast<const function_suppression*>(s))
+	{
+	  if (fn_suppr->priv_->get_name_regex())
+	    add_regex(FUNCTION_NAME, fn_suppr->priv_->name_regex_str_,
+		      fn_suppr->priv_->name_regex_literals_, i);
+	  else if (fn_suppr->priv_->get_name_not_regex())
+	    add_other(FUNCTION_NAME, i);
+	  else if (!fn_suppr->priv_->name_.empty())
+	    add_name(FUNCTION_NAME, fn_suppr->priv_->name_, i);
+
+	  if (fn_suppr->priv_->get_symbol_name_regex())
+	    add_regex(FUNCTION_SYMBOL_NAME,
+		      fn_suppr->priv_->symbol_name_regex_str_,
+		      fn_suppr->priv_->symbol_name_regex_literals_, i);
+	  else if (fn_suppr->priv_->get_symbol_name_not_regex())
+	    add_other(FUNCTION_SYMBOL_NAME, i);
+	  else if (!fn_suppr->priv_->symbol_name_.empty())
+	    add_name(FUNCTION_SYMBOL_NAME,
+		     fn_suppr->priv_->symbol_name_, i);
+	}
+      else if (const variable_suppression* var_suppr =
+	       dynamic_cast<const variable_suppression*>(s))
+	{
+	  if (var_suppr->priv_->get_name_regex())
+	    add_regex(VARIABLE_NAME, var_suppr->priv_->name_regex_str_,
+		      var_suppr->priv_->name_regex_literals_, i);
+	  else if (var_suppr->priv_->get_name_not_regex())
+	    add_other(VARIABLE_NAME, i);
+	  else if (!var_suppr->priv_->name_.empty())
+	    add_name(VARIABLE_NAME, var_suppr->priv_->name_, i);
+
+	  if (var_suppr->priv_->get_symbol_name_regex())
+	    add_regex(VARIABLE_SYMBOL_NAME,
+		      var_suppr->priv_->symbol_name_regex_str_,
+		      var_suppr->priv_->symbol_name_regex_literals_, i);
+	  else if (var_suppr->priv_->get_symbol_name_not_regex())
+	    add_other(VARIABLE_SYMBOL_NAME, i);
+	  else if (!var_suppr->priv_->symbol_name_.empty())
+	    add_name(VARIABLE_SYMBOL_NAME,
+		     var_suppr->priv_->symbol_name_, i);
+	}
+      else if (const type_suppression* type_suppr =
+	       dynamic_cast<const type_suppression*>(s))
+	{
+	  if (!type_suppr->get_type_name().empty())
+	    add_name(TYPE_NAME, type_suppr->get_type_name(), i);
+	  else if (type_suppr->priv_->get_type_name_regex())
+	    add_regex(TYPE_NAME, type_suppr->get_type_name_regex_str(),
+		      type_suppr->priv_->get_type_name_regex_literals(), i);
+	  else
+	    // Type suppression specifications without a name property
+	    // can still match types by their location.
+	    add_other(TYPE_NAME, i);
+	}
+    }
+
+  built_ = true;
+}
+
+/// Clear the index.
+void
+suppressions_index::clear()
+{
+  for (int k = 0; k < NUMBER_OF_NAME_KINDS; ++k)
+    {
+      names_index& index = indexes_[k];
+      index.exact_names.clear();
+      index.prefixes.clear();
+      index.prefix_lengths.clear();
+      index.others.clear();
+    }
+  built_ = false;
+}
+
+/// Get the suppression specifications that can possibly match an ABI
+/// artifact designated by a name.
+///
+/// @param kind the kind of name @p name is.
+///
+/// @param name the name of the ABI artifact to consider.
+///
+/// @param candidates output parameter.  This is set to the indexes
+/// of the suppression specifications that can match the artifact
+/// named @p name, in the order they have in the vector of
+/// suppression specifications the index was built from.
+void
+suppressions_index::get_candidates(name_kind		kind,
+				   const string&	name,
+				   suppr_indexes_type&	candidates) const
+{
+  ABG_ASSERT(built_);
+  candidates.clear();
+
+  const names_index& index = indexes_[kind];
+
+  string_suppr_indexes_map::const_iterator i = index.exact_names.find(name);
+  if (i != index.exact_names.end())
+    candidates.insert(candidates.end(), i->second.begin(), i->second.end());
+
+  for (vector<string::size_type>::const_iterator l =
+	 index.prefix_lengths.begin();
+       l != index.prefix_lengths.end();
+       ++l)
+    {
+      if (*l > name.size())
+	continue;
+      i = index.prefixes.find(name.substr(0, *l));
+      if (i != index.prefixes.end())
+	candidates.insert(candidates.end(),
+			  i->second.begin(), i->second.end());
+    }
+
+  candidates.insert(candidates.end(),
+		    index.others.begin(), index.others.end());
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+// </suppressions_index stuff>
 }// end namespace suppr
 } // end namespace abigail
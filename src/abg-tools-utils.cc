@@ -59,6 +59,7 @@
 
 
 #include "abg-dwarf-reader.h"
+#include "abg-workers.h"
 #include "abg-internal.h"
 #include "abg-cxx-compat.h"
 #include "abg-regex.h"
@@ -249,6 +250,17 @@ time_t
 timer::value_in_seconds() const
 {return priv_->end_timeval.tv_sec - priv_->begin_timeval.tv_sec;}
 
+/// Get the elapsed time in milliseconds.
+///
+/// @return the time elapsed between the invocation of the methods
+/// timer::start() and timer::stop, in milliseconds.
+size_t
+timer::value_in_milliseconds() const
+{
+  return (priv_->end_timeval.tv_sec - priv_->begin_timeval.tv_sec) * 1000
+    + (priv_->end_timeval.tv_usec - priv_->begin_timeval.tv_usec) / 1000;
+}
+
 /// Get the elapsed time in hour:minutes:seconds:milliseconds.
 ///
 /// @param hours out parameter. This is set to the number of hours elapsed.
@@ -1323,6 +1335,51 @@ get_random_number_as_string()
   return o.str();
 }
 
+/// Emit a set of memory statistics, as a table of counts and sizes
+/// per kind of object.
+///
+/// The sizes of the kinds of objects that are only counted with
+/// their shallow size are flagged as such, and so is the total when
+/// it includes some of them, as it is then a lower bound.
+///
+/// @param stats the memory statistics to emit.
+///
+/// @param title the title of the table.
+///
+/// @param out the output stream to emit the statistics to.
+void
+emit_memory_stats(const ir::memory_stats_type& stats,
+		  const string& title,
+		  ostream& out)
+{
+  size_t total_count = 0, total_bytes = 0;
+  bool has_shallow = false;
+
+  out << "memory statistics for " << title << ":\n";
+  for (ir::memory_stats_type::const_iterator i = stats.begin();
+       i != stats.end();
+       ++i)
+    {
+      out << "  " << i->kind << ": "
+	  << i->count << " objects, "
+	  << i->bytes << " bytes";
+      if (i->shallow)
+	out << " (shallow)";
+      out << "\n";
+      total_count += i->count;
+      total_bytes += i->bytes;
+      has_shallow = has_shallow || i->shallow;
+    }
+  out << "  total: "
+      << total_count << " objects, "
+      << (has_shallow ? "at least " : "")
+      << total_bytes << " bytes (approximately "
+      << (total_bytes + 1023) / 1024 << " KiB)\n";
+  if (has_shallow)
+    out << "  (shallow: size of the objects themselves, not counting"
+	   " the private data, containers and strings they own)\n";
+}
+
 ostream&
 operator<<(ostream& output,
 	   file_type r)
@@ -1905,8 +1962,8 @@ gen_suppr_spec_from_headers(const string& headers_root_dir)
   return gen_suppr_spec_from_headers(headers_root_dir, header_files);
 }
 
-/// Generate a suppression specification from kernel abi whitelist
-/// files.
+/// Load the names of the functions and variables listed in kernel
+/// abi whitelist files.
 ///
 /// A kernel ABI whitelist file is an INI file that usually has only
 /// one section.  The name of the section is a string that ends up
@@ -1918,24 +1975,18 @@ gen_suppr_spec_from_headers(const string& headers_root_dir)
 /// name of a function or a variable whose changes are to be keept.
 ///
 /// A whitelist file can have multiple sections (adhering to the naming
-/// conventions and multiple files can be passed. The suppression that
-/// is created takes all whitelist sections from all files into account.
-/// Symbols (or expression of such) are deduplicated in the final
-/// suppression expression.
-///
-/// This function reads the white lists and generates a
-/// function_suppression_sptr and variable_suppression_sptr and returns
-/// a vector containing those.
+/// conventions and multiple files can be passed.  The names of all
+/// whitelist sections from all files are loaded, and deduplicated.
 ///
 /// @param abi_whitelist_paths a vector of KMI whitelist paths
 ///
-/// @return a vector or suppressions
-suppressions_type
-gen_suppr_spec_from_kernel_abi_whitelists
-   (const std::vector<std::string>& abi_whitelist_paths)
+/// @param whitelisted_names output parameter.  This is set to the
+/// sorted names listed in the white lists at @p abi_whitelist_paths.
+void
+load_kernel_abi_whitelists(const vector<string>& abi_whitelist_paths,
+			   vector<string>& whitelisted_names)
 {
-
-  std::vector<std::string> whitelisted_names;
+  whitelisted_names.clear();
   for (std::vector<std::string>::const_iterator
 	   path_iter = abi_whitelist_paths.begin(),
 	   path_end = abi_whitelist_paths.end();
@@ -1977,15 +2028,50 @@ gen_suppr_spec_from_kernel_abi_whitelists
 	}
     }
 
+  std::sort(whitelisted_names.begin(), whitelisted_names.end());
+  whitelisted_names.erase(std::unique(whitelisted_names.begin(),
+				      whitelisted_names.end()),
+			  whitelisted_names.end());
+}
+
+/// Generate a suppression specification from kernel abi whitelist
+/// files.
+///
+/// This function reads the white lists using
+/// load_kernel_abi_whitelists and generates a
+/// function_suppression_sptr and variable_suppression_sptr and returns
+/// a vector containing those.
+///
+/// @param abi_whitelist_paths a vector of KMI whitelist paths
+///
+/// @return a vector or suppressions
+suppressions_type
+gen_suppr_spec_from_kernel_abi_whitelists
+   (const std::vector<std::string>& abi_whitelist_paths)
+{
+  std::vector<std::string> whitelisted_names;
+  load_kernel_abi_whitelists(abi_whitelist_paths, whitelisted_names);
+  return gen_suppr_spec_from_kernel_abi_whitelisted_names(whitelisted_names);
+}
+
+/// Generate a suppression specification from the names of the
+/// functions and variables listed in kernel abi whitelists.
+///
+/// The function_suppression_sptr and variable_suppression_sptr
+/// generated only keep the functions and variables which ELF symbol
+/// names are listed in the white lists.
+///
+/// @param whitelisted_names the sorted and deduplicated names listed
+/// in the white lists, as returned by load_kernel_abi_whitelists.
+///
+/// @return a vector or suppressions
+suppressions_type
+gen_suppr_spec_from_kernel_abi_whitelisted_names
+   (const std::vector<std::string>& whitelisted_names)
+{
   suppressions_type result;
   if (!whitelisted_names.empty())
     {
-      // Drop duplicates to simplify the regex we are generating
-      std::sort(whitelisted_names.begin(), whitelisted_names.end());
-      whitelisted_names.erase(std::unique(whitelisted_names.begin(),
-					  whitelisted_names.end()),
-			      whitelisted_names.end());
-
       // Build a regular expression representing the union of all
       // the function and variable names expressed in the white list.
       const std::string regex = regex::generate_from_strings(whitelisted_names);
@@ -2167,19 +2253,17 @@ find_file_under_dir(const string& root_dir,
 /// we were given.  If empty, it means we were not given any
 /// suppression specification path.
 ///
-/// @param kabi_whitelist_paths paths to kabi whitelist files that we
-/// were given.  If empty, it means we were not given any kabi
-/// whitelist.
+/// @param kabi_whitelisted_names the names loaded from the kabi
+/// whitelist files that we were given.  If empty, it means we were
+/// not given any kabi whitelist.
 ///
 /// @param supprs the suppressions specifications resulting from
 /// parsing the suppression specification files at @p suppr_paths and
-/// the kabi whitelist at @p kabi_whitelist_paths.
-///
-/// @param opts the options to consider.
+/// the kabi whitelist names @p kabi_whitelisted_names.
 static void
 load_generate_apply_suppressions(dwarf_reader::read_context &read_ctxt,
 				 vector<string>& suppr_paths,
-				 vector<string>& kabi_whitelist_paths,
+				 const vector<string>& kabi_whitelisted_names,
 				 suppressions_type& supprs)
 {
   if (supprs.empty())
@@ -2190,7 +2274,8 @@ load_generate_apply_suppressions(dwarf_reader::read_context &read_ctxt,
 	read_suppressions(*i, supprs);
 
       const suppressions_type& wl_suppr =
-	  gen_suppr_spec_from_kernel_abi_whitelists(kabi_whitelist_paths);
+	gen_suppr_spec_from_kernel_abi_whitelisted_names
+	(kabi_whitelisted_names);
 
       supprs.insert(supprs.end(), wl_suppr.begin(), wl_suppr.end());
     }
@@ -2457,6 +2542,76 @@ get_binary_paths_from_kernel_dist(const string&	dist_root,
 					   module_paths);
 }
 
+/// A task that loads the ELF and debug info files of a Linux kernel
+/// module ahead of the construction of its corpus.
+struct module_preload_task : public workers::task
+{
+  dwarf_reader::read_context_sptr ctxt;
+
+  module_preload_task(const dwarf_reader::read_context_sptr& c)
+    : ctxt(c)
+  {}
+
+  virtual void
+  perform()
+  {dwarf_reader::preload_debug_info(*ctxt);}
+};// end struct module_preload_task
+
+/// Create the read contexts of a range of Linux kernel modules and
+/// load their ELF and debug info files using worker threads.
+///
+/// @param modules the paths of all the kernel modules.
+///
+/// @param from the index (in @p modules) of the first module of the
+/// range to consider.
+///
+/// @param nb_modules the number of modules in the range.
+///
+/// @param di_roots the root directories under which to look for the
+/// debug info of the modules.
+///
+/// @param env the environment the corpora of the modules are to be
+/// created in.
+///
+/// @param model the read context the read contexts created take
+/// their options from, just like if they were re-used from it by
+/// reset_read_context.
+///
+/// @param contexts output parameter.  The read contexts created are
+/// set at the index of their module in this vector.
+///
+/// @return the queue of the worker threads that load the files, or
+/// nil if the range is empty.  The files are loaded once
+/// queue::wait_for_workers_to_complete() returns.
+static abg_compat::shared_ptr<workers::queue>
+preload_kernel_modules(const vector<string>&	modules,
+		       size_t			from,
+		       size_t			nb_modules,
+		       const vector<char**>&	di_roots,
+		       environment_sptr&	env,
+		       const dwarf_reader::read_context& model,
+		       vector<dwarf_reader::read_context_sptr>& contexts)
+{
+  abg_compat::shared_ptr<workers::queue> result;
+  size_t end = std::min(from + nb_modules, modules.size());
+  if (from >= end)
+    return result;
+
+  result.reset(new workers::queue(end - from));
+  for (size_t i = from; i < end; ++i)
+    {
+      contexts[i] =
+	dwarf_reader::create_read_context(modules[i], di_roots, env.get(),
+					  /*read_all_types=*/false,
+					  /*linux_kernel_mode=*/true);
+      dwarf_reader::set_read_context_options_from(*contexts[i], model);
+      result->schedule_task(workers::task_sptr
+			    (new module_preload_task(contexts[i])));
+    }
+
+  return result;
+}
+
 /// Walk a given directory and build an instance of @ref corpus_group
 /// from the vmlinux kernel binary and the linux kernel modules found
 /// under that directory and under its sub-directories, recursively.
@@ -2491,6 +2646,13 @@ get_binary_paths_from_kernel_dist(const string&	dist_root,
 /// messages.
 ///
 /// @param env the environment to create the corpus_group in.
+///
+/// @param num_threads the number of threads to use.  If it's greater
+/// than one, the ELF and debug info files of the kernel modules are
+/// loaded by that many worker threads, ahead of the construction of
+/// the corpora of the modules.  Note that the corpora themselves are
+/// still built one after the other, in a deterministic order, as
+/// they all populate the same environment.
 corpus_group_sptr
 build_corpus_group_from_kernel_dist_under(const string&	root,
 					  const string		debug_info_root,
@@ -2499,7 +2661,8 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
 					  vector<string>&	kabi_wl_paths,
 					  suppressions_type&	supprs,
 					  bool			verbose,
-					  environment_sptr&	env)
+					  environment_sptr&	env,
+					  size_t		num_threads)
 {
   string vmlinux = vmlinux_path;
   corpus_group_sptr result;
@@ -2529,6 +2692,11 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
       di_roots.push_back(&di_root_ptr);
       abigail::dwarf_reader::status status = abigail::dwarf_reader::STATUS_OK;
       corpus_group_sptr group;
+      // The names of the KMI white lists are looked up in a hash set
+      // by the DWARF reader, which then skips the functions and
+      // variables which symbols are not in it, before building any
+      // part of their IR.
+      dwarf_reader::symbol_names_set_sptr kabi_whitelist;
       if (!vmlinux.empty())
 	{
 	  ctxt =
@@ -2538,8 +2706,15 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
 	  dwarf_reader::set_do_log(*ctxt, verbose);
 
 	  t.start();
+	  vector<string> kabi_whitelisted_names;
+	  load_kernel_abi_whitelists(kabi_wl_paths, kabi_whitelisted_names);
+	  if (!kabi_whitelisted_names.empty())
+	    kabi_whitelist.reset
+	      (new dwarf_reader::symbol_names_set_type
+	       (kabi_whitelisted_names.begin(), kabi_whitelisted_names.end()));
 	  load_generate_apply_suppressions(*ctxt, suppr_paths,
-					   kabi_wl_paths, supprs);
+					   kabi_whitelisted_names, supprs);
+	  set_kernel_abi_whitelist(*ctxt, kabi_whitelist);
 	  t.stop();
 
 	  if (verbose)
@@ -2575,22 +2750,44 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
       if (!group->is_empty())
 	{
 	  // Now add the corpora of the modules to the corpus group.
-	  int total_nb_modules = modules.size();
-	  int cur_module_index = 1;
-	  for (vector<string>::const_iterator m = modules.begin();
-	       m != modules.end();
-	       ++m, ++cur_module_index)
+	  //
+	  // The modules are handled by batches of num_threads
+	  // modules.  While the corpora of the modules of a batch are
+	  // being built, worker threads load the ELF and debug info
+	  // files of the modules of the next batch.
+	  size_t total_nb_modules = modules.size();
+	  size_t batch_size = num_threads > 1 ? num_threads : 0;
+	  vector<dwarf_reader::read_context_sptr> contexts(total_nb_modules);
+	  abg_compat::shared_ptr<workers::queue> preloader =
+	    preload_kernel_modules(modules, 0, batch_size,
+				   di_roots, env, *ctxt, contexts);
+	  for (size_t i = 0; i < total_nb_modules; ++i)
 	    {
+	      if (batch_size && i % batch_size == 0)
+		{
+		  preloader->wait_for_workers_to_complete();
+		  preloader = preload_kernel_modules(modules, i + batch_size,
+						     batch_size, di_roots,
+						     env, *ctxt, contexts);
+		}
+
+	      const string& m = modules[i];
 	      if (verbose)
 		std::cerr << "reading module '"
-			  << *m << "' ("
-			  << cur_module_index
+			  << m << "' ("
+			  << i + 1
 			  << "/" << total_nb_modules
 			  << ") ... " << std::flush;
 
-	      reset_read_context(ctxt, *m, di_roots, env.get(),
-				 /*read_all_types=*/false,
-				 /*linux_kernel_mode=*/true);
+	      if (contexts[i])
+		{
+		  ctxt = contexts[i];
+		  contexts[i].reset();
+		}
+	      else
+		reset_read_context(ctxt, m, di_roots, env.get(),
+				   /*read_all_types=*/false,
+				   /*linux_kernel_mode=*/true);
 
 	      // If we have been given a whitelist of functions and
 	      // variable symbols to look at, then we can avoid loading
@@ -2599,8 +2796,11 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
 
 	      set_ignore_symbol_table(*ctxt, do_ignore_symbol_table);
 
-	      load_generate_apply_suppressions(*ctxt, suppr_paths,
-					       kabi_wl_paths, supprs);
+	      // The suppression specifications and the white lists
+	      // have been parsed once and for all while reading
+	      // vmlinux.
+	      add_read_context_suppressions(*ctxt, supprs);
+	      set_kernel_abi_whitelist(*ctxt, kabi_whitelist);
 
 	      set_read_context_corpus_group(*ctxt, group);
 
@@ -2610,7 +2810,7 @@ build_corpus_group_from_kernel_dist_under(const string&	root,
 	      t.stop();
 	      if (verbose)
 		std::cerr << "module '"
-			  << *m
+			  << m
 			  << "' reading DONE: "
 			  << t << "\n";
 	    }
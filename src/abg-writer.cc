@@ -2246,6 +2246,9 @@ write_translation_unit(write_context&	       ctxt,
       << translation_unit_language_to_string(tu.get_language())
       <<"'";
 
+  if (!tu.get_content_hash().empty())
+    o << " content-hash='" << tu.get_content_hash() << "'";
+
   if (tu.is_empty())
     {
       o << "/>\n";
@@ -0,0 +1,742 @@
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+//
+// This file is part of the GNU Application Binary Interface Generic
+// Analysis and Instrumentation Library (libabigail).  This library is
+// free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option) any
+// later version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program; see the file COPYING-LGPLV3.  If
+// not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+///
+/// This program benchmarks the main phases of the pipeline of
+/// libabigail: reading DWARF (including the late canonicalization of
+/// types), writing and reading ABIXML and comparing corpora.
+///
+/// The inputs are pairs of binaries taken from tests/data, as well as
+/// a pair of big synthetic ABIXML corpora that are generated on the
+/// fly.  Each benchmark is run in its own process, so that the peak
+/// resident set size reported for it is its own.
+///
+/// The results are emitted on the standard output in the JSON Lines
+/// format: one JSON object per benchmark, which carries the name of
+/// the benchmark, its input, its wall time and peak RSS, and a set of
+/// counters that are specific to the benchmark.  This makes the
+/// results easy to store and to compare across commits.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "abg-comparison.h"
+#include "abg-dwarf-reader.h"
+#include "abg-reader.h"
+#include "abg-tools-utils.h"
+#include "abg-writer.h"
+#include "test-utils.h"
+
+using std::string;
+using std::vector;
+using std::ostream;
+using std::ofstream;
+using std::ostringstream;
+using std::cout;
+using std::cerr;
+using abigail::ir::environment;
+using abigail::ir::environment_sptr;
+using abigail::corpus_sptr;
+using abigail::comparison::diff_context;
+using abigail::comparison::diff_context_sptr;
+using abigail::comparison::corpus_diff;
+using abigail::comparison::corpus_diff_sptr;
+using abigail::comparison::compute_diff;
+using abigail::tools_utils::timer;
+using abigail::tests::get_src_dir;
+using abigail::tests::get_build_dir;
+
+/// The pairs of binaries of tests/data the benchmarks are run on.
+struct InOutSpec
+{
+  const char* in_elfv0_path;
+  const char* in_elfv1_path;
+};
+
+InOutSpec in_out_specs[] =
+{
+  {
+    "data/test-diff-filter/test31-pr18535-libstdc++-4.8.3.so",
+    "data/test-diff-filter/test31-pr18535-libstdc++-4.9.2.so"
+  },
+  {
+    "data/test-diff-dwarf/PR25058-liblttng-ctl2.10.so",
+    "data/test-diff-dwarf/PR25058-liblttng-ctl.so"
+  },
+  {
+    "data/test-diff-dwarf-abixml/PR25409-librte_bus_dpaa.so.20.0",
+    "data/test-diff-dwarf-abixml/PR25409-librte_bus_dpaa.so.20.0"
+  },
+  // This should be the last entry.
+  {0, 0}
+};
+
+/// The options of the benchmark driver.
+struct options
+{
+  bool		display_usage;
+  bool		builtin_inputs;
+  size_t	synthetic_size;
+  string	output_path;
+  vector<string> elf_paths;
+
+  options()
+    : display_usage(),
+      builtin_inputs(true),
+      synthetic_size(20000)
+  {}
+};
+
+/// The result of a benchmark.
+struct bench_result
+{
+  string			benchmark;
+  string			input;
+  size_t			wall_time_ms;
+  vector<std::pair<string, size_t> >	counters;
+
+  bench_result(const string& b, const string& i)
+    : benchmark(b), input(i), wall_time_ms()
+  {}
+
+  /// Add a counter to the result.
+  ///
+  /// @param name the name of the counter.
+  ///
+  /// @param value the value of the counter.
+  void
+  add_counter(const string& name, size_t value)
+  {counters.push_back(std::make_pair(name, value));}
+};
+
+/// Emit a string as a JSON string.
+///
+/// @param s the string to emit.
+///
+/// @param out the output stream to emit the string to.
+static void
+emit_json_string(const string& s, ostream& out)
+{
+  out << '"';
+  for (string::const_iterator i = s.begin(); i != s.end(); ++i)
+    {
+      if (*i == '"' || *i == '\\')
+	out << '\\';
+      out << *i;
+    }
+  out << '"';
+}
+
+/// Emit the result of a benchmark as a JSON object on one line.
+///
+/// @param r the result to emit.
+///
+/// @param peak_rss_kb the peak resident set size of the process that
+/// ran the benchmark, in kilobytes.
+///
+/// @param out the output stream to emit the result to.
+static void
+emit_result(const bench_result& r, size_t peak_rss_kb, ostream& out)
+{
+  out << "{\"benchmark\": ";
+  emit_json_string(r.benchmark, out);
+  out << ", \"input\": ";
+  emit_json_string(r.input, out);
+  out << ", \"wall_time_ms\": " << r.wall_time_ms
+      << ", \"peak_rss_kb\": " << peak_rss_kb
+      << ", \"counters\": {";
+  for (vector<std::pair<string, size_t> >::const_iterator i =
+	 r.counters.begin();
+       i != r.counters.end();
+       ++i)
+    {
+      if (i != r.counters.begin())
+	out << ", ";
+      emit_json_string(i->first, out);
+      out << ": " << i->second;
+    }
+  out << "}}\n";
+}
+
+/// Add the counters of the type canonicalizer of an environment, as
+/// well as the memory used by a corpus, to the result of a benchmark.
+///
+/// @param env the environment to consider.
+///
+/// @param corp the corpus to consider.
+///
+/// @param r the result to add the counters to.
+static void
+add_corpus_counters(const environment& env,
+		    const corpus_sptr& corp,
+		    bench_result& r)
+{
+  size_t num_buckets = 0, num_canonical_types = 0,
+    longest_bucket_length = 0, num_deep_comparisons = 0,
+    num_avoided_comparisons = 0;
+  env.get_canonical_types_stats(num_buckets, num_canonical_types,
+				longest_bucket_length,
+				num_deep_comparisons,
+				num_avoided_comparisons);
+  r.add_counter("canonical-types", num_canonical_types);
+  r.add_counter("deep-type-comparisons", num_deep_comparisons);
+  r.add_counter("avoided-type-comparisons", num_avoided_comparisons);
+
+  if (!corp)
+    return;
+
+  r.add_counter("functions", corp->get_functions().size());
+  r.add_counter("variables", corp->get_variables().size());
+
+  abigail::ir::memory_stats_type stats;
+  abigail::ir::get_memory_stats(*corp, stats);
+  size_t num_bytes = 0;
+  for (abigail::ir::memory_stats_type::const_iterator i = stats.begin();
+       i != stats.end();
+       ++i)
+    num_bytes += i->bytes;
+  r.add_counter("ir-bytes", num_bytes);
+}
+
+/// Read a corpus from an ELF file.
+///
+/// @param path the path to the ELF file.
+///
+/// @param env the environment to build the corpus in.
+///
+/// @param r if non-nil, the result to add the time spent in each
+/// phase of the DWARF reader to.
+///
+/// @return the resulting corpus.
+static corpus_sptr
+read_corpus_from_elf(const string& path,
+		     environment_sptr& env,
+		     bench_result* r = 0)
+{
+  vector<char**> di_roots;
+  abigail::dwarf_reader::read_context_sptr ctxt =
+    abigail::dwarf_reader::create_read_context(path, di_roots, env.get());
+  abigail::dwarf_reader::status s = abigail::dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr corp = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, s);
+
+  if (r)
+    {
+      const abigail::dwarf_reader::phase_timings_type& timings =
+	abigail::dwarf_reader::get_phase_timings(*ctxt);
+      for (abigail::dwarf_reader::phase_timings_type::const_iterator i =
+	     timings.begin();
+	   i != timings.end();
+	   ++i)
+	r->add_counter(i->first + "-ms", i->second);
+    }
+
+  return corp;
+}
+
+/// Write a corpus into an ABIXML file.
+///
+/// @param corp the corpus to write.
+///
+/// @param path the path to the ABIXML file to write.
+///
+/// @return the number of bytes written or zero upon error.
+static size_t
+write_abixml(const corpus_sptr& corp, const string& path)
+{
+  ofstream of(path.c_str(), std::ios_base::trunc);
+  abigail::xml_writer::write_context_sptr ctxt =
+    abigail::xml_writer::create_write_context(corp->get_environment(), of);
+  if (!abigail::xml_writer::write_corpus(*ctxt, corp, 0))
+    return 0;
+  return of.tellp();
+}
+
+/// Benchmark the reading of an ELF binary.
+///
+/// @param path the path to the binary.
+///
+/// @param r the result of the benchmark.
+///
+/// @return true iff the benchmark ran successfully.
+static bool
+bench_read_dwarf(const string& path, bench_result& r)
+{
+  environment_sptr env(new environment);
+  timer t(timer::START_ON_INSTANTIATION_TIMER_KIND);
+  corpus_sptr corp = read_corpus_from_elf(path, env, &r);
+  t.stop();
+  r.wall_time_ms = t.value_in_milliseconds();
+  add_corpus_counters(*env, corp, r);
+  return static_cast<bool>(corp);
+}
+
+/// Benchmark the writing of the ABIXML of an ELF binary.
+///
+/// @param path the path to the binary.
+///
+/// @param abixml_path the path to the ABIXML file to write.
+///
+/// @param r the result of the benchmark.
+///
+/// @return true iff the benchmark ran successfully.
+static bool
+bench_write_abixml(const string& path,
+		   const string& abixml_path,
+		   bench_result& r)
+{
+  environment_sptr env(new environment);
+  corpus_sptr corp = read_corpus_from_elf(path, env);
+  if (!corp)
+    return false;
+
+  timer t(timer::START_ON_INSTANTIATION_TIMER_KIND);
+  size_t num_bytes = write_abixml(corp, abixml_path);
+  t.stop();
+  r.wall_time_ms = t.value_in_milliseconds();
+  r.add_counter("bytes-written", num_bytes);
+  return num_bytes;
+}
+
+/// Benchmark the reading of an ABIXML file.
+///
+/// @param path the path to the ABIXML file.
+///
+/// @param r the result of the benchmark.
+///
+/// @return true iff the benchmark ran successfully.
+static bool
+bench_read_abixml(const string& path, bench_result& r)
+{
+  environment_sptr env(new environment);
+  timer t(timer::START_ON_INSTANTIATION_TIMER_KIND);
+  corpus_sptr corp =
+    abigail::xml_reader::read_corpus_from_native_xml_file(path, env.get());
+  t.stop();
+  r.wall_time_ms = t.value_in_milliseconds();
+  add_corpus_counters(*env, corp, r);
+  return static_cast<bool>(corp);
+}
+
+/// Benchmark the comparison of two corpora.
+///
+/// The corpora are read from ELF binaries or from ABIXML files,
+/// depending on the @p from_abixml parameter.  Only the computation
+/// of the diff and the application of the filters and suppressions
+/// are timed.
+///
+/// @param path1 the path to the first input.
+///
+/// @param path2 the path to the second input.
+///
+/// @param from_abixml true iff the inputs are ABIXML files.
+///
+/// @param r the result of the benchmark.
+///
+/// @return true iff the benchmark ran successfully.
+static bool
+bench_diff(const string& path1,
+	   const string& path2,
+	   bool from_abixml,
+	   bench_result& r)
+{
+  environment_sptr env(new environment);
+  corpus_sptr c1, c2;
+  if (from_abixml)
+    {
+      c1 = abigail::xml_reader::read_corpus_from_native_xml_file(path1,
+								 env.get());
+      c2 = abigail::xml_reader::read_corpus_from_native_xml_file(path2,
+								 env.get());
+    }
+  else
+    {
+      c1 = read_corpus_from_elf(path1, env);
+      c2 = read_corpus_from_elf(path2, env);
+    }
+  if (!c1 || !c2)
+    return false;
+
+  diff_context_sptr ctxt(new diff_context);
+  timer t(timer::START_ON_INSTANTIATION_TIMER_KIND);
+  corpus_diff_sptr d = compute_diff(c1, c2, ctxt);
+  const corpus_diff::diff_stats& s =
+    d->apply_filters_and_suppressions_before_reporting();
+  t.stop();
+  r.wall_time_ms = t.value_in_milliseconds();
+  r.add_counter("removed-functions", s.net_num_func_removed());
+  r.add_counter("added-functions", s.net_num_func_added());
+  r.add_counter("changed-functions", s.net_num_func_changed());
+  r.add_counter("removed-variables", s.net_num_vars_removed());
+  r.add_counter("added-variables", s.net_num_vars_added());
+  r.add_counter("changed-variables", s.net_num_vars_changed());
+  return true;
+}
+
+/// Generate a synthetic ABIXML corpus.
+///
+/// The corpus is made of translation units of 100 structs each.
+/// Each struct has an int data member and a pointer to the previous
+/// struct of its chain of 10 structs.  Each struct is also the
+/// parameter of an exported function.  In the second version of the
+/// corpus, the last struct of each chain gets an additional data
+/// member, so that comparing both versions yields changes in a tenth
+/// of the functions.
+///
+/// @param num_structs the number of structs of the corpus.
+///
+/// @param version the version of the corpus, either 0 or 1.
+///
+/// @param path the path to the ABIXML file to write the corpus to.
+///
+/// @return true upon successful completion.
+static bool
+generate_synthetic_abixml(size_t num_structs,
+			  int version,
+			  const string& path)
+{
+  ofstream o(path.c_str(), std::ios_base::trunc);
+  if (!o.is_open())
+    return false;
+
+  o << "<abi-corpus path='synthetic-v" << version << ".so'"
+    << " architecture='elf-amd-x86_64'>\n"
+    << "  <elf-function-symbols>\n";
+  for (size_t i = 0; i < num_structs; ++i)
+    o << "    <elf-symbol name='fn_" << i << "' type='func-type'"
+      << " binding='global-binding' visibility='default-visibility'"
+      << " is-defined='yes'/>\n";
+  o << "  </elf-function-symbols>\n";
+
+  const size_t num_structs_per_tu = 100, num_structs_per_chain = 10;
+  size_t id = 0, int_id = 0;
+  for (size_t i = 0; i < num_structs; ++i)
+    {
+      if (i % num_structs_per_tu == 0)
+	{
+	  if (i)
+	    o << "  </abi-instr>\n";
+	  o << "  <abi-instr version='1.0' address-size='64'"
+	    << " path='synthetic-" << i / num_structs_per_tu << ".c'"
+	    << " language='LANG_C99'>\n"
+	    << "    <type-decl name='int' size-in-bits='32'"
+	    << " id='type-id-" << (int_id = ++id) << "'/>\n";
+	}
+      bool is_first_of_chain = i % num_structs_per_chain == 0;
+      bool has_new_member =
+	version && i % num_structs_per_chain == num_structs_per_chain - 1;
+      size_t struct_id = ++id, ptr_id = ++id;
+
+      o << "    <class-decl name='s_" << i << "' size-in-bits='"
+	<< (has_new_member ? 192 : 128) << "' is-struct='yes'"
+	<< " visibility='default' id='type-id-" << struct_id << "'>\n"
+	<< "      <data-member access='public' layout-offset-in-bits='0'>\n"
+	<< "        <var-decl name='m0' type-id='type-id-" << int_id << "'"
+	<< " visibility='default'/>\n"
+	<< "      </data-member>\n"
+	<< "      <data-member access='public' layout-offset-in-bits='64'>\n"
+	<< "        <var-decl name='prev' type-id='type-id-"
+	<< (is_first_of_chain ? ptr_id : struct_id - 1) << "'"
+	<< " visibility='default'/>\n"
+	<< "      </data-member>\n";
+      if (has_new_member)
+	o << "      <data-member access='public'"
+	  << " layout-offset-in-bits='128'>\n"
+	  << "        <var-decl name='m1' type-id='type-id-" << int_id << "'"
+	  << " visibility='default'/>\n"
+	  << "      </data-member>\n";
+      o << "    </class-decl>\n"
+	<< "    <pointer-type-def type-id='type-id-" << struct_id << "'"
+	<< " size-in-bits='64' id='type-id-" << ptr_id << "'/>\n"
+	<< "    <function-decl name='fn_" << i << "' mangled-name='fn_" << i
+	<< "' visibility='default' binding='global' size-in-bits='64'"
+	<< " elf-symbol-id='fn_" << i << "'>\n"
+	<< "      <parameter type-id='type-id-" << ptr_id << "'/>\n"
+	<< "      <return type-id='type-id-" << int_id << "'/>\n"
+	<< "    </function-decl>\n";
+    }
+  if (num_structs)
+    o << "  </abi-instr>\n";
+  o << "</abi-corpus>\n";
+
+  return o.good();
+}
+
+/// The kinds of benchmarks.
+enum bench_kind
+{
+  READ_DWARF_BENCH,
+  WRITE_ABIXML_BENCH,
+  READ_ABIXML_BENCH,
+  DIFF_DWARF_BENCH,
+  DIFF_ABIXML_BENCH
+};
+
+/// Run a benchmark in a child process and emit its result.
+///
+/// @param kind the kind of benchmark to run.
+///
+/// @param path1 the first input of the benchmark.
+///
+/// @param path2 the second input of the benchmark, if any.  For the
+/// benchmark of the writing of ABIXML, this is the path to the ABIXML
+/// file to write.
+///
+/// @param out the output stream to emit the result to.
+///
+/// @return true iff the benchmark ran successfully.
+static bool
+run_bench(bench_kind kind,
+	  const string& path1,
+	  const string& path2,
+	  ostream& out)
+{
+  static const char* names[] =
+    {"read-dwarf", "write-abixml", "read-abixml", "diff-dwarf", "diff-abixml"};
+
+  string input;
+  abigail::tools_utils::base_name(path1, input);
+  if (kind == DIFF_DWARF_BENCH || kind == DIFF_ABIXML_BENCH)
+    {
+      string input2;
+      abigail::tools_utils::base_name(path2, input2);
+      input += " " + input2;
+    }
+
+  int fds[2];
+  if (pipe(fds))
+    return false;
+
+  out.flush();
+  pid_t pid = fork();
+  if (pid < 0)
+    return false;
+
+  if (pid == 0)
+    {
+      close(fds[0]);
+      bench_result r(names[kind], input);
+      bool ok = false;
+      switch (kind)
+	{
+	case READ_DWARF_BENCH:
+	  ok = bench_read_dwarf(path1, r);
+	  break;
+	case WRITE_ABIXML_BENCH:
+	  ok = bench_write_abixml(path1, path2, r);
+	  break;
+	case READ_ABIXML_BENCH:
+	  ok = bench_read_abixml(path1, r);
+	  break;
+	case DIFF_DWARF_BENCH:
+	  ok = bench_diff(path1, path2, /*from_abixml=*/false, r);
+	  break;
+	case DIFF_ABIXML_BENCH:
+	  ok = bench_diff(path1, path2, /*from_abixml=*/true, r);
+	  break;
+	}
+
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+
+      ostringstream o;
+      if (ok)
+	emit_result(r, usage.ru_maxrss, o);
+      string s = o.str();
+      if (write(fds[1], s.c_str(), s.size()) != (ssize_t) s.size())
+	ok = false;
+      close(fds[1]);
+      // Do not bother tearing down the IR of the benchmark.
+      _exit(ok ? 0 : 1);
+    }
+
+  close(fds[1]);
+  string result;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+    result.append(buf, n);
+  close(fds[0]);
+
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid
+      || !WIFEXITED(status)
+      || WEXITSTATUS(status))
+    {
+      cerr << "benchmark " << names[kind] << " failed on " << input << "\n";
+      return false;
+    }
+
+  out << result;
+  out.flush();
+  return true;
+}
+
+/// Run all the benchmarks on a pair of ELF binaries.
+///
+/// @param path1 the first binary.
+///
+/// @param path2 the second binary.
+///
+/// @param out the output stream to emit the results to.
+///
+/// @return true iff all the benchmarks ran successfully.
+static bool
+run_elf_benches(const string& path1, const string& path2, ostream& out)
+{
+  string output_dir = string(get_build_dir()) + "/tests/output/bench/";
+  string base;
+  abigail::tools_utils::base_name(path1, base);
+  string abixml_path = output_dir + base + ".abi";
+
+  bool is_ok = true;
+  is_ok &= run_bench(READ_DWARF_BENCH, path1, "", out);
+  is_ok &= run_bench(WRITE_ABIXML_BENCH, path1, abixml_path, out);
+  is_ok &= run_bench(READ_ABIXML_BENCH, abixml_path, "", out);
+  is_ok &= run_bench(DIFF_DWARF_BENCH, path1, path2, out);
+  return is_ok;
+}
+
+/// Display the usage of the program.
+///
+/// @param prog_name the name of the program.
+///
+/// @param out the output stream to emit the usage to.
+static void
+display_usage(const string& prog_name, ostream& out)
+{
+  out << "usage: " << prog_name << " [options] [<elf1> <elf2>]...\n"
+      << " where options can be:\n"
+      << "  --help|-h  display this message\n"
+      << "  --no-builtin-inputs  do not benchmark the binaries of "
+      "tests/data\n"
+      << "  --synthetic-size <n>  number of structs of the synthetic "
+      "corpora (0 to disable them, default 20000)\n"
+      << "  --output <path>  emit the results to <path> rather than "
+      "to the standard output\n"
+      << "Each pair of <elf1> <elf2> binaries is benchmarked as well.\n";
+}
+
+/// Parse the command line of the program.
+///
+/// @param argc the number of arguments.
+///
+/// @param argv the arguments.
+///
+/// @param opts the options to set.
+///
+/// @return true upon successful completion.
+static bool
+parse_command_line(int argc, char* argv[], options& opts)
+{
+  for (int i = 1; i < argc; ++i)
+    {
+      if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h"))
+	opts.display_usage = true;
+      else if (!strcmp(argv[i], "--no-builtin-inputs"))
+	opts.builtin_inputs = false;
+      else if (!strcmp(argv[i], "--synthetic-size"))
+	{
+	  if (i + 1 >= argc)
+	    return false;
+	  char* end = 0;
+	  opts.synthetic_size = strtoul(argv[++i], &end, 10);
+	  if (*end)
+	    return false;
+	}
+      else if (!strcmp(argv[i], "--output"))
+	{
+	  if (i + 1 >= argc)
+	    return false;
+	  opts.output_path = argv[++i];
+	}
+      else if (argv[i][0] == '-')
+	return false;
+      else
+	opts.elf_paths.push_back(argv[i]);
+    }
+  return opts.elf_paths.size() % 2 == 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  options opts;
+  if (!parse_command_line(argc, argv, opts) || opts.display_usage)
+    {
+      display_usage(argv[0], opts.display_usage ? cout : cerr);
+      return !opts.display_usage;
+    }
+
+  string output_dir = string(get_build_dir()) + "/tests/output/bench/";
+  if (!abigail::tools_utils::ensure_dir_path_created(output_dir))
+    {
+      cerr << "could not create directory " << output_dir << "\n";
+      return 1;
+    }
+
+  ofstream of;
+  if (!opts.output_path.empty())
+    {
+      of.open(opts.output_path.c_str(), std::ios_base::trunc);
+      if (!of.is_open())
+	{
+	  cerr << "could not open " << opts.output_path << "\n";
+	  return 1;
+	}
+    }
+  ostream& out = opts.output_path.empty() ? cout : of;
+
+  bool is_ok = true;
+
+  if (opts.builtin_inputs)
+    for (InOutSpec* s = in_out_specs; s->in_elfv0_path; ++s)
+      is_ok &=
+	run_elf_benches(string(get_src_dir()) + "/tests/" + s->in_elfv0_path,
+			string(get_src_dir()) + "/tests/" + s->in_elfv1_path,
+			out);
+
+  for (size_t i = 0; i + 1 < opts.elf_paths.size(); i += 2)
+    is_ok &= run_elf_benches(opts.elf_paths[i], opts.elf_paths[i + 1], out);
+
+  if (opts.synthetic_size)
+    {
+      ostringstream o;
+      o << output_dir << "synthetic-" << opts.synthetic_size;
+      string v0 = o.str() + "-v0.abi", v1 = o.str() + "-v1.abi";
+      if (!generate_synthetic_abixml(opts.synthetic_size, 0, v0)
+	  || !generate_synthetic_abixml(opts.synthetic_size, 1, v1))
+	{
+	  cerr << "could not generate the synthetic corpora\n";
+	  return 1;
+	}
+      is_ok &= run_bench(READ_ABIXML_BENCH, v0, "", out);
+      is_ok &= run_bench(DIFF_ABIXML_BENCH, v0, v1, out);
+    }
+
+  return !is_ok;
+}
@@ -0,0 +1,7 @@
+struct opaque;
+
+void
+a_fn(struct opaque* o)
+{
+  (void) o;
+}
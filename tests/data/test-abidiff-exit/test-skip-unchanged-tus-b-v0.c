@@ -0,0 +1,10 @@
+struct opaque
+{
+  int m0;
+};
+
+int
+b_fn(struct opaque* o)
+{
+  return o->m0;
+}
@@ -0,0 +1,10 @@
+struct opaque
+{
+  long m0;
+};
+
+int
+b_fn(struct opaque* o)
+{
+  return o->m0;
+}
@@ -0,0 +1,10 @@
+struct s
+{
+  int m;
+};
+
+int
+c_fn(struct s* p)
+{
+  return p->m;
+}
@@ -0,0 +1,18 @@
+/* Compiled with:
+   gcc -g -fPIC -shared \
+     -Wl,--version-script=test-skip-unchanged-tus-export-list-v0.map \
+     -o test-skip-unchanged-tus-export-list-v0.so \
+     test-skip-unchanged-tus-export-list-a.c \
+     test-skip-unchanged-tus-export-list-b.c
+
+   and with test-skip-unchanged-tus-export-list-v1.map for
+   test-skip-unchanged-tus-export-list-v1.so.
+
+   The debug info is the same in both versions.  Only the export list
+   changes: b_helper is exported by the second version only.  */
+
+int
+a_fn(int i)
+{
+  return i - 1;
+}
@@ -0,0 +1,11 @@
+int
+b_helper(int i)
+{
+  return i * 2;
+}
+
+int
+b_fn(int i)
+{
+  return b_helper(i) + 1;
+}
@@ -0,0 +1,25 @@
+/* Compiled with:
+   gcc -g -gdwarf-4 -fdebug-types-section -fPIC -shared \
+     -o test-skip-unchanged-tus-type-unit-v0.so \
+     test-skip-unchanged-tus-type-unit-a.c \
+     test-skip-unchanged-tus-type-unit-b.c
+
+   and with -DVERSION_1 for test-skip-unchanged-tus-type-unit-v1.so.
+
+   The type struct S goes into a type unit, which is referred to by
+   the compilation unit of this file.  Only that type unit changes
+   from one version to the other.  */
+
+struct S
+{
+  int m0;
+#ifdef VERSION_1
+  int m1;
+#endif
+};
+
+int
+a_fn(struct S* s)
+{
+  return s != 0;
+}
@@ -0,0 +1,5 @@
+int
+b_fn(int i)
+{
+  return i + 1;
+}
@@ -31,6 +31,9 @@
 ///
 /// The set of input files and reference reports to consider should be
 /// present in the source distribution.
+///
+/// It also checks the --batch option of abicompat, which checks
+/// several programs against L(V) and L(V+N) at once.
 
 #include <cstring>
 #include <string>
@@ -42,6 +45,7 @@
 
 using std::string;
 using std::cerr;
+using std::ofstream;
 
 struct InOutSpec
 {
@@ -213,6 +217,109 @@ InOutSpec in_out_specs[] =
   {0, 0, 0, 0, 0, 0, 0}
 };
 
+/// The maximum number of programs of a batch of programs.
+#define MAX_NUM_BATCH_APPS 4
+
+/// The specification of a test of the --batch option of abicompat.
+struct BatchInOutSpec
+{
+  // The programs to check.  This array is terminated by a null
+  // pointer.
+  const char* in_app_paths[MAX_NUM_BATCH_APPS + 1];
+  const char* in_lib1_path;
+  const char* in_lib2_path;
+  const char* options;
+  // The file which the paths of the programs are written to.
+  const char* out_apps_list_path;
+  const char* in_report_path;
+  const char* out_report_path;
+};
+
+BatchInOutSpec batch_in_out_specs[] =
+{
+  {
+    {
+      "data/test-abicompat/test0-fn-changed-app",
+      "data/test-abicompat/test7-fn-changed-app",
+      0
+    },
+    "data/test-abicompat/libtest7-fn-changed-libapp-v0.so",
+    "data/test-abicompat/libtest7-fn-changed-libapp-v1.so",
+    "--show-base-names --no-show-locs --no-redundant",
+    "output/test-abicompat/test-batch-0-apps.txt",
+    "data/test-abicompat/test-batch-report-0.txt",
+    "output/test-abicompat/test-batch-report-0.txt",
+  },
+  {
+    {
+      "data/test-abicompat/test5-fn-changed-app",
+      "data/test-abicompat/test7-fn-changed-app",
+      0
+    },
+    "data/test-abicompat/libtest7-fn-changed-libapp-v1.so",
+    "",
+    "--show-base-names --no-show-locs --weak-mode",
+    "output/test-abicompat/test-batch-1-apps.txt",
+    "data/test-abicompat/test-batch-report-1.txt",
+    "output/test-abicompat/test-batch-report-1.txt",
+  },
+  // This entry must be the last one.
+  {{0}, 0, 0, 0, 0, 0, 0}
+};
+
+/// Run abicompat --batch on the programs of a @ref BatchInOutSpec
+/// and compare its report against the reference report.
+///
+/// @param s the specification of the test to run.
+///
+/// @return true iff the test passed.
+static bool
+run_batch_test(const BatchInOutSpec& s)
+{
+  using abigail::tests::get_src_dir;
+  using abigail::tests::get_build_dir;
+  using abigail::tools_utils::ensure_parent_dir_created;
+  using abigail::tools_utils::abidiff_status;
+
+  string apps_list_path =
+    string(get_build_dir()) + "/tests/" + s.out_apps_list_path;
+  string ref_report_path =
+    string(get_src_dir()) + "/tests/" + s.in_report_path;
+  string out_report_path =
+    string(get_build_dir()) + "/tests/" + s.out_report_path;
+
+  if (!ensure_parent_dir_created(apps_list_path)
+      || !ensure_parent_dir_created(out_report_path))
+    {
+      cerr << "could not create parent directory for "
+	   << out_report_path;
+      return false;
+    }
+
+  {
+    ofstream apps_list(apps_list_path.c_str());
+    apps_list << "# The programs to check.\n";
+    for (const char* const* app = s.in_app_paths; *app; ++app)
+      apps_list << get_src_dir() << "/tests/" << *app << "\n";
+  }
+
+  string cmd = string(get_build_dir()) + "/tools/abicompat "
+    + s.options + " --batch " + apps_list_path
+    + " " + get_src_dir() + "/tests/" + s.in_lib1_path;
+  if (s.in_lib2_path && strcmp(s.in_lib2_path, ""))
+    cmd += string(" ") + get_src_dir() + "/tests/" + s.in_lib2_path;
+  // The timings emitted to the error output change from one run to
+  // another so they are not part of the report.
+  cmd += " > " + out_report_path + " 2> /dev/null";
+
+  abidiff_status status = static_cast<abidiff_status>(system(cmd.c_str()));
+  if (abigail::tools_utils::abidiff_status_has_error(status))
+    return false;
+
+  cmd = "diff -u " + ref_report_path + " " + out_report_path;
+  return !system(cmd.c_str());
+}
+
 int
 main()
 {
@@ -276,5 +383,9 @@ main()
 	is_ok = false;
     }
 
+  for (BatchInOutSpec* s = batch_in_out_specs; s->in_lib1_path; ++s)
+    if (!run_batch_test(*s))
+      is_ok = false;
+
   return !is_ok;
 }
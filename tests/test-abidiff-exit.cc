@@ -31,10 +31,12 @@
 /// This is an aggregate that specifies where a test shall get its
 /// input from and where it shall write its ouput to.
 
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <cstring>
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <cstdlib>
 #include "abg-tools-utils.h"
@@ -277,9 +279,280 @@ InOutSpec in_out_specs[] =
     "data/test-abidiff-exit/test-net-change-report3.txt",
     "output/test-abidiff-exit/test-net-change-report3.txt"
   },
+  {
+    "data/test-abidiff-exit/test-skip-unchanged-tus-v0.abi",
+    "data/test-abidiff-exit/test-skip-unchanged-tus-v1.so",
+    "",
+    "--no-default-suppression --no-show-locs --harmless "
+    "--skip-unchanged-tus",
+    abigail::tools_utils::ABIDIFF_ABI_CHANGE,
+    "data/test-abidiff-exit/test-skip-unchanged-tus-report0.txt",
+    "output/test-abidiff-exit/test-skip-unchanged-tus-report0.txt"
+  },
+  {
+    "data/test-abidiff-exit/test-skip-unchanged-tus-v0.abi",
+    "data/test-abidiff-exit/test-skip-unchanged-tus-v0.so",
+    "",
+    "--no-default-suppression --no-show-locs --skip-unchanged-tus",
+    abigail::tools_utils::ABIDIFF_OK,
+    "data/test-abidiff-exit/test-skip-unchanged-tus-report1.txt",
+    "output/test-abidiff-exit/test-skip-unchanged-tus-report1.txt"
+  },
+  // Only a type unit referred to by a translation unit changes.  The
+  // translation unit must not be skipped.
+  {
+    "data/test-abidiff-exit/test-skip-unchanged-tus-type-unit-v0.abi",
+    "data/test-abidiff-exit/test-skip-unchanged-tus-type-unit-v1.so",
+    "",
+    "--no-default-suppression --no-show-locs --skip-unchanged-tus",
+    abigail::tools_utils::ABIDIFF_ABI_CHANGE,
+    "data/test-abidiff-exit/test-skip-unchanged-tus-type-unit-report0.txt",
+    "output/test-abidiff-exit/test-skip-unchanged-tus-type-unit-report0.txt"
+  },
+  // Only the export list changes: b_helper is exported by the second
+  // version only.  The translation unit defining it must not be
+  // skipped, so that it is reported as an added function, rather than
+  // as an added symbol not referenced by debug info.
+  {
+    "data/test-abidiff-exit/test-skip-unchanged-tus-export-list-v0.abi",
+    "data/test-abidiff-exit/test-skip-unchanged-tus-export-list-v1.so",
+    "",
+    "--no-default-suppression --no-show-locs --skip-unchanged-tus",
+    abigail::tools_utils::ABIDIFF_ABI_CHANGE,
+    "data/test-abidiff-exit/test-skip-unchanged-tus-export-list-report0.txt",
+    "output/test-abidiff-exit/test-skip-unchanged-tus-export-list-report0.txt"
+  },
   {0, 0, 0 ,0,  abigail::tools_utils::ABIDIFF_OK, 0, 0}
 };
 
+/// Count the number of lines of a file that contain a given string.
+///
+/// @param path the path to the file to consider.
+///
+/// @param str the string to look for.
+///
+/// @return the number of lines of the file that contain @p str.
+static size_t
+count_lines_containing(const std::string& path, const std::string& str)
+{
+  std::ifstream in(path.c_str());
+  std::string line;
+  size_t result = 0;
+  while (std::getline(in, line))
+    if (line.find(str) != std::string::npos)
+      ++result;
+  return result;
+}
+
+/// Run abidiff twice on the same two binaries, with a corpus cache.
+///
+/// The first run starts from an empty cache, so it must build the
+/// two corpora from DWARF and save them into the cache.  The second
+/// run must read them both from the cache.  Both runs must emit the
+/// same report.  The files of the cache must be created with the
+/// permissions allowed by the umask.
+///
+/// @return true iff the test passed.
+static bool
+run_corpus_cache_test()
+{
+  using std::string;
+  using std::cerr;
+  using abigail::tests::get_src_dir;
+  using abigail::tests::get_build_dir;
+  using abigail::tools_utils::ensure_dir_path_created;
+
+  const string in_elfv0_path = string(get_src_dir()) + "/tests/"
+    + "data/test-diff-filter/libtest21-compatible-vars-v0.so";
+  const string in_elfv1_path = string(get_src_dir()) + "/tests/"
+    + "data/test-diff-filter/libtest21-compatible-vars-v1.so";
+  const string ref_diff_report_path = string(get_src_dir()) + "/tests/"
+    + "data/test-diff-filter/test21-compatible-vars-report-0.txt";
+  const string out_dir =
+    string(get_build_dir()) + "/tests/output/test-abidiff-exit";
+  const string cache_dir = out_dir + "/corpus-cache";
+
+  if (system(("rm -rf " + cache_dir).c_str())
+      || !ensure_dir_path_created(cache_dir))
+    {
+      cerr << "could not create an empty corpus cache in "
+	   << cache_dir << "\n";
+      return false;
+    }
+
+  umask(022);
+
+  bool is_ok = true;
+  for (int run = 0; run < 2; ++run)
+    {
+      std::ostringstream o;
+      o << out_dir << "/test-corpus-cache-report" << run << ".txt";
+      const string out_diff_report_path = o.str();
+      const string out_stats_path = out_diff_report_path + ".stats";
+
+      string cmd = string(get_build_dir()) + "/tools/abidiff"
+	+ " --no-default-suppression --no-show-locs --harmless --stats"
+	+ " --cache-dir " + cache_dir
+	+ " " + in_elfv0_path + " " + in_elfv1_path
+	+ " > " + out_diff_report_path
+	+ " 2> " + out_stats_path;
+
+      int code = system(cmd.c_str());
+      if (!WIFEXITED(code)
+	  || (static_cast<abidiff_status>(WEXITSTATUS(code))
+	      != abigail::tools_utils::ABIDIFF_ABI_CHANGE))
+	{
+	  cerr << "for command '" << cmd
+	       << "', unexpected abidiff exit status\n";
+	  is_ok = false;
+	  continue;
+	}
+
+      // Both corpora are missing from the cache during the first
+      // run, and both are found there during the second one.
+      size_t num_hits =
+	count_lines_containing(out_stats_path, "corpus cache hit for ");
+      size_t expected_num_hits = run ? 2 : 0;
+      if (num_hits != expected_num_hits)
+	{
+	  cerr << "for command '" << cmd << "', expected "
+	       << expected_num_hits << " corpus cache hits but got "
+	       << num_hits << "\n";
+	  is_ok = false;
+	}
+
+      cmd = "test -z \"$(find " + cache_dir + " -type f ! -perm 0644)\"";
+      if (system(cmd.c_str()))
+	{
+	  cerr << "the files of the corpus cache " << cache_dir
+	       << " don't have the 0644 mode\n";
+	  is_ok = false;
+	}
+
+      cmd = "diff -u " + ref_diff_report_path + " " + out_diff_report_path;
+      if (system(cmd.c_str()))
+	is_ok = false;
+    }
+
+  return is_ok;
+}
+
+/// This is an aggregate that specifies the input files, the options
+/// and the expected exit code and report of abidiff in its --against
+/// mode.
+struct AgainstSpec
+{
+  /// The input files, relative to the tests directory of the source
+  /// distribution.  The last one is the new binary, and the others
+  /// are the baselines.
+  const char*	in_paths;
+  const char*	abidiff_options;
+  abidiff_status status;
+  const char*	in_report_path;
+  const char*	out_report_path;
+};// end struct AgainstSpec
+
+AgainstSpec against_specs[] =
+{
+  // The verdict of the comparison against the first baseline must
+  // not be overriden by the one against the second baseline.
+  {
+    "data/test-abidiff-exit/test-net-change-v0.o "
+    "data/test-abidiff-exit/test-net-change-v1.o "
+    "data/test-abidiff-exit/test-net-change-v1.o",
+    "--no-default-suppression --no-show-locs --against",
+    static_cast<abidiff_status>
+    (abigail::tools_utils::ABIDIFF_ABI_CHANGE
+     | abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE),
+    "data/test-abidiff-exit/test-against-report0.txt",
+    "output/test-abidiff-exit/test-against-report0.txt"
+  },
+  {
+    "data/test-abidiff-exit/test-net-change-v1.o "
+    "data/test-abidiff-exit/test-net-change-v0.o",
+    "--no-default-suppression --no-show-locs --against",
+    static_cast<abidiff_status>
+    (abigail::tools_utils::ABIDIFF_ABI_CHANGE
+     | abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE),
+    "data/test-abidiff-exit/test-against-report1.txt",
+    "output/test-abidiff-exit/test-against-report1.txt"
+  },
+  // There must be a baseline and a new binary.
+  {
+    "data/test-abidiff-exit/test-net-change-v0.o",
+    "--against",
+    static_cast<abidiff_status>
+    (abigail::tools_utils::ABIDIFF_USAGE_ERROR
+     | abigail::tools_utils::ABIDIFF_ERROR),
+    "data/test-abidiff-exit/test-against-report2.txt",
+    "output/test-abidiff-exit/test-against-report2.txt"
+  },
+  {0, 0, abigail::tools_utils::ABIDIFF_OK, 0, 0}
+};
+
+/// Run abidiff in its --against mode on the specifications of
+/// against_specs.
+///
+/// abidiff is run from the tests directory of the source
+/// distribution, with input paths relative to it, so that the
+/// verdicts it emits don't depend on where the sources are.
+///
+/// @return true iff all the tests passed.
+static bool
+run_against_tests()
+{
+  using std::string;
+  using std::cerr;
+  using abigail::tests::get_src_dir;
+  using abigail::tests::get_build_dir;
+  using abigail::tools_utils::ensure_parent_dir_created;
+
+  bool is_ok = true;
+  for (AgainstSpec* s = against_specs; s->in_paths; ++s)
+    {
+      const string ref_diff_report_path =
+	string(get_src_dir()) + "/tests/" + s->in_report_path;
+      const string out_diff_report_path =
+	string(get_build_dir()) + "/tests/" + s->out_report_path;
+
+      if (!ensure_parent_dir_created(out_diff_report_path))
+	{
+	  cerr << "could not create parent directory for "
+	       << out_diff_report_path;
+	  is_ok = false;
+	  continue;
+	}
+
+      string cmd = "cd " + string(get_src_dir()) + "/tests && "
+	+ string(get_build_dir()) + "/tools/abidiff "
+	+ s->abidiff_options + " " + s->in_paths
+	+ " > " + out_diff_report_path;
+
+      int code = system(cmd.c_str());
+      if (!WIFEXITED(code))
+	{
+	  is_ok = false;
+	  continue;
+	}
+
+      abidiff_status status = static_cast<abidiff_status>(WEXITSTATUS(code));
+      if (status != s->status)
+	{
+	  cerr << "for command '" << cmd
+	       << "', expected abidiff status to be " << s->status
+	       << " but instead, got " << status << "\n";
+	  is_ok = false;
+	  continue;
+	}
+
+      cmd = "diff -u " + ref_diff_report_path + " " + out_diff_report_path;
+      if (system(cmd.c_str()))
+	is_ok = false;
+    }
+
+  return is_ok;
+}
+
 int
 main()
 {
@@ -358,5 +631,11 @@ main()
 	  is_ok = false;
       }
 
+    if (!run_corpus_cache_test())
+      is_ok = false;
+
+    if (!run_against_tests())
+      is_ok = false;
+
     return !is_ok;
 }
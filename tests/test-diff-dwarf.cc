@@ -28,11 +28,21 @@
 /// failed.  Note that the comparison is done using the libabigail
 /// library directly.
 ///
+/// Each diff is computed with the two engines that can be used to
+/// match the functions, variables and ELF symbols of the corpora, and
+/// the two resulting reports must be the same.
+///
+/// The second input file is also compared against both input files
+/// at once, using compute_diffs.  The diff against the first input
+/// file must yield the same report, and the diff against itself must
+/// be empty.
+///
 /// The set of input files and reference reports to consider should be
 /// present in the source distribution.
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <cstdlib>
 #include "abg-tools-utils.h"
@@ -370,7 +380,9 @@ main()
   using abigail::tools_utils::ensure_parent_dir_created;
   using abigail::dwarf_reader::read_corpus_from_elf;
   using abigail::comparison::compute_diff;
+  using abigail::comparison::compute_diffs;
   using abigail::comparison::corpus_diff_sptr;
+  using abigail::comparison::corpus_diff_sptrs_type;
   using abigail::ir::environment;
   using abigail::ir::environment_sptr;
   using abigail::comparison::diff_context_sptr;
@@ -455,10 +467,54 @@ main()
 	  continue;
 	}
 
+      std::ostringstream report;
       if (d->has_changes())
-	d->report(of);
+	d->report(report);
+      of << report.str();
       of.close();
 
+      // Compute the diff again, using the edit script matching engine
+      // rather than the default hash join one.  The two engines must
+      // yield the same report.
+      diff_context_sptr edit_script_ctxt(new diff_context);
+      edit_script_ctxt->show_locs(false);
+      edit_script_ctxt->corpus_matching_engine
+	(abigail::comparison::EDIT_SCRIPT_MATCHING_ENGINE);
+      corpus_diff_sptr edit_script_d =
+	compute_diff(corp0, corp1, edit_script_ctxt);
+      std::ostringstream edit_script_report;
+      if (edit_script_d->has_changes())
+	edit_script_d->report(edit_script_report);
+      if (edit_script_report.str() != report.str())
+	{
+	  cerr << "the matching engines yield different reports for "
+	       << in_elfv0_path << " and " << in_elfv1_path << "\n";
+	  is_ok = false;
+	}
+
+      // Compare the second corpus against the two corpora at once.
+      std::vector<abigail::corpus_sptr> baselines;
+      baselines.push_back(corp0);
+      baselines.push_back(corp1);
+      std::vector<diff_context_sptr> baseline_ctxts;
+      for (size_t i = 0; i < baselines.size(); ++i)
+	{
+	  baseline_ctxts.push_back(diff_context_sptr(new diff_context));
+	  baseline_ctxts.back()->show_locs(false);
+	}
+      corpus_diff_sptrs_type baseline_diffs;
+      compute_diffs(baselines, corp1, baseline_ctxts, baseline_diffs);
+      std::ostringstream baseline_report;
+      if (baseline_diffs[0]->has_changes())
+	baseline_diffs[0]->report(baseline_report);
+      if (baseline_report.str() != report.str()
+	  || baseline_diffs[1]->has_changes())
+	{
+	  cerr << "comparing " << in_elfv1_path
+	       << " against several baselines yields unexpected reports\n";
+	  is_ok = false;
+	}
+
       string cmd =
 	"diff -u " + ref_diff_report_path + " " + out_diff_report_path;
       if (system(cmd.c_str()))
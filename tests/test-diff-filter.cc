@@ -409,6 +409,14 @@ InOutSpec in_out_specs[] =
     "data/test-diff-filter/test31-pr18535-libstdc++-report-1.txt",
     "output/test-diff-filter/test31-pr18535-libstdc++-report-1.txt",
   },
+  { // Just like the first test31, but read with several threads.
+    "data/test-diff-filter/test31-pr18535-libstdc++-4.8.3.so",
+    "data/test-diff-filter/test31-pr18535-libstdc++-4.9.2.so",
+    "--no-default-suppression --no-linkage-name --no-show-locs --no-redundant "
+    "--threads 4",
+    "data/test-diff-filter/test31-pr18535-libstdc++-report-0.txt",
+    "output/test-diff-filter/test31-pr18535-libstdc++-report-0-threads.txt",
+  },
   {
     "data/test-diff-filter/libtest32-struct-change-v0.so",
     "data/test-diff-filter/libtest32-struct-change-v1.so",
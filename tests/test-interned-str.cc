@@ -0,0 +1,142 @@
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+//
+// This file is part of the GNU Application Binary Interface Generic
+// Analysis and Instrumentation Library (libabigail).  This library is
+// free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option) any
+// later version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program; see the file COPYING-LGPLV3.  If
+// not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+///
+/// This program tests the interned string pool.
+
+#include <pthread.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "abg-interned-str.h"
+#include "lib/catch.hpp"
+
+using std::string;
+using std::vector;
+using abigail::interned_string;
+using abigail::interned_string_pool;
+
+/// Build the value of the Nth string used by these tests.
+///
+/// Every other string is too long to fit in the storage of a short
+/// string.
+static string
+make_string(size_t n)
+{
+  std::ostringstream o;
+  o << "string-" << n;
+  if (n % 2)
+    o << "-that-is-long-enough-to-need-an-allocation";
+  return o.str();
+}
+
+TEST_CASE("InternedStringPool::Basic", "[interned-str]")
+{
+  interned_string_pool pool;
+
+  CHECK(pool.has_string(""));
+  CHECK(pool.create_string("").empty());
+  CHECK(!pool.has_string("foo"));
+  CHECK(pool.get_string("foo") == 0);
+
+  interned_string foo = pool.create_string("foo");
+  CHECK(!foo.empty());
+  CHECK(foo == string("foo"));
+  CHECK(pool.has_string("foo"));
+  CHECK(pool.get_string("foo") == foo.raw()->c_str());
+  CHECK(pool.create_string("foo") == foo);
+  CHECK(pool.create_string("fo") != foo);
+  CHECK(pool.create_string("foo2") != foo);
+}
+
+TEST_CASE("InternedStringPool::ManyStrings", "[interned-str]")
+{
+  interned_string_pool pool;
+  vector<interned_string> strings;
+
+  // Enough strings for the hash tables of the pool to grow several
+  // times.
+  for (size_t i = 0; i < 10000; ++i)
+    strings.push_back(pool.create_string(make_string(i)));
+
+  for (size_t i = 0; i < strings.size(); ++i)
+    {
+      string s = make_string(i);
+      REQUIRE(strings[i] == s);
+      REQUIRE(pool.create_string(s) == strings[i]);
+      REQUIRE(pool.get_string(s.c_str()) == strings[i].raw()->c_str());
+    }
+
+  size_t num_strings = 0, num_bytes = 0;
+  pool.get_stats(num_strings, num_bytes);
+  CHECK(num_strings == strings.size());
+  CHECK(num_bytes > 0);
+}
+
+/// The arguments of the threads of the InternedStringPool::Concurrent
+/// test.
+struct interning_task
+{
+  interned_string_pool*		pool;
+  vector<interned_string>	strings;
+};
+
+/// Intern strings in the pool of an @ref interning_task.
+///
+/// @param t the @ref interning_task to consider.
+static void*
+intern_strings(void* t)
+{
+  interning_task* task = static_cast<interning_task*>(t);
+  for (size_t i = 0; i < 5000; ++i)
+    task->strings.push_back(task->pool->create_string(make_string(i)));
+  return 0;
+}
+
+TEST_CASE("InternedStringPool::Concurrent", "[interned-str]")
+{
+  interned_string_pool pool;
+  const size_t num_threads = 4;
+  interning_task tasks[num_threads];
+  pthread_t threads[num_threads];
+
+  // All the threads intern the same strings at the same time.
+  for (size_t i = 0; i < num_threads; ++i)
+    {
+      tasks[i].pool = &pool;
+      REQUIRE(pthread_create(&threads[i], 0, intern_strings, &tasks[i]) == 0);
+    }
+  for (size_t i = 0; i < num_threads; ++i)
+    pthread_join(threads[i], 0);
+
+  // So they must all have gotten the same interned strings.
+  for (size_t i = 0; i < tasks[0].strings.size(); ++i)
+    {
+      REQUIRE(tasks[0].strings[i] == make_string(i));
+      for (size_t j = 1; j < num_threads; ++j)
+	REQUIRE(tasks[j].strings[i] == tasks[0].strings[i]);
+    }
+
+  size_t num_strings = 0, num_bytes = 0;
+  pool.get_stats(num_strings, num_bytes);
+  CHECK(num_strings == tasks[0].strings.size());
+}
@@ -25,10 +25,14 @@
 /// This program tests suppression generation from KMI whitelists.
 
 #include <string>
+#include <vector>
 
 #include "lib/catch.hpp"
 
+#include "abg-corpus.h"
+#include "abg-dwarf-reader.h"
 #include "abg-fwd.h"
+#include "abg-regex.h"
 #include "abg-suppression.h"
 #include "abg-tools-utils.h"
 #include "test-utils.h"
@@ -40,6 +44,13 @@ using abigail::suppr::function_suppression_sptr;
 using abigail::suppr::variable_suppression_sptr;
 using abigail::suppr::is_function_suppression;
 using abigail::suppr::is_variable_suppression;
+using abigail::suppr::function_suppression;
+using abigail::suppr::variable_suppression;
+using abigail::corpus_sptr;
+using abigail::ir::environment;
+using abigail::ir::environment_sptr;
+namespace dwarf_reader = abigail::dwarf_reader;
+namespace regex = abigail::regex;
 
 const static std::string whitelist_with_single_entry
     = std::string(abigail::tests::get_src_dir())
@@ -57,6 +68,10 @@ const static std::string whitelist_with_duplicate_entry
     = std::string(abigail::tests::get_src_dir())
       + "/tests/data/test-kmi-whitelist/whitelist-with-duplicate-entry";
 
+const static std::string binary_with_one_function_one_variable
+    = std::string(abigail::tests::get_src_dir())
+      + "/tests/data/test-symtab/basic/one_function_one_variable.so";
+
 void
 test_suppressions_are_consistent(const suppressions_type& suppr,
 			    const std::string&	     expr)
@@ -142,3 +157,119 @@ TEST_CASE("WhitelistWithTwoSections", "[whitelists]")
   REQUIRE(!suppr.empty());
   test_suppressions_are_consistent(suppr, "^(test_symbol1|test_symbol2)$");
 }
+
+TEST_CASE("WhitelistRegexIsASetOfNames", "[whitelists]")
+{
+  std::vector<std::string> names;
+  names.push_back("test_symbol");
+  names.push_back("test.symbol|with$specials");
+  names.push_back("test_symbol2");
+
+  std::vector<std::string> literals;
+  REQUIRE(regex::get_literals(regex::generate_from_strings(names),
+			      literals));
+  REQUIRE(literals == names);
+
+  REQUIRE(regex::get_literals("^test_symbol$", literals));
+  REQUIRE(literals.size() == 1);
+  REQUIRE(literals[0] == "test_symbol");
+
+  REQUIRE(!regex::get_literals("^test_.*$", literals));
+  REQUIRE(!regex::get_literals("^(test|symbol)s$", literals));
+  REQUIRE(!regex::get_literals("^(test|)$", literals));
+  REQUIRE(!regex::get_literals("test_symbol", literals));
+  REQUIRE(!regex::get_literals("^test\\w$", literals));
+  REQUIRE(literals.empty());
+}
+
+TEST_CASE("LiteralPrefixOfRegex", "[whitelists]")
+{
+  REQUIRE(regex::get_literal_prefix("^test_symbol.*") == "test_symbol");
+  REQUIRE(regex::get_literal_prefix("^test_?symbol") == "test");
+  REQUIRE(regex::get_literal_prefix("^tes+t") == "tes");
+  REQUIRE(regex::get_literal_prefix("^test\\.symbol[0-9]")
+	  == "test.symbol");
+  REQUIRE(regex::get_literal_prefix("^test(_symbol)") == "test");
+  REQUIRE(regex::get_literal_prefix("^test|symbol") == "");
+  REQUIRE(regex::get_literal_prefix("test_symbol") == "");
+}
+
+/// Read the corpus of a binary using the suppression specifications
+/// generated from a white list of symbol names.
+///
+/// @param whitelisted_names the names of the white list.
+///
+/// @return the corpus read.
+static corpus_sptr
+read_corpus_with_whitelist(const std::vector<std::string>& whitelisted_names)
+{
+  const std::string regex = regex::generate_from_strings(whitelisted_names);
+
+  suppressions_type supprs;
+  function_suppression_sptr fn_suppr(new function_suppression);
+  fn_suppr->set_label("whitelist");
+  fn_suppr->set_symbol_name_not_regex_str(regex);
+  fn_suppr->set_drops_artifact_from_ir(true);
+  supprs.push_back(fn_suppr);
+  variable_suppression_sptr var_suppr(new variable_suppression);
+  var_suppr->set_label("whitelist");
+  var_suppr->set_symbol_name_not_regex_str(regex);
+  var_suppr->set_drops_artifact_from_ir(true);
+  supprs.push_back(var_suppr);
+
+  environment_sptr env(new environment);
+  std::vector<char**> debug_info_root_paths;
+  dwarf_reader::read_context_sptr ctxt =
+    dwarf_reader::create_read_context(binary_with_one_function_one_variable,
+				      debug_info_root_paths, env.get());
+  dwarf_reader::add_read_context_suppressions(*ctxt, supprs);
+
+  dwarf_reader::status status = dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr corp = dwarf_reader::read_corpus_from_elf(*ctxt, status);
+  REQUIRE((status & dwarf_reader::STATUS_OK));
+  REQUIRE(corp);
+  return corp;
+}
+
+TEST_CASE("WhitelistKeepsOnlyWhitelistedArtifacts", "[whitelists]")
+{
+  std::vector<std::string> whitelisted_names;
+  whitelisted_names.push_back("exported_function");
+  whitelisted_names.push_back("unknown_symbol");
+  corpus_sptr corp = read_corpus_with_whitelist(whitelisted_names);
+  REQUIRE(corp->get_functions().size() == 1);
+  REQUIRE(corp->get_variables().empty());
+
+  whitelisted_names.clear();
+  whitelisted_names.push_back("exported_variable");
+  corp = read_corpus_with_whitelist(whitelisted_names);
+  REQUIRE(corp->get_functions().empty());
+  REQUIRE(corp->get_variables().size() == 1);
+
+  whitelisted_names.push_back("exported_function");
+  corp = read_corpus_with_whitelist(whitelisted_names);
+  REQUIRE(corp->get_functions().size() == 1);
+  REQUIRE(corp->get_variables().size() == 1);
+}
+
+TEST_CASE("WhitelistSetInTheDwarfReader", "[whitelists]")
+{
+  environment_sptr env(new environment);
+  std::vector<char**> debug_info_root_paths;
+  dwarf_reader::read_context_sptr ctxt =
+    dwarf_reader::create_read_context(binary_with_one_function_one_variable,
+				      debug_info_root_paths, env.get());
+
+  dwarf_reader::symbol_names_set_sptr whitelist
+    (new dwarf_reader::symbol_names_set_type);
+  whitelist->insert("exported_variable");
+  whitelist->insert("unknown_symbol");
+  dwarf_reader::set_kernel_abi_whitelist(*ctxt, whitelist);
+
+  dwarf_reader::status status = dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr corp = dwarf_reader::read_corpus_from_elf(*ctxt, status);
+  REQUIRE((status & dwarf_reader::STATUS_OK));
+  REQUIRE(corp);
+  REQUIRE(corp->get_functions().empty());
+  REQUIRE(corp->get_variables().size() == 1);
+}
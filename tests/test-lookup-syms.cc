@@ -94,6 +94,20 @@ InOutSpec in_out_specs[] =
     "data/test-lookup-syms/test1-3-report.txt",
     "output/test-lookup-syms/test-3-report.txt"
   },
+  {
+    "data/test-lookup-syms/test1.so",
+    "foo _foo1 _foo2",
+    "--no-absolute-path",
+    "data/test-lookup-syms/test1-4-report.txt",
+    "output/test-lookup-syms/test1-4-report.txt"
+  },
+  {
+    "data/test-lookup-syms/test0.o",
+    "main foo \"bar(char)\"",
+    "--demangle",
+    "data/test-lookup-syms/test0-1-report.txt",
+    "output/test-lookup-syms/test0-1-report.txt"
+  },
   // This should always be the last entry.
   {NULL, NULL, NULL, NULL, NULL}
 };
@@ -27,6 +27,7 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <cstdlib>
 #include "abg-ir.h"
@@ -46,6 +47,7 @@ using abigail::dwarf_reader::read_corpus_from_elf;
 using abigail::dwarf_reader::read_context;
 using abigail::dwarf_reader::read_context_sptr;
 using abigail::dwarf_reader::create_read_context;
+using abigail::dwarf_reader::set_num_threads;
 using abigail::xml_writer::SEQUENCE_TYPE_ID_STYLE;
 using abigail::xml_writer::HASH_TYPE_ID_STYLE;
 using abigail::xml_writer::create_write_context;
@@ -384,6 +386,32 @@ InOutSpec in_out_specs[] =
   {NULL, NULL, SEQUENCE_TYPE_ID_STYLE, NULL, NULL}
 };
 
+/// The number of threads used to read the debug info of the binaries
+/// of in_out_specs_with_threads.
+const size_t NUM_READ_THREADS = 4;
+
+/// These specs are read using NUM_READ_THREADS threads.  The result
+/// must be the same as when reading them using a single thread.
+InOutSpec in_out_specs_with_threads[] =
+{
+  {
+    "data/test-read-dwarf/test12-pr18844.so",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/test12-pr18844.so.abi",
+    "output/test-read-dwarf/test12-pr18844.so.threads.abi",
+  },
+  {
+    "data/test-read-dwarf/PR22015-libboost_iostreams.so",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/PR22015-libboost_iostreams.so.abi",
+    "output/test-read-dwarf/PR22015-libboost_iostreams.so.threads.abi",
+  },
+  // This should be the last entry.
+  {NULL, NULL, SEQUENCE_TYPE_ID_STYLE, NULL, NULL}
+};
+
 using abigail::suppr::suppression_sptr;
 using abigail::suppr::suppressions_type;
 using abigail::suppr::read_suppressions;
@@ -410,16 +438,19 @@ struct test_task : public abigail::workers::task
   string out_abi_base;
   string in_elf_base;
   string in_abi_base;
+  size_t num_threads;
 
   test_task(const InOutSpec &s,
 	    string& a_out_abi_base,
 	    string& a_in_elf_base,
-	    string& a_in_abi_base)
+	    string& a_in_abi_base,
+	    size_t a_num_threads = 0)
     : is_ok(true),
       spec(s),
       out_abi_base(a_out_abi_base),
       in_elf_base(a_in_elf_base),
-      in_abi_base(a_in_abi_base)
+      in_abi_base(a_in_abi_base),
+      num_threads(a_num_threads)
   {}
 
   /// The actual test.
@@ -450,6 +481,8 @@ struct test_task : public abigail::workers::task
     ABG_ASSERT(ctxt);
     if (!in_suppr_spec_path.empty())
       set_suppressions(*ctxt, in_suppr_spec_path);
+    if (num_threads)
+      set_num_threads(*ctxt, num_threads);
 
     abigail::corpus_sptr corp = read_corpus_from_elf(*ctxt, status);
     // if there is no output and no input, assume that we do not care about the
@@ -495,6 +528,12 @@ struct test_task : public abigail::workers::task
 
     string abidw = string(get_build_dir()) + "/tools/abidw";
     string cmd = abidw + " --abidiff " + in_elf_path;
+    if (num_threads)
+      {
+	std::ostringstream o;
+	o << " --threads " << num_threads;
+	cmd += o.str();
+      }
     if (system(cmd.c_str()))
       {
 	error_message = string("ABIs differ:\n")
@@ -536,7 +575,9 @@ main(int argc, char *argv[])
   /// processor of the machine this code runs on.  But if
   /// --no-parallel was provided then the number of worker threads
   /// equals 1.
-  const size_t num_tests = sizeof(in_out_specs) / sizeof (InOutSpec) - 1;
+  const size_t num_tests =
+    sizeof(in_out_specs) / sizeof (InOutSpec) - 1
+    + sizeof(in_out_specs_with_threads) / sizeof (InOutSpec) - 1;
   size_t num_workers = (no_parallel
 			? 1
 			: std::min(abigail::workers::get_number_of_threads(),
@@ -556,6 +597,15 @@ main(int argc, char *argv[])
       ABG_ASSERT(task_queue.schedule_task(t));
     }
 
+  for (InOutSpec *s = in_out_specs_with_threads; s->in_elf_path; ++s)
+    {
+      test_task_sptr t(new test_task(*s, out_abi_base,
+				     in_elf_base,
+				     in_abi_base,
+				     NUM_READ_THREADS));
+      ABG_ASSERT(task_queue.schedule_task(t));
+    }
+
   /// Wait for all worker threads to finish their job, and wind down.
   task_queue.wait_for_workers_to_complete();
 
@@ -25,6 +25,7 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
@@ -253,6 +254,37 @@ InOutSpec in_out_specs[] =
     "data/test-read-write/test28-without-std-vars-ref.xml",
     "output/test-read-write/test28-without-std-vars.xml"
   },
+  {
+    "data/test-read-write/test29.xml",
+    "",
+    "data/test-read-write/test29.xml",
+    "output/test-read-write/test29.xml"
+  },
+  // This should be the last entry.
+  {NULL, NULL, NULL, NULL}
+};
+
+/// The number of threads used by abilint to load the files of
+/// in_out_specs_with_threads.
+const size_t NUM_READ_THREADS = 4;
+
+/// These specs are read by abilint using NUM_READ_THREADS threads.
+/// The result must be the same as when reading them using a single
+/// thread.
+InOutSpec in_out_specs_with_threads[] =
+{
+  {
+    "data/test-read-write/test27.xml",
+    "",
+    "data/test-read-write/test27.xml",
+    "output/test-read-write/test27.threads.xml"
+  },
+  {
+    "data/test-read-write/test29.xml",
+    "",
+    "data/test-read-write/test29.xml",
+    "output/test-read-write/test29.threads.xml"
+  },
   // This should be the last entry.
   {NULL, NULL, NULL, NULL}
 };
@@ -262,6 +294,7 @@ InOutSpec in_out_specs[] =
 struct test_task : public abigail::workers::task
 {
   InOutSpec spec;
+  size_t num_threads;
   bool is_ok;
   string in_path, out_path, in_suppr_spec_path, ref_out_path;
   string diff_cmd, error_message;
@@ -270,8 +303,12 @@ struct test_task : public abigail::workers::task
   ///
   /// @param the spec of where to find the abixml file to read and the
   /// reference output of the test.
-  test_task( InOutSpec& s)
+  ///
+  /// @param n the number of threads abilint must use to read the
+  /// abixml file.
+  test_task( InOutSpec& s, size_t n = 1)
     : spec(s),
+      num_threads(n),
       is_ok(true)
   {}
 
@@ -337,6 +374,12 @@ struct test_task : public abigail::workers::task
     string abilint = string(get_build_dir()) + "/tools/abilint";
     if (!in_suppr_spec_path.empty())
       abilint +=string(" --suppr ") + in_suppr_spec_path;
+    if (num_threads > 1)
+      {
+	std::ostringstream o;
+	o << num_threads;
+	abilint += " --threads " + o.str();
+      }
     string cmd = abilint + " " + in_path + " > " + out_path;
 
     if (system(cmd.c_str()))
@@ -366,7 +409,9 @@ main()
   using abigail::workers::task_sptr;
   using abigail::workers::get_number_of_threads;
 
-  const size_t num_tests = sizeof(in_out_specs) / sizeof (InOutSpec) - 1;
+  const size_t num_tests =
+    sizeof(in_out_specs) / sizeof (InOutSpec) - 1
+    + sizeof(in_out_specs_with_threads) / sizeof (InOutSpec) - 1;
   size_t num_workers = std::min(get_number_of_threads(), num_tests);
   queue task_queue(num_workers);
 
@@ -380,6 +425,12 @@ main()
       ABG_ASSERT(task_queue.schedule_task(t));
     }
 
+  for (InOutSpec* s = in_out_specs_with_threads; s->in_path; ++s)
+    {
+      test_task_sptr t(new test_task(*s, NUM_READ_THREADS));
+      ABG_ASSERT(task_queue.schedule_task(t));
+    }
+
   /// Wait for all worker threads to finish their job, and wind down.
   task_queue.wait_for_workers_to_complete();
 
@@ -39,6 +39,8 @@ using namespace abigail;
 using dwarf_reader::create_read_context;
 using dwarf_reader::read_context_sptr;
 using dwarf_reader::read_corpus_from_elf;
+using dwarf_reader::symbol_names_set_sptr;
+using dwarf_reader::symbol_names_set_type;
 using ir::environment;
 using ir::environment_sptr;
 
@@ -291,3 +293,66 @@ TEST_CASE("Symtab::SimpleKernelSymtabs", "[symtab, basic, kernel, ksymtab]")
       }
     }
 }
+
+static corpus_sptr
+read_corpus_with_symbols_of_interest(const std::string& path,
+				     const symbol_names_set_sptr& fns,
+				     const symbol_names_set_sptr& vars)
+{
+  environment_sptr	    env(new environment);
+  const std::vector<char**> debug_info_root_paths;
+  read_context_sptr	    ctxt = create_read_context(
+      test_data_dir + path, debug_info_root_paths, env.get(),
+      /* load_all_type = */ false);
+  dwarf_reader::set_function_symbols_of_interest(*ctxt, fns);
+  dwarf_reader::set_variable_symbols_of_interest(*ctxt, vars);
+
+  dwarf_reader::status status = dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr result = read_corpus_from_elf(*ctxt, status);
+  REQUIRE((status & dwarf_reader::STATUS_OK));
+  REQUIRE(result);
+  return result;
+}
+
+TEST_CASE("Symtab::SymbolsOfInterest", "[symtab, basic]")
+{
+  const std::string binary = "basic/one_function_one_variable.so";
+
+  symbol_names_set_sptr fns(new symbol_names_set_type);
+  fns->insert("exported_function");
+  symbol_names_set_sptr vars(new symbol_names_set_type);
+  vars->insert("some_other_variable");
+
+  GIVEN("no symbols of interest")
+  {
+    const corpus_sptr corpus =
+	read_corpus_with_symbols_of_interest(binary, symbol_names_set_sptr(),
+					     symbol_names_set_sptr());
+    CHECK(corpus->get_functions().size() == 1);
+    CHECK(corpus->get_variables().size() == 1);
+  }
+
+  GIVEN("a function of interest and no variable of interest")
+  {
+    const corpus_sptr corpus =
+	read_corpus_with_symbols_of_interest(binary, fns, vars);
+    REQUIRE(corpus->get_functions().size() == 1);
+    CHECK(corpus->get_functions()[0]->get_symbol()->get_name()
+	  == "exported_function");
+    CHECK(corpus->get_variables().empty());
+
+    // The symbol tables are still complete.
+    CHECK(corpus->get_sorted_fun_symbols().size() == 1);
+    CHECK(corpus->get_sorted_var_symbols().size() == 1);
+    CHECK(corpus->get_unreferenced_variable_symbols().size() == 1);
+  }
+
+  GIVEN("only a restriction on the variables")
+  {
+    const corpus_sptr corpus =
+	read_corpus_with_symbols_of_interest(binary, symbol_names_set_sptr(),
+					     vars);
+    CHECK(corpus->get_functions().size() == 1);
+    CHECK(corpus->get_variables().empty());
+  }
+}
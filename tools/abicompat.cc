@@ -48,19 +48,26 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include "abg-cxx-compat.h"
 #include "abg-config.h"
 #include "abg-tools-utils.h"
 #include "abg-corpus.h"
 #include "abg-dwarf-reader.h"
+#include "abg-reader.h"
+#include "abg-writer.h"
 #include "abg-comparison.h"
 #include "abg-suppression.h"
+#include "abg-workers.h"
 
 using std::string;
 using std::cerr;
 using std::cout;
 using std::ostream;
 using std::ofstream;
+using std::ifstream;
+using std::istringstream;
+using std::ostringstream;
 using std::vector;
 using abg_compat::shared_ptr;
 
@@ -74,6 +81,7 @@ public:
   string		prog_name;
   string		unknow_option;
   string		app_path;
+  string		apps_list_path;
   string		lib1_path;
   string		lib2_path;
   shared_ptr<char>	app_di_root_path;
@@ -107,6 +115,9 @@ display_usage(const string& prog_name, ostream& out)
     << "usage: " << prog_name
     << " [options] [application-path] [lib-v1-path] [lib-v2-path]"
     << "\n"
+    << "   or: " << prog_name
+    << " [options] --batch <apps-list-path> [lib-v1-path] [lib-v2-path]"
+    << "\n"
     << " where options can be: \n"
     << "  --help|-h  display this help message\n"
     << "  --version|-v  show program version information and exit\n"
@@ -125,7 +136,9 @@ display_usage(const string& prog_name, ostream& out)
     << "--no-show-locs  do now show location information\n"
     << "--redundant  display redundant changes (this is the default)\n"
     << "--weak-mode  check compatibility between the application and "
-    "just one version of the library."
+    "just one version of the library.\n"
+    << "--batch <path>  check the compatibility of the applications "
+    "which paths are listed in a file, one per line\n"
     ;
 }
 
@@ -219,6 +232,14 @@ parse_command_line(int argc, char* argv[], options& opts)
 	}
       else if (!strcmp(argv[i], "--weak-mode"))
 	opts.weak_mode = true;
+      else if (!strcmp(argv[i], "--batch"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    return false;
+	  opts.apps_list_path = argv[j];
+	  ++i;
+	}
       else
 	{
 	  opts.unknow_option = argv[i];
@@ -226,7 +247,22 @@ parse_command_line(int argc, char* argv[], options& opts)
 	}
     }
 
-  if (!opts.list_undefined_symbols_only)
+  if (!opts.apps_list_path.empty())
+    {
+      // In batch mode, the applications are listed in a file so the
+      // first non-option argument is the first version of the
+      // library.
+      if (opts.list_undefined_symbols_only || !opts.lib2_path.empty())
+	return false;
+      opts.lib2_path = opts.lib1_path;
+      opts.lib1_path = opts.app_path;
+      opts.app_path.clear();
+      if (opts.lib1_path.empty())
+	return false;
+      if (!opts.weak_mode && opts.lib2_path.empty())
+	opts.weak_mode = true;
+    }
+  else if (!opts.list_undefined_symbols_only)
     {
       if (opts.app_path.empty()
 	  || opts.lib1_path.empty())
@@ -240,6 +276,7 @@ parse_command_line(int argc, char* argv[], options& opts)
 
 using abigail::tools_utils::check_file;
 using abigail::tools_utils::base_name;
+using abigail::tools_utils::guess_file_type;
 using abigail::tools_utils::abidiff_status;
 using abigail::ir::environment;
 using abigail::ir::environment_sptr;
@@ -253,6 +290,16 @@ using abigail::ir::function_decl;
 using abigail::ir::var_decl;
 using abigail::dwarf_reader::status;
 using abigail::dwarf_reader::read_corpus_from_elf;
+using abigail::dwarf_reader::read_context_sptr;
+using abigail::dwarf_reader::create_read_context;
+using abigail::dwarf_reader::symbol_names_set_type;
+using abigail::dwarf_reader::symbol_names_set_sptr;
+using abigail::dwarf_reader::set_function_symbols_of_interest;
+using abigail::dwarf_reader::set_variable_symbols_of_interest;
+using abigail::xml_reader::read_corpus_from_native_xml;
+using abigail::xml_writer::write_context_sptr;
+using abigail::xml_writer::create_write_context;
+using abigail::xml_writer::write_corpus;
 using abigail::comparison::diff_context_sptr;
 using abigail::comparison::diff_context;
 using abigail::comparison::diff_sptr;
@@ -324,13 +371,16 @@ create_diff_context(const options& opts)
 /// present in @p lib2_corpus and that their types mean the same
 /// thing.
 ///
+/// @param out the output stream to emit the report to.
+///
 /// @return a status bitfield.
 static abidiff_status
 perform_compat_check_in_normal_mode(options& opts,
 				    diff_context_sptr& ctxt,
 				    corpus_sptr app_corpus,
 				    corpus_sptr lib1_corpus,
-				    corpus_sptr lib2_corpus)
+				    corpus_sptr lib2_corpus,
+				    ostream& out)
 {
   ABG_ASSERT(lib1_corpus);
   ABG_ASSERT(lib2_corpus);
@@ -387,19 +437,19 @@ perform_compat_check_in_normal_mode(options& opts,
 
       bool abi_broke_for_sure = changes->has_incompatible_changes();
 
-      cout << "ELF file '" << app_path << "'";
+      out << "ELF file '" << app_path << "'";
       if (abi_broke_for_sure)
 	{
-	  cout << " is not ";
+	  out << " is not ";
 	  status |= abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE;
 	}
       else
-	  cout << " might not be ";
+	  out << " might not be ";
 
-      cout << "ABI compatible with '" << lib2_path
-	   << "' due to differences with '" << lib1_path
-	   << "' below:\n";
-      changes->report(cout);
+      out << "ABI compatible with '" << lib2_path
+	  << "' due to differences with '" << lib1_path
+	  << "' below:\n";
+      changes->report(out);
     }
 
   return status;
@@ -458,12 +508,15 @@ struct var_change
 ///
 /// @param lib_corpus the library corpus to consider.
 ///
+/// @param out the output stream to emit the report to.
+///
 /// @return a status bitfield.
 static abidiff_status
 perform_compat_check_in_weak_mode(options& opts,
 				  diff_context_sptr& ctxt,
 				  corpus_sptr app_corpus,
-				  corpus_sptr lib_corpus)
+				  corpus_sptr lib_corpus,
+				  ostream& out)
 {
   ABG_ASSERT(lib_corpus);
   ABG_ASSERT(app_corpus);
@@ -551,20 +604,20 @@ perform_compat_check_in_weak_mode(options& opts,
     // If some function changes were detected, then report them.
     if (!fn_changes.empty())
       {
-	cout << "functions defined in library "
-	     << "'" << lib1_path << "'\n"
-	     << "have sub-types that are different from what application "
-	     << "'" << app_path << "' "
-	     << "expects:\n\n";
+	out << "functions defined in library "
+	    << "'" << lib1_path << "'\n"
+	    << "have sub-types that are different from what application "
+	    << "'" << app_path << "' "
+	    << "expects:\n\n";
 	for (vector<fn_change>::const_iterator i = fn_changes.begin();
 	     i != fn_changes.end();
 	     ++i)
 	  {
-	    cout << "  "
-		 << i->decl->get_pretty_representation()
-		 << ":\n";
-	    i->diff->report(cout, "    ");
-	    cout << "\n";
+	    out << "  "
+		<< i->decl->get_pretty_representation()
+		<< ":\n";
+	    i->diff->report(out, "    ");
+	    out << "\n";
 	  }
       }
 
@@ -595,26 +648,493 @@ perform_compat_check_in_weak_mode(options& opts,
       }
     if (!var_changes.empty())
       {
-	cout << "variables defined in library "
-	     << "'" << lib1_path << "'\n"
-	     << "have sub-types that are different from what application "
-	     << "'" << app_path << "' "
-	     << "expects:\n\n";
+	out << "variables defined in library "
+	    << "'" << lib1_path << "'\n"
+	    << "have sub-types that are different from what application "
+	    << "'" << app_path << "' "
+	    << "expects:\n\n";
 	for (vector<var_change>::const_iterator i = var_changes.begin();
 	     i != var_changes.end();
 	     ++i)
 	  {
-	    cout << "  "
-		 << i->decl->get_pretty_representation()
-		 << ":\n";
-	    i->diff->report(cout, "    ");
-	    cout << "\n";
+	    out << "  "
+		<< i->decl->get_pretty_representation()
+		<< ":\n";
+	    i->diff->report(out, "    ");
+	    out << "\n";
 	  }
       }
   }
   return status;
 }
 
+/// Read the corpus of an application from its ELF file.
+///
+/// @param opts the options the tool got invoked with.  The
+/// application read is the one designated by options::app_path.
+///
+/// @param env the environment in which to create the corpus.
+///
+/// @param err the output stream to emit error messages to.
+///
+/// @return the corpus of the application or nil if it could not be
+/// read.
+static corpus_sptr
+read_app_corpus(const options& opts, environment* env, ostream& err)
+{
+  char * app_di_root = opts.app_di_root_path.get();
+  vector<char**> app_di_roots;
+  app_di_roots.push_back(&app_di_root);
+  status status = abigail::dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr app_corpus=
+    read_corpus_from_elf(opts.app_path,
+			 app_di_roots, env,
+			 /*load_all_types=*/opts.weak_mode,
+			 status);
+
+  if (status & abigail::dwarf_reader::STATUS_NO_SYMBOLS_FOUND)
+    {
+      emit_prefix(opts.prog_name, err)
+	<< "could not read symbols from " << opts.app_path << "\n";
+      return corpus_sptr();
+    }
+  if (!(status & abigail::dwarf_reader::STATUS_OK))
+    {
+      emit_prefix(opts.prog_name, err)
+	<< "could not read file " << opts.app_path << "\n";
+      return corpus_sptr();
+    }
+
+  return app_corpus;
+}
+
+/// Build the set of the names of some undefined symbols of an
+/// application.
+///
+/// @param syms the undefined symbols of the application.
+///
+/// @return the set of the names of @p syms, or nil if @p syms is
+/// empty.  In the later case, just like with the lists of IDs of
+/// symbols to keep of the library corpora, all the functions or
+/// variables of the libraries are considered.
+static symbol_names_set_sptr
+build_undefined_symbol_names(const elf_symbols& syms)
+{
+  symbol_names_set_sptr result;
+  if (syms.empty())
+    return result;
+
+  result.reset(new symbol_names_set_type);
+  for (elf_symbols::const_iterator i = syms.begin(); i != syms.end(); ++i)
+    {
+      // The name of an undefined symbol might be suffixed with the
+      // version of the symbol, like in "foo@@VERSION_1.0".  The
+      // symbols of the library are looked up by their bare name.
+      const string& name = (*i)->get_name();
+      result->insert(name.substr(0, name.find('@')));
+    }
+  return result;
+}
+
+/// Read the corpus of a library from its ELF file, only building the
+/// internal representation of the functions and variables the
+/// application uses.
+///
+/// @param lib_path the path to the ELF file of the library.
+///
+/// @param di_root the root directory under which to look for the
+/// split debug info of the library, or nil.
+///
+/// @param app_corpus the corpus of the application.
+///
+/// @param env the environment in which to create the corpus.
+///
+/// @param status the status of the reading of the library.
+///
+/// @return the corpus of the library.
+static corpus_sptr
+read_lib_corpus_for_app(const string& lib_path,
+			char* di_root,
+			const corpus_sptr& app_corpus,
+			environment* env,
+			status& status)
+{
+  vector<char**> di_roots;
+  di_roots.push_back(&di_root);
+  read_context_sptr ctxt = create_read_context(lib_path, di_roots, env,
+					       /*load_all_types=*/false);
+  set_function_symbols_of_interest
+    (*ctxt,
+     build_undefined_symbol_names(app_corpus->
+				  get_sorted_undefined_fun_symbols()));
+  set_variable_symbols_of_interest
+    (*ctxt,
+     build_undefined_symbol_names(app_corpus->
+				  get_sorted_undefined_var_symbols()));
+  return read_corpus_from_elf(*ctxt, status);
+}
+
+/// Read the corpus of a library from its ELF file and serialize it
+/// in the native XML format.
+///
+/// This is a sub-routine of perform_compat_check_in_batch_mode.  The
+/// debug information of the library is read only once; each
+/// application of the batch then gets its own copy of the library
+/// corpus by reading back the XML representation.
+///
+/// @param opts the options the tool got invoked with.
+///
+/// @param lib_path the path to the library to read.
+///
+/// @param lib_di_root_path the root directory of the debug
+/// information of the library.
+///
+/// @param abixml output parameter.  This is set to the XML
+/// representation of the corpus of the library.
+///
+/// @return true iff the library could be read.
+static bool
+read_lib_corpus_as_abixml(const options& opts,
+			  const string& lib_path,
+			  const shared_ptr<char>& lib_di_root_path,
+			  string& abixml)
+{
+  if (!check_file(lib_path, cerr, opts.prog_name))
+    return false;
+  if (guess_file_type(lib_path) != abigail::tools_utils::FILE_TYPE_ELF)
+    {
+      emit_prefix(opts.prog_name, cerr) << lib_path << " is not an ELF file\n";
+      return false;
+    }
+
+  // The IR of the library is only needed until it is serialized, so
+  // it lives in an environment of its own.
+  environment_sptr env(new environment);
+  char * lib_di_root = lib_di_root_path.get();
+  vector<char**> lib_di_roots;
+  lib_di_roots.push_back(&lib_di_root);
+  status status = abigail::dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr lib_corpus = read_corpus_from_elf(lib_path,
+						lib_di_roots, env.get(),
+						/*load_all_types=*/false,
+						status);
+  if (status & abigail::dwarf_reader::STATUS_DEBUG_INFO_NOT_FOUND)
+    emit_prefix(opts.prog_name, cerr)
+      << "could not read debug info for " << lib_path << "\n";
+  if (status & abigail::dwarf_reader::STATUS_NO_SYMBOLS_FOUND)
+    {
+      emit_prefix(opts.prog_name, cerr)
+	<< "could not read symbols from " << lib_path << "\n";
+      return false;
+    }
+  if (!(status & abigail::dwarf_reader::STATUS_OK))
+    {
+      emit_prefix(opts.prog_name, cerr)
+	<< "could not read file " << lib_path << "\n";
+      return false;
+    }
+
+  ostringstream o;
+  write_context_sptr write_ctxt = create_write_context(env.get(), o);
+  if (!write_corpus(*write_ctxt, lib_corpus, /*indent=*/0))
+    {
+      emit_prefix(opts.prog_name, cerr)
+	<< "could not serialize the ABI of " << lib_path << "\n";
+      return false;
+    }
+  abixml = o.str();
+
+  // Make sure the XML representation can be read back before the
+  // worker threads do so.  Note that this also lets libxml2 be
+  // initialized by the main thread.
+  environment_sptr check_env(new environment);
+  istringstream in(abixml);
+  if (!read_corpus_from_native_xml(&in, check_env.get()))
+    {
+      emit_prefix(opts.prog_name, cerr)
+	<< "could not read back the ABI of " << lib_path << "\n";
+      return false;
+    }
+
+  return true;
+}
+
+/// The worker task which job is to check the compatibility of one
+/// application of a batch with the library.
+///
+/// Each task works in its own environment, as environments are not
+/// thread safe.  The report of the check is stored in a string
+/// stream, so that the reports of all the applications can be emitted
+/// in the order of the batch.
+class compat_check_task : public abigail::workers::task
+{
+public:
+  options opts;
+  const string& lib1_abixml;
+  const string& lib2_abixml;
+  abidiff_status status;
+  bool suppressed;
+  ostringstream out;
+  ostringstream err;
+  size_t read_time;
+  size_t check_time;
+
+  /// Constructor of the task.
+  ///
+  /// @param o the options the tool got invoked with.
+  ///
+  /// @param app_path the path to the application to check.
+  ///
+  /// @param lib1 the XML representation of the first version of the
+  /// library.
+  ///
+  /// @param lib2 the XML representation of the second version of the
+  /// library.  This is empty in weak mode.
+  compat_check_task(const options& o,
+		    const string& app_path,
+		    const string& lib1,
+		    const string& lib2)
+    : opts(o),
+      lib1_abixml(lib1),
+      lib2_abixml(lib2),
+      status(abigail::tools_utils::ABIDIFF_OK),
+      suppressed(false),
+      read_time(),
+      check_time()
+  {opts.app_path = app_path;}
+
+  /// The job performed by the task.
+  ///
+  /// This reads the application from its ELF file and the libraries
+  /// from their XML representation, then checks their compatibility.
+  virtual void
+  perform()
+  {
+    abigail::tools_utils::timer t;
+    t.start();
+
+    // The environment must outlive the diff context, which refers to
+    // IR nodes of the environment.
+    environment_sptr env(new environment);
+    diff_context_sptr ctxt = create_diff_context(opts);
+    if (file_is_suppressed(opts.app_path, ctxt->suppressions()))
+      {
+	suppressed = true;
+	return;
+      }
+
+    if (!check_file(opts.app_path, err, opts.prog_name))
+      {
+	status = abigail::tools_utils::ABIDIFF_ERROR;
+	return;
+      }
+    if (guess_file_type(opts.app_path) != abigail::tools_utils::FILE_TYPE_ELF)
+      {
+	emit_prefix(opts.prog_name, err)
+	  << opts.app_path << " is not an ELF file\n";
+	status = abigail::tools_utils::ABIDIFF_ERROR;
+	return;
+      }
+
+    corpus_sptr app_corpus = read_app_corpus(opts, env.get(), err);
+    if (!app_corpus)
+      {
+	status = abigail::tools_utils::ABIDIFF_ERROR;
+	return;
+      }
+
+    istringstream lib1_in(lib1_abixml);
+    corpus_sptr lib1_corpus = read_corpus_from_native_xml(&lib1_in, env.get());
+    corpus_sptr lib2_corpus;
+    if (!opts.weak_mode)
+      {
+	istringstream lib2_in(lib2_abixml);
+	lib2_corpus = read_corpus_from_native_xml(&lib2_in, env.get());
+      }
+    if (!lib1_corpus || (!opts.weak_mode && !lib2_corpus))
+      {
+	emit_prefix(opts.prog_name, err)
+	  << "could not read the ABI of the library\n";
+	status = abigail::tools_utils::ABIDIFF_ERROR;
+	return;
+      }
+
+    t.stop();
+    read_time = t.value_in_milliseconds();
+    t.start();
+
+    if (opts.weak_mode)
+      status = perform_compat_check_in_weak_mode(opts, ctxt,
+						 app_corpus,
+						 lib1_corpus,
+						 out);
+    else
+      status = perform_compat_check_in_normal_mode(opts, ctxt,
+						   app_corpus,
+						   lib1_corpus,
+						   lib2_corpus,
+						   out);
+
+    t.stop();
+    check_time = t.value_in_milliseconds();
+  }
+}; // end class compat_check_task
+
+/// A convenience typedef for a shared_ptr to @ref compat_check_task.
+typedef shared_ptr<compat_check_task> compat_check_task_sptr;
+
+/// Read the paths of the applications listed in a file.
+///
+/// The file contains one path per line.  Empty lines and lines
+/// starting with '#' are ignored.
+///
+/// @param opts the options the tool got invoked with.  The file read
+/// is the one designated by options::apps_list_path.
+///
+/// @param app_paths output parameter.  The paths read are added to
+/// this vector.
+///
+/// @return true iff the file could be read.
+static bool
+read_apps_list(const options& opts, vector<string>& app_paths)
+{
+  if (!check_file(opts.apps_list_path, cerr, opts.prog_name))
+    return false;
+
+  ifstream in(opts.apps_list_path.c_str());
+  if (!in.good())
+    {
+      emit_prefix(opts.prog_name, cerr)
+	<< "could not open " << opts.apps_list_path << "\n";
+      return false;
+    }
+
+  string line;
+  while (std::getline(in, line))
+    {
+      line = abigail::tools_utils::trim_white_space(line);
+      if (line.empty() || line[0] == '#')
+	continue;
+      app_paths.push_back(line);
+    }
+
+  return true;
+}
+
+/// Check the compatibility of a batch of applications with a library.
+///
+/// The libraries are read only once.  The applications are then read
+/// and checked concurrently by the worker threads, each one against
+/// its own copy of the library corpora.  The reports are emitted in
+/// the order of the batch, followed by a summary of the outcome of
+/// the checks.  The time taken to read and to check each application
+/// is emitted to the error output.
+///
+/// @param opts the options the tool got invoked with.
+///
+/// @return a status bitfield.  This is the union of the statuses of
+/// the checks of all the applications.
+static abidiff_status
+perform_compat_check_in_batch_mode(options& opts)
+{
+  vector<string> app_paths;
+  if (!read_apps_list(opts, app_paths))
+    return abigail::tools_utils::ABIDIFF_ERROR;
+
+  // Report the suppression files that cannot be read once, rather
+  // than once per application.
+  vector<string> suppression_paths;
+  for (vector<string>::const_iterator i = opts.suppression_paths.begin();
+       i != opts.suppression_paths.end();
+       ++i)
+    if (check_file(*i, cerr, opts.prog_name))
+      suppression_paths.push_back(*i);
+  opts.suppression_paths = suppression_paths;
+
+  diff_context_sptr ctxt = create_diff_context(opts);
+  suppressions_type& supprs = ctxt->suppressions();
+  if (file_is_suppressed(opts.lib1_path, supprs)
+      || file_is_suppressed(opts.lib2_path, supprs))
+    return abigail::tools_utils::ABIDIFF_OK;
+
+  string lib1_abixml, lib2_abixml;
+  if (!read_lib_corpus_as_abixml(opts, opts.lib1_path,
+				 opts.lib1_di_root_path,
+				 lib1_abixml))
+    return abigail::tools_utils::ABIDIFF_ERROR;
+  if (!opts.weak_mode
+      && !read_lib_corpus_as_abixml(opts, opts.lib2_path,
+				    opts.lib2_di_root_path,
+				    lib2_abixml))
+    return abigail::tools_utils::ABIDIFF_ERROR;
+
+  abigail::workers::queue q(abigail::workers::get_number_of_threads());
+  vector<compat_check_task_sptr> tasks;
+  for (vector<string>::const_iterator i = app_paths.begin();
+       i != app_paths.end();
+       ++i)
+    {
+      compat_check_task_sptr t(new compat_check_task(opts, *i,
+						     lib1_abixml,
+						     lib2_abixml));
+      tasks.push_back(t);
+      q.schedule_task(t);
+    }
+  q.wait_for_workers_to_complete();
+
+  abidiff_status status = abigail::tools_utils::ABIDIFF_OK;
+  size_t nb_compatible = 0, nb_maybe_incompatible = 0, nb_incompatible = 0,
+    nb_suppressed = 0, nb_errors = 0;
+  for (vector<compat_check_task_sptr>::const_iterator i = tasks.begin();
+       i != tasks.end();
+       ++i)
+    {
+      const compat_check_task& t = **i;
+      cout << t.out.str();
+      cerr << t.err.str();
+
+      if (t.suppressed)
+	{
+	  ++nb_suppressed;
+	  continue;
+	}
+
+      status |= t.status;
+      if (t.status & abigail::tools_utils::ABIDIFF_ERROR)
+	{
+	  ++nb_errors;
+	  continue;
+	}
+
+      if (t.status & abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE)
+	++nb_incompatible;
+      else if (t.status & abigail::tools_utils::ABIDIFF_ABI_CHANGE)
+	++nb_maybe_incompatible;
+      else
+	++nb_compatible;
+
+      emit_prefix(opts.prog_name, cerr)
+	<< t.opts.app_path << ": read in " << t.read_time
+	<< "ms, checked in " << t.check_time << "ms\n";
+    }
+
+  string lib_path = opts.weak_mode ? opts.lib1_path : opts.lib2_path;
+  if (opts.show_base_names)
+    base_name(lib_path, lib_path);
+
+  cout << "Applications checked against '" << lib_path << "': "
+       << tasks.size() << "\n"
+       << "  ABI compatible: " << nb_compatible << "\n"
+       << "  might not be ABI compatible: " << nb_maybe_incompatible << "\n"
+       << "  not ABI compatible: " << nb_incompatible << "\n";
+  if (nb_suppressed)
+    cout << "  suppressed: " << nb_suppressed << "\n";
+  if (nb_errors)
+    cout << "  could not be checked: " << nb_errors << "\n";
+
+  return status;
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -652,6 +1172,9 @@ main(int argc, char* argv[])
       return 0;
     }
 
+  if (!opts.apps_list_path.empty())
+    return perform_compat_check_in_batch_mode(opts);
+
   ABG_ASSERT(!opts.app_path.empty());
   if (!abigail::tools_utils::check_file(opts.app_path, cerr, opts.prog_name))
     return abigail::tools_utils::ABIDIFF_ERROR;
@@ -682,29 +1205,10 @@ main(int argc, char* argv[])
     return abigail::tools_utils::ABIDIFF_OK;
 
   // Read the application ELF file.
-  char * app_di_root = opts.app_di_root_path.get();
-  vector<char**> app_di_roots;
-  app_di_roots.push_back(&app_di_root);
-  status status = abigail::dwarf_reader::STATUS_UNKNOWN;
   environment_sptr env(new environment);
-  corpus_sptr app_corpus=
-    read_corpus_from_elf(opts.app_path,
-			 app_di_roots, env.get(),
-			 /*load_all_types=*/opts.weak_mode,
-			 status);
-
-  if (status & abigail::dwarf_reader::STATUS_NO_SYMBOLS_FOUND)
-    {
-      emit_prefix(argv[0], cerr)
-	<< "could not read symbols from " << opts.app_path << "\n";
-      return abigail::tools_utils::ABIDIFF_ERROR;
-    }
-  if (!(status & abigail::dwarf_reader::STATUS_OK))
-    {
-      emit_prefix(argv[0], cerr)
-	<< "could not read file " << opts.app_path << "\n";
-      return abigail::tools_utils::ABIDIFF_ERROR;
-    }
+  corpus_sptr app_corpus = read_app_corpus(opts, env.get(), cerr);
+  if (!app_corpus)
+    return abigail::tools_utils::ABIDIFF_ERROR;
 
   if (opts.list_undefined_symbols_only)
     {
@@ -735,13 +1239,13 @@ main(int argc, char* argv[])
       return abigail::tools_utils::ABIDIFF_ERROR;
     }
 
-  char * lib1_di_root = opts.lib1_di_root_path.get();
-  vector<char**> lib1_di_roots;
-  lib1_di_roots.push_back(&lib1_di_root);
-  corpus_sptr lib1_corpus = read_corpus_from_elf(opts.lib1_path,
-						 lib1_di_roots, env.get(),
-						 /*load_all_types=*/false,
-						 status);
+  // Only the functions and variables of the libraries which symbols
+  // are undefined in the application are compared, so only build the
+  // internal representation of those.
+  status status = abigail::dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr lib1_corpus =
+    read_lib_corpus_for_app(opts.lib1_path, opts.lib1_di_root_path.get(),
+			    app_corpus, env.get(), status);
   if (status & abigail::dwarf_reader::STATUS_DEBUG_INFO_NOT_FOUND)
     emit_prefix(argv[0], cerr)
       << "could not read debug info for " << opts.lib1_path << "\n";
@@ -762,13 +1266,10 @@ main(int argc, char* argv[])
   if (!opts.weak_mode)
     {
       ABG_ASSERT(!opts.lib2_path.empty());
-      char * lib2_di_root = opts.lib2_di_root_path.get();
-      vector<char**> lib2_di_roots;
-      lib2_di_roots.push_back(&lib2_di_root);
-      lib2_corpus = read_corpus_from_elf(opts.lib2_path,
-					 lib2_di_roots, env.get(),
-					 /*load_all_types=*/false,
-					 status);
+      lib2_corpus =
+	read_lib_corpus_for_app(opts.lib2_path,
+				opts.lib2_di_root_path.get(),
+				app_corpus, env.get(), status);
       if (status & abigail::dwarf_reader::STATUS_DEBUG_INFO_NOT_FOUND)
 	emit_prefix(argv[0], cerr)
 	  << "could not read debug info for " << opts.lib2_path << "\n";
@@ -791,12 +1292,14 @@ main(int argc, char* argv[])
   if (opts.weak_mode)
     s = perform_compat_check_in_weak_mode(opts, ctxt,
 					  app_corpus,
-					  lib1_corpus);
+					  lib1_corpus,
+					  cout);
   else
     s = perform_compat_check_in_normal_mode(opts, ctxt,
 					    app_corpus,
 					    lib1_corpus,
-					    lib2_corpus);
+					    lib2_corpus,
+					    cout);
 
   return s;
 }
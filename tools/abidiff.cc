@@ -24,6 +24,7 @@
 
 #include <cstring>
 #include <vector>
+#include <cstdlib>
 #include <string>
 #include <iostream>
 #include "abg-config.h"
@@ -56,6 +57,7 @@ using abigail::suppr::suppressions_type;
 using abigail::suppr::read_suppressions;
 using namespace abigail::dwarf_reader;
 using abigail::tools_utils::emit_prefix;
+using abigail::tools_utils::emit_memory_stats;
 using abigail::tools_utils::check_file;
 using abigail::tools_utils::guess_file_type;
 using abigail::tools_utils::gen_suppr_spec_from_headers;
@@ -72,7 +74,9 @@ struct options
   string		wrong_option;
   string		file1;
   string		file2;
+  vector<string>	baseline_paths;
   vector<string>	suppression_paths;
+  string		cache_dir;
   vector<string>	kernel_abi_whitelist_paths;
   vector<string>	drop_fn_regex_patterns;
   vector<string>	drop_var_regex_patterns;
@@ -113,7 +117,11 @@ struct options
   bool			show_impacted_interfaces;
   bool			dump_diff_tree;
   bool			show_stats;
+  bool			show_mem_stats;
   bool			do_log;
+  bool			skip_unchanged_tus;
+  bool			against;
+  size_t		num_threads;
   vector<char*> di_root_paths1;
   vector<char*> di_root_paths2;
   vector<char**> prepared_di_root_paths1;
@@ -154,7 +162,11 @@ struct options
       show_impacted_interfaces(),
       dump_diff_tree(),
       show_stats(),
-      do_log()
+      show_mem_stats(),
+      do_log(),
+      skip_unchanged_tus(),
+      against(),
+      num_threads(1)
   {}
 
   ~options()
@@ -174,11 +186,23 @@ struct options
   }
 };//end struct options;
 
+/// The role of an input file in a comparison.
+enum input_file_role
+{
+  /// The first input file, or a baseline in the --against mode.
+  FIRST_INPUT_FILE,
+  /// The second input file, or the new input file in the --against
+  /// mode.
+  SECOND_INPUT_FILE
+};
+
 static void
 display_usage(const string& prog_name, ostream& out)
 {
   emit_prefix(prog_name, out)
     << "usage: " << prog_name << " [options] [<file1> <file2>]\n"
+    << "       " << prog_name
+    << " [options] --against <baseline1> [<baseline2> ...] <new-file>\n"
     << " where options can be:\n"
     << " --help|-h  display this message\n "
     << " --version|-v  display program version information and exit\n"
@@ -238,7 +262,17 @@ display_usage(const string& prog_name, ostream& out)
     << " --impacted-interfaces  display interfaces impacted by leaf changes\n"
     << " --dump-diff-tree  emit a debug dump of the internal diff tree to "
     "the error output stream\n"
+    << " --cache-dir <path>  use <path> as the directory of the "
+    "cache of corpora read from ELF binaries\n"
+    << " --threads <number>  use <number> threads to load "
+    "the binaries\n"
+    << " --skip-unchanged-tus  do not load nor compare the translation "
+    "units of the binary file2 that are the same as in the abixml file1\n"
+    << " --against  compare the last input file against each one of "
+    "the other input files\n"
     <<  " --stats  show statistics about various internal stuff\n"
+    << " --mem-stats  show statistics about the memory used by the "
+    "internal representation\n"
     << " --verbose show verbose messages about internal stuff\n";
 }
 
@@ -263,7 +297,9 @@ parse_command_line(int argc, char* argv[], options& opts)
     {
       if (argv[i][0] != '-')
 	{
-	  if (opts.file1.empty())
+	  if (opts.against)
+	    opts.baseline_paths.push_back(argv[i]);
+	  else if (opts.file1.empty())
 	    opts.file1 = argv[i];
 	  else if (opts.file2.empty())
 	    opts.file2 = argv[i];
@@ -574,8 +610,45 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.show_impacted_interfaces = true;
       else if (!strcmp(argv[i], "--dump-diff-tree"))
 	opts.dump_diff_tree = true;
+      else if (!strcmp(argv[i], "--cache-dir"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  opts.cache_dir = argv[j];
+	  ++i;
+	}
+      else if (!strcmp(argv[i], "--threads"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  char *end = 0;
+	  unsigned long n = strtoul(argv[j], &end, 10);
+	  if (!*argv[j] || *end || n == 0)
+	    {
+	      opts.wrong_option = argv[i];
+	      return false;
+	    }
+	  opts.num_threads = n;
+	  ++i;
+	}
+      else if (!strcmp(argv[i], "--skip-unchanged-tus"))
+	opts.skip_unchanged_tus = true;
+      else if (!strcmp(argv[i], "--against"))
+	opts.against = true;
       else if (!strcmp(argv[i], "--stats"))
 	opts.show_stats = true;
+      else if (!strcmp(argv[i], "--mem-stats"))
+	opts.show_mem_stats = true;
       else if (!strcmp(argv[i], "--verbose"))
 	opts.do_log = true;
       else
@@ -586,6 +659,26 @@ parse_command_line(int argc, char* argv[], options& opts)
 	}
     }
 
+  if (opts.against)
+    {
+      // The last input file is the new one.  It's compared against
+      // all the other input files, which are the baselines.
+      if (!opts.file2.empty())
+	opts.baseline_paths.insert(opts.baseline_paths.begin(), opts.file2);
+      if (!opts.file1.empty())
+	opts.baseline_paths.insert(opts.baseline_paths.begin(), opts.file1);
+      opts.file1.clear();
+      opts.file2.clear();
+      if (opts.baseline_paths.size() < 2)
+	{
+	  opts.missing_operand = true;
+	  opts.wrong_option = "--against";
+	  return true;
+	}
+      opts.file2 = opts.baseline_paths.back();
+      opts.baseline_paths.pop_back();
+    }
+
   return true;
 }
 
@@ -759,9 +852,14 @@ set_diff_context_from_opts(diff_context_sptr ctxt,
 ///
 /// @param opts the options where to get the suppression
 /// specifications from.
+///
+/// @param role the role of the input file read by @p read_ctxt in
+/// the comparison.  It says which of the options related to the
+/// public headers of the input files apply.
 template<class ReadContextType>
 static void
-set_suppressions(ReadContextType& read_ctxt, const options& opts)
+set_suppressions(ReadContextType& read_ctxt, const options& opts,
+		 input_file_role role)
 {
   suppressions_type supprs;
   for (vector<string>::const_iterator i = opts.suppression_paths.begin();
@@ -769,7 +867,7 @@ set_suppressions(ReadContextType& read_ctxt, const options& opts)
        ++i)
     read_suppressions(*i, supprs);
 
-  if (read_context_get_path(read_ctxt) == opts.file1
+  if (role == FIRST_INPUT_FILE
       && (!opts.headers_dir1.empty() || !opts.header_files1.empty()))
     {
       // Generate suppression specification to avoid showing ABI
@@ -789,7 +887,7 @@ set_suppressions(ReadContextType& read_ctxt, const options& opts)
 	}
     }
 
-  if (read_context_get_path(read_ctxt) == opts.file2
+  if (role == SECOND_INPUT_FILE
       && (!opts.headers_dir2.empty() || !opts.header_files2.empty()))
     {
       // Generate suppression specification to avoid showing ABI
@@ -830,6 +928,7 @@ set_native_xml_reader_options(abigail::xml_reader::read_context& ctxt,
 {
   consider_types_not_reachable_from_public_interfaces(ctxt,
 						      opts.show_all_types);
+  abigail::xml_reader::set_num_threads(ctxt, opts.num_threads);
 }
 
 /// Set the regex patterns describing the functions to drop from the
@@ -1015,6 +1114,290 @@ handle_error(abigail::dwarf_reader::status status_code,
   return abigail::tools_utils::ABIDIFF_OK;
 }
 
+/// Read the corpus of the second input file, when it's an ELF
+/// binary.
+///
+/// @param opts the options of the program.
+///
+/// @param env the environment in which to create the corpus.
+///
+/// @param baseline_hashes if non-nil, the hashes of the translation
+/// units of the first input file.  The translation units of the
+/// binary which have the same hash are then not read.
+///
+/// @param unchanged_tus if non-nil, this is set to the paths of the
+/// translation units that were not read because of @p
+/// baseline_hashes.
+///
+/// @param prog_name the name of the program.
+///
+/// @param status output parameter.  If the corpus couldn't be read,
+/// this is set to the status the program must exit with.
+///
+/// @return the corpus read, or nil if it couldn't be read.
+static corpus_sptr
+read_second_elf_corpus(options&		opts,
+		       environment*	env,
+		       const abigail::translation_unit_hashes_type*
+		       baseline_hashes,
+		       abigail::translation_unit_paths_type* unchanged_tus,
+		       const string&	prog_name,
+		       abidiff_status&	status)
+{
+  abigail::dwarf_reader::read_context_sptr ctxt =
+    abigail::dwarf_reader::create_read_context
+    (opts.file2, opts.prepared_di_root_paths2,
+     env, /*read_all_types=*/opts.show_all_types,
+     opts.linux_kernel_mode);
+  assert(ctxt);
+  abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
+  abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
+  abigail::dwarf_reader::set_corpus_cache_dir(*ctxt, opts.cache_dir);
+  if (baseline_hashes)
+    abigail::dwarf_reader::set_baseline_translation_unit_hashes
+      (*ctxt, *baseline_hashes);
+  set_suppressions(*ctxt, opts, SECOND_INPUT_FILE);
+
+  abigail::dwarf_reader::status c_status = abigail::dwarf_reader::STATUS_OK;
+  corpus_sptr c = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c_status);
+  if (!c
+      || (opts.fail_no_debug_info
+	  && (c_status & STATUS_ALT_DEBUG_INFO_NOT_FOUND)
+	  && (c_status & STATUS_DEBUG_INFO_NOT_FOUND)))
+    {
+      status = handle_error(c_status, ctxt.get(), prog_name, opts);
+      return corpus_sptr();
+    }
+
+  if (unchanged_tus)
+    *unchanged_tus =
+      abigail::dwarf_reader::get_skipped_translation_units(*ctxt);
+
+  return c;
+}
+
+/// Read the corpus of an input file, in the --against mode.
+///
+/// @param opts the options of the program.
+///
+/// @param path the path to the input file to read.
+///
+/// @param role the role of @p path in the comparisons.  It says
+/// which of the options related to the first or to the second input
+/// file apply to it.
+///
+/// @param env the environment in which to create the corpus.
+///
+/// @param prog_name the name of the program.
+///
+/// @return the corpus read from @p path, or nil if it couldn't be
+/// read.  In that later case, an error message is emitted.
+static corpus_sptr
+read_input_corpus(options&		opts,
+		  const string&		path,
+		  input_file_role	role,
+		  environment*		env,
+		  const string&		prog_name)
+{
+  const vector<char**>& di_roots = role == FIRST_INPUT_FILE
+    ? opts.prepared_di_root_paths1
+    : opts.prepared_di_root_paths2;
+  corpus_sptr c;
+  abigail::dwarf_reader::status c_status = abigail::dwarf_reader::STATUS_OK;
+
+  switch (guess_file_type(path))
+    {
+    case abigail::tools_utils::FILE_TYPE_ELF: // Fall through
+    case abigail::tools_utils::FILE_TYPE_AR:
+      {
+	abigail::dwarf_reader::read_context_sptr ctxt =
+	  abigail::dwarf_reader::create_read_context
+	  (path, di_roots, env, /*read_all_types=*/opts.show_all_types,
+	   opts.linux_kernel_mode);
+	assert(ctxt);
+	abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
+	abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
+	abigail::dwarf_reader::set_num_threads(*ctxt, opts.num_threads);
+	abigail::dwarf_reader::set_corpus_cache_dir(*ctxt, opts.cache_dir);
+	set_suppressions(*ctxt, opts, role);
+	c = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c_status);
+	if (!c
+	    || (opts.fail_no_debug_info
+		&& (c_status & STATUS_ALT_DEBUG_INFO_NOT_FOUND)
+		&& (c_status & STATUS_DEBUG_INFO_NOT_FOUND)))
+	  {
+	    emit_prefix(prog_name, cerr)
+	      << "failed to read input file " << path << "\n"
+	      << abigail::dwarf_reader::status_to_diagnostic_string(c_status);
+	    return corpus_sptr();
+	  }
+      }
+      break;
+    case abigail::tools_utils::FILE_TYPE_XML_CORPUS:
+      {
+	abigail::xml_reader::read_context_sptr ctxt =
+	  abigail::xml_reader::create_native_xml_read_context(path, env);
+	assert(ctxt);
+	set_suppressions(*ctxt, opts, role);
+	set_native_xml_reader_options(*ctxt, opts);
+	c = abigail::xml_reader::read_corpus_from_input(*ctxt);
+	if (!c)
+	  {
+	    emit_prefix(prog_name, cerr)
+	      << "failed to read input file " << path << "\n";
+	    return corpus_sptr();
+	  }
+      }
+      break;
+    default:
+      emit_prefix(prog_name, cerr)
+	<< "--against expects ELF binaries or abixml corpora, "
+	"which " << path << " is not\n";
+      return corpus_sptr();
+    }
+
+  if (opts.no_arch)
+    c->set_architecture_name("");
+  if (opts.no_corpus)
+    c->set_path("");
+  set_corpus_keep_drop_regex_patterns(opts, c);
+
+  return c;
+}
+
+/// Compare a new binary against several baselines, in the --against
+/// mode.
+///
+/// The new binary and the baselines are all read in the same
+/// environment.  The new binary is thus read only once, and the types
+/// of the baselines that are equal to its types share their canonical
+/// types.  Then each baseline is read, compared against the new
+/// binary, and released, one after the other.  A verdict is emitted
+/// for each baseline, followed by the report of the changes, if any.
+///
+/// Note that the canonical types of the environment are not released
+/// along with the baseline they come from.  So the types of a
+/// baseline that have no equal type in the new binary or in the
+/// baselines read before it stay in memory until the environment is
+/// destroyed.
+///
+/// The comparisons are not performed concurrently, as comparing
+/// types updates state of the environment that is shared by all the
+/// comparisons; see compute_diffs.
+///
+/// @param opts the options of the program.  The new binary is
+/// options::file2 and the baselines are options::baseline_paths.
+///
+/// @param prog_name the name of the program.
+///
+/// @return the bitwise or of the status of the comparisons against
+/// all the baselines.
+static abidiff_status
+compare_against_baselines(options& opts, const string& prog_name)
+{
+  if (opts.skip_unchanged_tus)
+    {
+      emit_prefix(prog_name, cerr)
+	<< "--skip-unchanged-tus can't be used with --against\n";
+      return (abigail::tools_utils::ABIDIFF_USAGE_ERROR
+	      | abigail::tools_utils::ABIDIFF_ERROR);
+    }
+
+  if (!check_file(opts.file2, cerr))
+    return abigail::tools_utils::ABIDIFF_ERROR;
+  for (vector<string>::const_iterator i = opts.baseline_paths.begin();
+       i != opts.baseline_paths.end();
+       ++i)
+    if (!check_file(*i, cerr))
+      return abigail::tools_utils::ABIDIFF_ERROR;
+
+  environment_sptr env(new environment);
+
+  diff_context_sptr ctxt(new diff_context);
+  set_diff_context_from_opts(ctxt, opts);
+  if (file_is_suppressed(opts.file2, ctxt->suppressions()))
+    return abigail::tools_utils::ABIDIFF_OK;
+
+  // Read the new binary first, so that the types of the baselines
+  // get canonicalized against its types.
+  corpus_sptr new_corpus =
+    read_input_corpus(opts, opts.file2, SECOND_INPUT_FILE,
+		      env.get(), prog_name);
+  if (!new_corpus)
+    return abigail::tools_utils::ABIDIFF_ERROR;
+
+  if (opts.show_mem_stats)
+    {
+      abigail::ir::memory_stats_type stats;
+      abigail::ir::get_memory_stats(*new_corpus, stats);
+      emit_memory_stats(stats, opts.file2, cerr);
+    }
+
+  abidiff_status status = abigail::tools_utils::ABIDIFF_OK;
+  for (vector<string>::const_iterator i = opts.baseline_paths.begin();
+       i != opts.baseline_paths.end();
+       ++i)
+    {
+      // A diff context can't be used by several comparisons.
+      if (!ctxt)
+	{
+	  ctxt.reset(new diff_context);
+	  set_diff_context_from_opts(ctxt, opts);
+	}
+      if (file_is_suppressed(*i, ctxt->suppressions()))
+	continue;
+
+      // The baselines are the first input files of the comparisons.
+      corpus_sptr baseline = read_input_corpus(opts, *i, FIRST_INPUT_FILE,
+					       env.get(), prog_name);
+      if (!baseline)
+	return abigail::tools_utils::ABIDIFF_ERROR;
+
+      if (opts.show_mem_stats)
+	{
+	  abigail::ir::memory_stats_type stats;
+	  abigail::ir::get_memory_stats(*baseline, stats);
+	  emit_memory_stats(stats, *i, cerr);
+	}
+
+      corpus_diff_sptr diff = compute_diff(baseline, new_corpus, ctxt);
+
+      cout << "ABI of '" << opts.file2 << "' against '" << *i << "': ";
+      if (diff->has_incompatible_changes())
+	{
+	  cout << "incompatible ABI changes\n";
+	  status |= (abigail::tools_utils::ABIDIFF_ABI_CHANGE
+		     | abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE);
+	}
+      else if (diff->has_net_changes())
+	{
+	  cout << "ABI changes\n";
+	  status |= abigail::tools_utils::ABIDIFF_ABI_CHANGE;
+	}
+      else
+	cout << "no ABI change\n";
+
+      if (diff->has_changes())
+	{
+	  diff->report(cout);
+	  cout << "\n";
+	}
+
+      // Release the baseline and its diff before reading the next
+      // baseline.
+      ctxt.reset();
+    }
+
+  if (opts.show_mem_stats)
+    {
+      abigail::ir::memory_stats_type env_stats;
+      env->get_memory_stats(env_stats);
+      emit_memory_stats(env_stats, "the shared environment", cerr);
+    }
+
+  return status;
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -1059,6 +1442,9 @@ main(int argc, char* argv[])
     return (abigail::tools_utils::ABIDIFF_USAGE_ERROR
 	    | abigail::tools_utils::ABIDIFF_ERROR);
 
+  if (opts.against)
+    return compare_against_baselines(opts, argv[0]);
+
   abidiff_status status = abigail::tools_utils::ABIDIFF_OK;
   if (!opts.file1.empty() && !opts.file2.empty())
     {
@@ -1107,6 +1493,42 @@ main(int argc, char* argv[])
 	// loading either one of the input files.
 	return abigail::tools_utils::ABIDIFF_OK;
 
+      // With --skip-unchanged-tus, the binary file2 is read first,
+      // without the translation units which content has the same hash
+      // as in the ABIXML file1.  Then file1 is read without these
+      // translation units either.
+      abigail::translation_unit_paths_type unchanged_tus;
+      if (opts.skip_unchanged_tus)
+	{
+	  if (t1_type != abigail::tools_utils::FILE_TYPE_XML_CORPUS
+	      || t2_type != abigail::tools_utils::FILE_TYPE_ELF)
+	    {
+	      emit_prefix(argv[0], cerr)
+		<< "--skip-unchanged-tus expects an abixml corpus "
+		"and an ELF binary\n";
+	      return (abigail::tools_utils::ABIDIFF_USAGE_ERROR
+		      | abigail::tools_utils::ABIDIFF_ERROR);
+	    }
+
+	  abigail::translation_unit_hashes_type baseline_hashes;
+	  abigail::xml_reader::read_context_sptr xml_ctxt =
+	    abigail::xml_reader::create_native_xml_read_context(opts.file1,
+								env.get());
+	  if (!abigail::xml_reader::read_translation_unit_hashes
+	      (*xml_ctxt, baseline_hashes))
+	    {
+	      emit_prefix(argv[0], cerr)
+		<< "failed to read input file " << opts.file1 << "\n";
+	      return abigail::tools_utils::ABIDIFF_ERROR;
+	    }
+
+	  abidiff_status s = abigail::tools_utils::ABIDIFF_OK;
+	  c2 = read_second_elf_corpus(opts, env.get(), &baseline_hashes,
+				      &unchanged_tus, argv[0], s);
+	  if (!c2)
+	    return s;
+	}
+
       switch (t1_type)
 	{
 	case abigail::tools_utils::FILE_TYPE_UNKNOWN:
@@ -1129,8 +1551,9 @@ main(int argc, char* argv[])
 	    assert(ctxt);
 
 	    abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
-	    set_suppressions(*ctxt, opts);
+	    set_suppressions(*ctxt, opts, FIRST_INPUT_FILE);
 	    abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
+	    abigail::dwarf_reader::set_corpus_cache_dir(*ctxt, opts.cache_dir);
 	    c1 = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c1_status);
 	    if (!c1
 		|| (opts.fail_no_debug_info
@@ -1146,8 +1569,10 @@ main(int argc, char* argv[])
 	      abigail::xml_reader::create_native_xml_read_context(opts.file1,
 								  env.get());
 	    assert(ctxt);
-	    set_suppressions(*ctxt, opts);
+	    set_suppressions(*ctxt, opts, FIRST_INPUT_FILE);
 	    set_native_xml_reader_options(*ctxt, opts);
+	    abigail::xml_reader::set_translation_units_to_skip(*ctxt,
+							       unchanged_tus);
 	    c1 = abigail::xml_reader::read_corpus_from_input(*ctxt);
 	    if (!c1)
 	      return handle_error(c1_status, /*ctxt=*/0,
@@ -1160,7 +1585,7 @@ main(int argc, char* argv[])
 	      abigail::xml_reader::create_native_xml_read_context(opts.file1,
 								  env.get());
 	    assert(ctxt);
-	    set_suppressions(*ctxt, opts);
+	    set_suppressions(*ctxt, opts, FIRST_INPUT_FILE);
 	    set_native_xml_reader_options(*ctxt, opts);
 	    g1 = abigail::xml_reader::read_corpus_group_from_input(*ctxt);
 	    if (!g1)
@@ -1196,24 +1621,17 @@ main(int argc, char* argv[])
 	  break;
 	case abigail::tools_utils::FILE_TYPE_ELF: // Fall through
 	case abigail::tools_utils::FILE_TYPE_AR:
+	  if (c2)
+	    // The binary was already read, with --skip-unchanged-tus.
+	    break;
 	  {
-	    abigail::dwarf_reader::read_context_sptr ctxt =
-	      abigail::dwarf_reader::create_read_context
-	      (opts.file2, opts.prepared_di_root_paths2,
-	       env.get(), /*read_all_types=*/opts.show_all_types,
-	       opts.linux_kernel_mode);
-	    assert(ctxt);
-	    abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
-	    abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
-	    set_suppressions(*ctxt, opts);
-
-	    c2 = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c2_status);
-	    if (!c2
-		|| (opts.fail_no_debug_info
-		    && (c2_status & STATUS_ALT_DEBUG_INFO_NOT_FOUND)
-		    && (c2_status & STATUS_DEBUG_INFO_NOT_FOUND)))
-	      return handle_error(c2_status, ctxt.get(), argv[0], opts);
-
+	    abidiff_status s = abigail::tools_utils::ABIDIFF_OK;
+	    c2 = read_second_elf_corpus(opts, env.get(),
+					/*baseline_hashes=*/0,
+					/*unchanged_tus=*/0,
+					argv[0], s);
+	    if (!c2)
+	      return s;
 	  }
 	  break;
 	case abigail::tools_utils::FILE_TYPE_XML_CORPUS:
@@ -1222,7 +1640,7 @@ main(int argc, char* argv[])
 	      abigail::xml_reader::create_native_xml_read_context(opts.file2,
 								  env.get());
 	    assert(ctxt);
-	    set_suppressions(*ctxt, opts);
+	    set_suppressions(*ctxt, opts, SECOND_INPUT_FILE);
 	    set_native_xml_reader_options(*ctxt, opts);
 	    c2 = abigail::xml_reader::read_corpus_from_input(*ctxt);
 	    if (!c2)
@@ -1236,7 +1654,7 @@ main(int argc, char* argv[])
 	      abigail::xml_reader::create_native_xml_read_context(opts.file2,
 								  env.get());
 	    assert(ctxt);
-	    set_suppressions(*ctxt, opts);
+	    set_suppressions(*ctxt, opts, SECOND_INPUT_FILE);
 	    set_native_xml_reader_options(*ctxt, opts);
 	    g2 = abigail::xml_reader::read_corpus_group_from_input(*ctxt);
 	    if (!g2)
@@ -1267,6 +1685,17 @@ main(int argc, char* argv[])
 	  return abigail::tools_utils::ABIDIFF_ERROR;
 	}
 
+      if (opts.show_mem_stats && (c1 || g1))
+	{
+	  abigail::ir::memory_stats_type stats1, stats2, env_stats;
+	  abigail::ir::get_memory_stats(c1 ? *c1 : *g1, stats1);
+	  abigail::ir::get_memory_stats(c2 ? *c2 : *g2, stats2);
+	  env->get_memory_stats(env_stats);
+	  emit_memory_stats(stats1, opts.file1, cerr);
+	  emit_memory_stats(stats2, opts.file2, cerr);
+	  emit_memory_stats(env_stats, "the shared environment", cerr);
+	}
+
       if (opts.no_arch)
 	{
 	  if (c1)
@@ -81,6 +81,8 @@ using abigail::dwarf_reader::read_context;
 using abigail::dwarf_reader::read_context_sptr;
 using abigail::dwarf_reader::read_corpus_from_elf;
 using abigail::dwarf_reader::create_read_context;
+using abigail::dwarf_reader::symbol_names_set_type;
+using abigail::dwarf_reader::symbol_names_set_sptr;
 using namespace abigail;
 
 struct options
@@ -110,6 +112,7 @@ struct options
   bool			linux_kernel_mode;
   bool			corpus_group_for_linux;
   bool			show_stats;
+  bool			show_mem_stats;
   bool			noout;
   bool			show_locs;
   bool			abidiff;
@@ -117,6 +120,8 @@ struct options
   bool			do_log;
   bool			drop_private_types;
   bool			drop_undefined_syms;
+  bool			tu_hashes;
+  size_t		num_threads;
   type_id_style_kind	type_id_style;
 
   options()
@@ -134,6 +139,7 @@ struct options
       linux_kernel_mode(true),
       corpus_group_for_linux(false),
       show_stats(),
+      show_mem_stats(),
       noout(),
       show_locs(true),
       abidiff(),
@@ -141,6 +147,8 @@ struct options
       do_log(),
       drop_private_types(false),
       drop_undefined_syms(false),
+      tu_hashes(false),
+      num_threads(1),
       type_id_style(SEQUENCE_TYPE_ID_STYLE)
   {}
 
@@ -198,7 +206,12 @@ display_usage(const string& prog_name, ostream& out)
        "the ABI of the union of vmlinux and its modules\n"
     << "  --abidiff  compare the loaded ABI against itself\n"
     << "  --annotate  annotate the ABI artifacts emitted in the output\n"
+    << "  --tu-hashes  emit the hash of the content of each translation "
+    "unit\n"
+    << "  --threads <number>  use <number> threads to read the debug info\n"
     << "  --stats  show statistics about various internal stuff\n"
+    << "  --mem-stats  show statistics about the memory used by the "
+    "internal representation\n"
     << "  --verbose show verbose messages about internal stuff\n";
   ;
 }
@@ -345,8 +358,24 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.abidiff = true;
       else if (!strcmp(argv[i], "--annotate"))
 	opts.annotate = true;
+      else if (!strcmp(argv[i], "--tu-hashes"))
+	opts.tu_hashes = true;
+      else if (!strcmp(argv[i], "--threads"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    return false;
+	  char *end = 0;
+	  unsigned long n = strtoul(argv[j], &end, 10);
+	  if (!*argv[j] || *end || n == 0)
+	    return false;
+	  opts.num_threads = n;
+	  ++i;
+	}
       else if (!strcmp(argv[i], "--stats"))
 	opts.show_stats = true;
+      else if (!strcmp(argv[i], "--mem-stats"))
+	opts.show_mem_stats = true;
       else if (!strcmp(argv[i], "--verbose"))
 	opts.do_log = true;
       else if (!strcmp(argv[i], "--help")
@@ -454,15 +483,26 @@ set_suppressions(read_context& read_ctxt, options& opts)
       supprs.push_back(suppr);
     }
 
-  using abigail::tools_utils::gen_suppr_spec_from_kernel_abi_whitelists;
+  using abigail::tools_utils::load_kernel_abi_whitelists;
+  using abigail::tools_utils::gen_suppr_spec_from_kernel_abi_whitelisted_names;
+  vector<string> whitelisted_names;
+  load_kernel_abi_whitelists(opts.kabi_whitelist_paths, whitelisted_names);
   const suppressions_type& wl_suppr =
-      gen_suppr_spec_from_kernel_abi_whitelists(opts.kabi_whitelist_paths);
+      gen_suppr_spec_from_kernel_abi_whitelisted_names(whitelisted_names);
 
   opts.kabi_whitelist_supprs.insert(opts.kabi_whitelist_supprs.end(),
 				    wl_suppr.begin(), wl_suppr.end());
 
   add_read_context_suppressions(read_ctxt, supprs);
   add_read_context_suppressions(read_ctxt, opts.kabi_whitelist_supprs);
+
+  if (!whitelisted_names.empty())
+    {
+      symbol_names_set_sptr kabi_whitelist
+	(new symbol_names_set_type(whitelisted_names.begin(),
+				   whitelisted_names.end()));
+      set_kernel_abi_whitelist(read_ctxt, kabi_whitelist);
+    }
 }
 
 /// Load an ABI @ref corpus (the internal representation of the ABI of
@@ -497,6 +537,15 @@ load_corpus_and_write_abixml(char* argv[],
     emit_prefix(argv[0], cerr)
       << "read corpus from elf file in: " << t << "\n";
 
+  if (opts.show_mem_stats && corp)
+    {
+      abigail::ir::memory_stats_type stats;
+      abigail::ir::get_memory_stats(*corp, stats);
+      env->get_memory_stats(stats);
+      dwarf_reader::get_memory_stats(ctxt, stats);
+      tools_utils::emit_memory_stats(stats, opts.in_file_path, cerr);
+    }
+
   t.start();
   context.reset();
   t.stop();
@@ -685,7 +734,8 @@ load_kernel_corpus_group_and_write_abixml(char* argv[],
 					      opts.vmlinux,
 					      opts.suppression_paths,
 					      opts.kabi_whitelist_paths,
-					      supprs, opts.do_log, env);
+					      supprs, opts.do_log, env,
+					      opts.num_threads);
   t.stop();
 
   if (opts.do_log)
@@ -698,6 +748,14 @@ load_kernel_corpus_group_and_write_abixml(char* argv[],
   if (!group)
     return 1;
 
+  if (opts.show_mem_stats)
+    {
+      abigail::ir::memory_stats_type stats;
+      abigail::ir::get_memory_stats(*group, stats);
+      env->get_memory_stats(stats);
+      tools_utils::emit_memory_stats(stats, opts.in_file_path, cerr);
+    }
+
   if (!opts.noout)
     {
       const xml_writer::write_context_sptr& ctxt
@@ -829,6 +887,9 @@ main(int argc, char* argv[])
       set_show_stats(ctxt, opts.show_stats);
       set_suppressions(ctxt, opts);
       abigail::dwarf_reader::set_do_log(ctxt, opts.do_log);
+      abigail::dwarf_reader::set_num_threads(ctxt, opts.num_threads);
+      abigail::dwarf_reader::set_compute_translation_unit_hashes
+	(ctxt, opts.tu_hashes);
       if (!opts.kabi_whitelist_supprs.empty())
 	set_ignore_symbol_table(ctxt, true);
 
@@ -83,6 +83,7 @@ struct options
   bool				read_tu;
   bool				diff;
   bool				noout;
+  size_t			num_threads;
   abg_compat::shared_ptr<char>	di_root_path;
   vector<string>		suppression_paths;
   string			headers_dir;
@@ -93,7 +94,8 @@ struct options
       read_from_stdin(false),
       read_tu(false),
       diff(false),
-      noout(false)
+      noout(false),
+      num_threads(1)
   {}
 };//end struct options;
 
@@ -114,6 +116,7 @@ display_usage(const string& prog_name, ostream& out)
     << "  --diff  for xml inputs, perform a text diff between "
     "the input and the memory model saved back to disk\n"
     << "  --noout  do not display anything on stdout\n"
+    << "  --threads <number>  use <number> threads to load the abi-file\n"
     << "  --stdin|--  read abi-file content from stdin\n"
     << "  --tu  expect a single translation unit file\n";
 }
@@ -193,6 +196,24 @@ parse_command_line(int argc, char* argv[], options& opts)
 	  opts.diff = true;
 	else if (!strcmp(argv[i], "--noout"))
 	  opts.noout = true;
+	else if (!strcmp(argv[i], "--threads"))
+	  {
+	    int j = i + 1;
+	    if (j >= argc)
+	      {
+		opts.wrong_option = argv[i];
+		return false;
+	      }
+	    char *end = 0;
+	    unsigned long n = strtoul(argv[j], &end, 10);
+	    if (!*argv[j] || *end || n == 0)
+	      {
+		opts.wrong_option = argv[i];
+		return false;
+	      }
+	    opts.num_threads = n;
+	    ++i;
+	  }
 	else
 	  {
 	    if (strlen(argv[i]) >= 2 && argv[i][0] == '-' && argv[i][1] == '-')
@@ -370,6 +391,7 @@ main(int argc, char* argv[])
 								  env.get());
 	    assert(ctxt);
 	    set_suppressions(*ctxt, opts);
+	    abigail::xml_reader::set_num_threads(*ctxt, opts.num_threads);
 	    corp = read_corpus_from_input(*ctxt);
 	    break;
 	  }
@@ -380,6 +402,7 @@ main(int argc, char* argv[])
 								  env.get());
 	    assert(ctxt);
 	    set_suppressions(*ctxt, opts);
+	    abigail::xml_reader::set_num_threads(*ctxt, opts.num_threads);
 	    group = read_corpus_group_from_input(*ctxt);
 	  }
 	  break;
@@ -120,6 +120,7 @@ using abigail::tools_utils::maybe_get_symlink_target_file_path;
 using abigail::tools_utils::file_exists;
 using abigail::tools_utils::is_dir;
 using abigail::tools_utils::emit_prefix;
+using abigail::tools_utils::emit_memory_stats;
 using abigail::tools_utils::check_file;
 using abigail::tools_utils::ensure_dir_path_created;
 using abigail::tools_utils::guess_file_type;
@@ -142,6 +143,7 @@ using abigail::tools_utils::build_corpus_group_from_kernel_dist_under;
 using abigail::tools_utils::load_default_system_suppressions;
 using abigail::tools_utils::load_default_user_suppressions;
 using abigail::tools_utils::abidiff_status;
+using abigail::tools_utils::timer;
 using abigail::ir::corpus_sptr;
 using abigail::ir::corpus_group_sptr;
 using abigail::comparison::diff_context;
@@ -158,6 +160,8 @@ using abigail::dwarf_reader::create_read_context;
 using abigail::dwarf_reader::get_soname_of_elf_file;
 using abigail::dwarf_reader::get_type_of_elf_file;
 using abigail::dwarf_reader::read_corpus_from_elf;
+using abigail::dwarf_reader::set_corpus_cache_dir;
+using abigail::dwarf_reader::get_corpus_cache_stats;
 
 /// The options passed to the current program.
 class options
@@ -203,10 +207,12 @@ public:
   bool		show_added_binaries;
   bool		fail_if_no_debug_info;
   bool		show_identical_binaries;
+  bool		show_mem_stats;
   vector<string> kabi_whitelist_packages;
   vector<string> suppression_paths;
   vector<string> kabi_whitelist_paths;
   suppressions_type kabi_suppressions;
+  string	cache_dir;
 
   options(const string& program_name)
     : prog_name(program_name),
@@ -237,7 +243,8 @@ public:
       show_symbols_not_referenced_by_debug_info(true),
       show_added_binaries(true),
       fail_if_no_debug_info(),
-      show_identical_binaries()
+      show_identical_binaries(),
+      show_mem_stats()
   {
     // set num_workers to the default number of threads of the
     // underlying maching.  This is the default value for the number
@@ -853,6 +860,10 @@ display_usage(const string& prog_name, ostream& out)
     << " --no-parallel                  do not execute in parallel\n"
     << " --fail-no-dbg                  fail if no debug info was found\n"
     << " --show-identical-binaries      show the names of identical binaries\n"
+    << " --cache-dir <path>             use <path> as the directory of the "
+    "cache of corpora read from ELF binaries\n"
+    << " --mem-stats                    show statistics about the memory "
+    "used by the internal representation\n"
     << " --verbose                      emit verbose progress messages\n"
     << " --help|-h                      display this help message\n"
     << " --version|-v                   display program version information"
@@ -1180,6 +1191,77 @@ set_diff_context_from_opts(diff_context_sptr ctxt,
   ctxt->add_suppressions(supprs);
 }
 
+/// Emit a verbose message saying if the corpus of a given ELF file
+/// was read from the corpus cache or not.
+///
+/// @param ctxt the DWARF reading context that was used to read the
+/// corpus.
+///
+/// @param path the path to the ELF file that was read.
+///
+/// @param opts the options of the current program.
+static void
+maybe_report_corpus_cache_use(const abigail::dwarf_reader::read_context& ctxt,
+			      const string& path,
+			      const options& opts)
+{
+  if (!opts.verbose)
+    return;
+
+  size_t hits = 0, misses = 0;
+  get_corpus_cache_stats(ctxt, hits, misses);
+  if (hits)
+    emit_prefix("abipkgdiff", cerr)
+      << "  Read file " << path << " from the corpus cache\n";
+  else if (misses)
+    emit_prefix("abipkgdiff", cerr)
+      << "  File " << path << " was not in the corpus cache\n";
+}
+
+/// Emit statistics about the memory used by the internal
+/// representation of a given ELF file, if the user asked for it.
+///
+/// As ELF files are compared concurrently, the statistics are first
+/// built into a string that is then emitted in one go.
+///
+/// @param ctxt the DWARF reading context that was used to read the
+/// corpus.
+///
+/// @param corp the corpus that was read.
+///
+/// @param path the path to the ELF file that was read.
+///
+/// @param opts the options of the current program.
+static void
+maybe_report_memory_stats(const abigail::dwarf_reader::read_context& ctxt,
+			  const corpus_sptr& corp,
+			  const string& path,
+			  const options& opts)
+{
+  if (!opts.show_mem_stats || !corp)
+    return;
+
+  abigail::ir::memory_stats_type stats;
+  abigail::ir::get_memory_stats(*corp, stats);
+  abigail::dwarf_reader::get_memory_stats(ctxt, stats);
+
+  ostringstream o;
+  emit_memory_stats(stats, path, o);
+  cerr << o.str();
+}
+
+/// The times spent in the phases of the comparison of two ELF
+/// files.
+struct compare_timings
+{
+  /// The time spent reading the corpus of the first ELF file.
+  timer read_corpus1;
+  /// The time spent reading the corpus of the second ELF file.
+  timer read_corpus2;
+  /// The time spent comparing the two corpora.
+  timer diff;
+}; // end struct compare_timings
+
 /// Compare the ABI two elf files, using their associated debug info.
 ///
 /// The result of the comparison is emitted to standard output.
@@ -1207,6 +1289,10 @@ set_diff_context_from_opts(diff_context_sptr ctxt,
 /// pointed-to parameter to the abigail::dwarf_reader::status value
 /// that gives details about the rror.
 ///
+/// @param timings if this pointer is non-null, the function sets the
+/// pointed-to parameter to the times spent in the phases of the
+/// comparison.
+///
 /// @return the status of the comparison.
 static abidiff_status
 compare(const elf_file& elf1,
@@ -1219,7 +1305,8 @@ compare(const elf_file& elf1,
 	abigail::ir::environment_sptr	&env,
 	corpus_diff_sptr	&diff,
 	diff_context_sptr	&ctxt,
-	abigail::dwarf_reader::status *detailed_error_status = 0)
+	abigail::dwarf_reader::status *detailed_error_status = 0,
+	compare_timings *timings = 0)
 {
   char *di_dir1 = (char*) debug_dir1.c_str(),
 	*di_dir2 = (char*) debug_dir2.c_str();
@@ -1285,7 +1372,14 @@ compare(const elf_file& elf1,
     if (!opts.kabi_suppressions.empty())
       add_read_context_suppressions(*c, opts.kabi_suppressions);
 
+    set_corpus_cache_dir(*c, opts.cache_dir);
+    if (timings)
+      timings->read_corpus1.start();
     corpus1 = read_corpus_from_elf(*c, c1_status);
+    if (timings)
+      timings->read_corpus1.stop();
+    maybe_report_corpus_cache_use(*c, elf1.path, opts);
+    maybe_report_memory_stats(*c, corpus1, elf1.path, opts);
 
     bool bail_out = false;
     if (!(c1_status & abigail::dwarf_reader::STATUS_OK))
@@ -1372,7 +1466,14 @@ compare(const elf_file& elf1,
     if (!opts.kabi_suppressions.empty())
       add_read_context_suppressions(*c, opts.kabi_suppressions);
 
+    set_corpus_cache_dir(*c, opts.cache_dir);
+    if (timings)
+      timings->read_corpus2.start();
     corpus2 = read_corpus_from_elf(*c, c2_status);
+    if (timings)
+      timings->read_corpus2.stop();
+    maybe_report_corpus_cache_use(*c, elf2.path, opts);
+    maybe_report_memory_stats(*c, corpus2, elf2.path, opts);
 
     bool bail_out = false;
     if (!(c2_status & abigail::dwarf_reader::STATUS_OK))
@@ -1447,7 +1548,11 @@ compare(const elf_file& elf1,
       << "    " << elf1.path << "\n"
       << "    " << elf2.path << "\n";
 
+  if (timings)
+    timings->diff.start();
   diff = compute_diff(corpus1, corpus2, ctxt);
+  if (timings)
+    timings->diff.stop();
 
   if (opts.verbose)
     emit_prefix("abipkgdiff", cerr)
@@ -1761,14 +1866,19 @@ public:
   abidiff_status status;
   ostringstream out;
   string pretty_output;
+  /// The estimated cost of the comparison.  See
+  /// estimate_comparison_cost.
+  uint64_t cost;
 
   compare_task()
-    : status(abigail::tools_utils::ABIDIFF_OK)
+    : status(abigail::tools_utils::ABIDIFF_OK),
+      cost()
   {}
 
   compare_task(const compare_args_sptr& a)
     : args(a),
-      status(abigail::tools_utils::ABIDIFF_OK)
+      status(abigail::tools_utils::ABIDIFF_OK),
+      cost()
   {}
 
   /// The job performed by the task.
@@ -1785,9 +1895,27 @@ public:
     abigail::dwarf_reader::status detailed_status =
       abigail::dwarf_reader::STATUS_UNKNOWN;
 
+    compare_timings timings;
     status |= compare(args->elf1, args->debug_dir1, args->private_types_suppr1,
 		      args->elf2, args->debug_dir2, args->private_types_suppr2,
-		      args->opts, env, diff, ctxt, &detailed_status);
+		      args->opts, env, diff, ctxt, &detailed_status,
+		      &timings);
+
+    if (args->opts.verbose)
+      {
+	// Emit the whole line at once, as other comparison tasks
+	// might be emitting their own messages concurrently.
+	ostringstream o;
+	emit_prefix("abipkgdiff", o)
+	  << args->elf1.path << ": estimated cost: " << cost << " bytes"
+	  << ", corpus 1 read in "
+	  << timings.read_corpus1.value_in_milliseconds() << "ms"
+	  << ", corpus 2 read in "
+	  << timings.read_corpus2.value_in_milliseconds() << "ms"
+	  << ", compared in "
+	  << timings.diff.value_in_milliseconds() << "ms\n";
+	cerr << o.str();
+      }
 
     // If there is an ABI change, tell the user about it.
     if ((status & abigail::tools_utils::ABIDIFF_ABI_CHANGE)
@@ -2224,11 +2352,10 @@ prepare_packages(package_sptr &first_package,
 /// task that compares two ELF files) against the added sizes of a
 /// second ELF pair.
 ///
-/// Larger filesize strongly raises the possibility of larger debug-info,
-/// hence longer diff time. For a package containing several relatively
-/// large and small ELFs, it is often more efficient to start working on
-/// the larger ones first. This function is used to order the pairs by
-/// size, starting from the largest.
+/// This function is used to order the reports of the comparisons of
+/// the ELF pairs by size, starting from the largest.  Note that the
+/// comparisons themselves are scheduled using
+/// comparison_cost_is_greater.
 ///
 /// @param t1 the first comparison task that compares a pair of ELF
 /// files.
@@ -2250,6 +2377,66 @@ elf_size_is_greater(const task_sptr &task1,
   return s1 > s2;
 }
 
+/// Estimate the cost of the comparison of two ELF files.
+///
+/// Most of the time of a comparison is spent building the corpora of
+/// the two ELF files, and that time mostly depends on the size of
+/// their debug info.  So the cost of a comparison is estimated as the
+/// added sizes of the debug info of the two ELF files.  The size of
+/// an ELF file that has no debug info is used in lieu of the size of
+/// its debug info.
+///
+/// @param args the arguments of the comparison to consider.
+///
+/// @return the estimated cost of the comparison.
+static uint64_t
+estimate_comparison_cost(const compare_args& args)
+{
+  uint64_t cost = 0, size = 0;
+
+  char *di_dir1 = const_cast<char*>(args.debug_dir1.c_str());
+  if (abigail::dwarf_reader::get_debug_info_size(args.elf1.path,
+						 &di_dir1, size)
+      == abigail::dwarf_reader::STATUS_OK)
+    cost += size;
+  else
+    cost += args.elf1.size;
+
+  char *di_dir2 = const_cast<char*>(args.debug_dir2.c_str());
+  if (abigail::dwarf_reader::get_debug_info_size(args.elf2.path,
+						 &di_dir2, size)
+      == abigail::dwarf_reader::STATUS_OK)
+    cost += size;
+  else
+    cost += args.elf2.size;
+
+  return cost;
+}
+
+/// Compare the estimated costs of two comparison tasks.
+///
+/// A single comparison task that is performed last can hold back the
+/// whole set of comparisons, while the other workers are idle.  So
+/// it's more efficient to start with the most expensive comparisons.
+/// This function is used to order the comparison tasks by estimated
+/// cost, starting from the most expensive.
+///
+/// @param task1 the first comparison task to consider.
+///
+/// @param task2 the second comparison task to consider.
+///
+/// @return true iff the estimated cost of @p task1 is greater than
+/// the estimated cost of @p task2.
+static bool
+comparison_cost_is_greater(const task_sptr &task1,
+			   const task_sptr &task2)
+{
+  compare_task_sptr t1 = dynamic_pointer_cast<compare_task>(task1);
+  compare_task_sptr t2 = dynamic_pointer_cast<compare_task>(task2);
+
+  return t1->cost > t2->cost;
+}
+
 /// This type is used to notify the calling thread that the comparison
 /// of two ELF files is done.
 class comparison_done_notify : public abigail::workers::queue::task_done_notify
@@ -2377,6 +2564,7 @@ compare_prepared_userspace_packages(package& first_package,
 				  create_private_types_suppressions
 				  (second_package, opts), opts));
 	      compare_task_sptr t(new compare_task(args));
+	      t->cost = estimate_comparison_cost(*args);
 	      compare_tasks.push_back(t);
 	    }
 	  second_package.path_elf_file_sptr_map().erase(iter);
@@ -2395,10 +2583,11 @@ compare_prepared_userspace_packages(package& first_package,
       return abigail::tools_utils::ABIDIFF_OK;
     }
 
-  // Larger elfs are processed first, since it's usually safe to assume
-  // their debug-info is larger as well, but the results are still
-  // in a map ordered by looked up in elf.name order.
-  std::sort(compare_tasks.begin(), compare_tasks.end(), elf_size_is_greater);
+  // The most expensive comparisons are performed first, so that the
+  // workers are kept busy until the end.  The reports are still
+  // emitted in the order given by elf_size_is_greater, below.
+  std::stable_sort(compare_tasks.begin(), compare_tasks.end(),
+		   comparison_cost_is_greater);
 
   // There's no reason to spawn more workers than there are ELF pairs
   // to be compared.
@@ -2824,12 +3013,26 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.fail_if_no_debug_info = true;
       else if (!strcmp(argv[i], "--verbose"))
 	opts.verbose = true;
+      else if (!strcmp(argv[i], "--mem-stats"))
+	opts.show_mem_stats = true;
       else if (!strcmp(argv[i], "--no-abignore"))
 	opts.abignore = false;
       else if (!strcmp(argv[i], "--no-parallel"))
 	opts.parallel = false;
       else if (!strcmp(argv[i], "--show-identical-binaries"))
 	opts.show_identical_binaries = true;
+      else if (!strcmp(argv[i], "--cache-dir"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  opts.cache_dir = argv[j];
+	  ++i;
+	}
       else if (!strcmp(argv[i], "--suppressions")
 	       || !strcmp(argv[i], "--suppr"))
 	{
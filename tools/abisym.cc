@@ -22,7 +22,7 @@
 
 /// @file
 ///
-/// This program takes parameters to open an elf file, lookup a symbol
+/// This program takes parameters to open an elf file, lookup symbols
 /// in its symbol tables and report what it sees.
 
 #include <elf.h>
@@ -44,15 +44,17 @@ using std::vector;
 using abigail::ir::environment;
 using abigail::ir::environment_sptr;
 using abigail::dwarf_reader::lookup_symbol_from_elf;
+using abigail::dwarf_reader::lookup_symbols_from_elf;
 using abigail::elf_symbol;
 using abigail::elf_symbol_sptr;
+using abigail::string_elf_symbols_map_type;
 
 struct options
 {
   bool	show_help;
   bool	display_version;
   char* elf_path;
-  char* symbol_name;
+  vector<char*> symbol_names;
   bool	demangle;
   bool absolute_path;
 
@@ -60,7 +62,6 @@ struct options
     : show_help(false),
       display_version(false),
       elf_path(0),
-      symbol_name(0),
       demangle(false),
       absolute_path(true)
   {}
@@ -69,7 +70,8 @@ struct options
 static void
 display_usage(const string& prog_name, ostream &out)
 {
-  out << "usage: " << prog_name << " [options] <elf file> <symbol-name>\n"
+  out << "usage: " << prog_name
+      << " [options] <elf file> <symbol-name>...\n"
       << "where [options] can be:\n"
       << "  --help  display this help string\n"
       << "  --version|-v  display program version information and exit\n"
@@ -92,13 +94,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	{
 	  if (!opts.elf_path)
 	    opts.elf_path = argv[i];
-	  else if (!opts.symbol_name)
-	    opts.symbol_name = argv[i] ;
 	  else
-	    {
-	      opts.show_help = true;
-	      return;
-	    }
+	    opts.symbol_names.push_back(argv[i]);
 	}
       else if (!strcmp(argv[i], "--help")
 	       || !strcmp(argv[i], "-h"))
@@ -121,41 +118,28 @@ parse_command_line(int argc, char* argv[], options& opts)
     }
 }
 
-int
-main(int argc, char* argv[])
+/// Report about the symbols found for a given name.
+///
+/// @param opts the options of the program.
+///
+/// @param n the name of the symbols that were looked up.
+///
+/// @param syms the symbols that were found with the name @p n.
+static void
+report_symbols(const options&			opts,
+	       const string&			n,
+	       const vector<elf_symbol_sptr>&	syms)
 {
-  options opts;
-  parse_command_line(argc, argv, opts);
-
-  if (opts.show_help)
-    {
-      display_usage(argv[0], cout);
-      return 1;
-    }
-
-  if (opts.display_version)
-    {
-      abigail::tools_utils::emit_prefix(argv[0], cout)
-	<< abigail::tools_utils::get_library_version_string();
-      return 0;
-    }
-
-  assert(opts.elf_path != 0
-	 && opts.symbol_name != 0);
-
-  string p = opts.elf_path, n = opts.symbol_name;
-  environment_sptr env(new environment);
-  vector<elf_symbol_sptr> syms;
-  if (!lookup_symbol_from_elf(env.get(), p, n, opts.demangle, syms))
+  if (syms.empty())
     {
       cout << "could not find symbol '"
-	   << opts.symbol_name
+	   << n
 	   << "' in file '";
       if (opts.absolute_path)
 	cout << opts.elf_path << "'\n";
       else
-	cout << basename(opts.elf_path);
-      return 0;
+	cout << basename(opts.elf_path) << "'\n";
+      return;
     }
 
   elf_symbol_sptr sym = syms[0];
@@ -181,6 +165,55 @@ main(int argc, char* argv[])
 	}
     }
   cout << '\n';
+}
+
+int
+main(int argc, char* argv[])
+{
+  options opts;
+  parse_command_line(argc, argv, opts);
+
+  if (opts.show_help)
+    {
+      display_usage(argv[0], cout);
+      return 1;
+    }
+
+  if (opts.display_version)
+    {
+      abigail::tools_utils::emit_prefix(argv[0], cout)
+	<< abigail::tools_utils::get_library_version_string();
+      return 0;
+    }
+
+  assert(opts.elf_path != 0
+	 && !opts.symbol_names.empty());
+
+  string p = opts.elf_path;
+  environment_sptr env(new environment);
+
+  if (opts.symbol_names.size() == 1)
+    {
+      string n = opts.symbol_names[0];
+      vector<elf_symbol_sptr> syms;
+      lookup_symbol_from_elf(env.get(), p, n, opts.demangle, syms);
+      report_symbols(opts, n, syms);
+      return 0;
+    }
+
+  // Several symbols are looked up.  Index the symbol table once for
+  // all of them.
+  vector<string> names(opts.symbol_names.begin(), opts.symbol_names.end());
+  string_elf_symbols_map_type syms_map;
+  lookup_symbols_from_elf(env.get(), p, names, opts.demangle, syms_map);
+  for (vector<string>::const_iterator n = names.begin();
+       n != names.end();
+       ++n)
+    {
+      string_elf_symbols_map_type::const_iterator i = syms_map.find(*n);
+      report_symbols(opts, *n,
+		     i == syms_map.end() ? vector<elf_symbol_sptr>() : i->second);
+    }
 
   return 0;
 }
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <fts.h>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -86,6 +87,7 @@ struct options
   suppressions_type	diff_time_supprs;
   shared_ptr<char>	di_root_path1;
   shared_ptr<char>	di_root_path2;
+  size_t		num_threads;
 
   options()
     : display_usage(),
@@ -95,7 +97,8 @@ struct options
       leaf_changes_only(true),
       show_hexadecimal_values(true),
       show_offsets_sizes_in_bits(false),
-      show_impacted_interfaces(false)
+      show_impacted_interfaces(false),
+      num_threads(1)
   {}
 }; // end struct options.
 
@@ -128,7 +131,9 @@ display_usage(const string& prog_name, ostream& out)
     << " --show-bytes  show size and offsets in bytes\n"
     << " --show-bits  show size and offsets in bits\n"
     << " --show-hex  show size and offset in hexadecimal\n"
-    << " --show-dec  show size and offset in decimal\n";
+    << " --show-dec  show size and offset in decimal\n"
+    << " --threads <number>  use <number> threads to load the kernel "
+    "modules\n";
 }
 
 /// Parse the command line of the program.
@@ -271,6 +276,25 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.show_hexadecimal_values = true;
       else if (!strcmp(argv[i], "--show-dec"))
 	opts.show_hexadecimal_values = false;
+      else if (!strcmp(argv[i], "--threads"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return false;
+	    }
+	  char *end = 0;
+	  unsigned long n = strtoul(argv[j], &end, 10);
+	  if (!*argv[j] || *end || n == 0)
+	    {
+	      opts.wrong_option = argv[i];
+	      return false;
+	    }
+	  opts.num_threads = n;
+	  ++i;
+	}
       else
 	{
 	  opts.wrong_option = argv[i];
@@ -428,7 +452,8 @@ main(int argc, char* argv[])
 						      opts.kabi_whitelist_paths,
 						      opts.read_time_supprs,
 						      opts.verbose,
-						      env);
+						      env,
+						      opts.num_threads);
 	  print_kernel_dist_binary_paths_under(opts.kernel_dist_root1, opts);
 	}
       else if (ftype == FILE_TYPE_XML_CORPUS_GROUP)
@@ -454,7 +479,8 @@ main(int argc, char* argv[])
 						      opts.kabi_whitelist_paths,
 						      opts.read_time_supprs,
 						      opts.verbose,
-						      env);
+						      env,
+						      opts.num_threads);
 	  print_kernel_dist_binary_paths_under(opts.kernel_dist_root2, opts);
 	}
       else if (ftype == FILE_TYPE_XML_CORPUS_GROUP)